@@ -438,7 +438,9 @@ int App::processConverter(const CommandLineParser::ConverterTask& task)
 
     switch (task.type) {
     case CommandLineParser::ConvertType::Batch:
-        ret = converter()->batchConvert(task.inputFile, stylePath, forceMode);
+        ret = converter()->batchConvert(task.inputFile, stylePath, forceMode,
+                                        task.params.value(CommandLineParser::ParamKey::JobWorkersCount, 1).toInt(),
+                                        task.params[CommandLineParser::ParamKey::JobReportPath].toString());
         break;
     case CommandLineParser::ConvertType::ConvertScoreParts:
         ret = converter()->convertScoreParts(task.inputFile, task.outputFile, stylePath);
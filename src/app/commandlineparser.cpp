@@ -74,6 +74,10 @@ void CommandLineParser::init()
     // Converter mode
     m_parser.addOption(QCommandLineOption({ "r", "image-resolution" }, "Set output resolution for image export", "DPI"));
     m_parser.addOption(QCommandLineOption({ "j", "job" }, "Process a conversion job", "file"));
+    m_parser.addOption(QCommandLineOption("job-workers", "Use with '-j <file>', process the job in the given number of worker processes",
+                                          "count"));
+    m_parser.addOption(QCommandLineOption("job-report", "Use with '-j <file>', write a JSON Lines report with the result, "
+                                                        "time and peak memory of each conversion", "file"));
     m_parser.addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension", "file"));
     m_parser.addOption(QCommandLineOption({ "F", "factory-settings" }, "Use factory settings"));
     m_parser.addOption(QCommandLineOption({ "R", "revert-settings" }, "Revert to factory settings, but keep default preferences"));
@@ -281,6 +285,19 @@ void CommandLineParser::parse(int argc, char** argv)
         m_runMode = IApplication::RunMode::ConsoleApp;
         m_converterTask.type = ConvertType::Batch;
         m_converterTask.inputFile = fromUserInputPath(m_parser.value("j"));
+
+        if (m_parser.isSet("job-workers")) {
+            std::optional<int> val = intValue("job-workers");
+            if (val) {
+                m_converterTask.params[CommandLineParser::ParamKey::JobWorkersCount] = val.value();
+            } else {
+                LOGE() << "Option: --job-workers not recognized count value: " << m_parser.value("job-workers");
+            }
+        }
+
+        if (m_parser.isSet("job-report")) {
+            m_converterTask.params[CommandLineParser::ParamKey::JobReportPath] = fromUserInputPath(m_parser.value("job-report"));
+        }
     }
 
     if (m_parser.isSet("score-media")) {
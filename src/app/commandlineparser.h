@@ -110,6 +110,8 @@ public:
         ScoreSource,
         ScoreTransposeOptions,
         ForceMode,
+        JobWorkersCount,
+        JobReportPath,
 
         // Video
     };
@@ -30,6 +30,7 @@
 #include <QJsonValue>
 #include <QRandomGenerator>
 
+#include "concurrency/taskscheduler.h"
 #include "io/buffer.h"
 
 #include "engraving/compat/scoreaccess.h"
@@ -86,13 +87,34 @@ Ret BackendApi::exportScoreMedia(const io::path_t& in, const io::path_t& out, co
 
     BackendJsonWriter jsonWriter(&outputFile);
 
-    result &= exportScorePngs(notation, jsonWriter, ADD_SEPARATOR);
-    result &= exportScoreSvgs(notation, highlightConfigPath, jsonWriter, ADD_SEPARATOR);
+    //! NOTE The pages are painted once, the png and pdf writers replay them in parallel.
+    //! Meanwhile the svgs are written here, the svg writer needs the score itself
+    notation->painting()->setPrintCacheEnabled(true);
+
+    PagesData pngs;
+    RetVal<QByteArray> pdf;
+    PagesData svgs;
+    {
+        TaskGroup printTasks;
+        renderScorePngs(notation, printTasks, pngs);
+        printTasks.run([notation, &pdf]() {
+            pdf = writeToBuffer(PDF_WRITER_NAME, notation);
+        });
+
+        result &= renderScoreSvgs(notation, highlightConfigPath, svgs);
+
+        printTasks.wait();
+    }
+
+    notation->painting()->setPrintCacheEnabled(false);
+
+    result &= exportPages("pngs", pngs, jsonWriter, ADD_SEPARATOR);
+    result &= exportPages("svgs", svgs, jsonWriter, ADD_SEPARATOR);
     result &= exportScoreElementsPositions(SEGMENTS_POSITIONS_WRITER_NAME, SEGMENTS_POSITIONS_TAG_NAME,
                                            notation, jsonWriter, ADD_SEPARATOR);
     result &= exportScoreElementsPositions(MEASURES_POSITIONS_WRITER_NAME, MEASURES_POSITIONS_TAG_NAME,
                                            notation, jsonWriter, ADD_SEPARATOR);
-    result &= exportScorePdf(notation, jsonWriter, ADD_SEPARATOR);
+    result &= exportScorePdf(pdf, jsonWriter, ADD_SEPARATOR);
     result &= exportScoreMidi(notation, jsonWriter, ADD_SEPARATOR);
     result &= exportScoreMusicXML(notation, jsonWriter, ADD_SEPARATOR);
     result &= exportScoreMetaData(notation, jsonWriter, ADD_SEPARATOR);
@@ -281,84 +303,60 @@ QVariantMap BackendApi::readBeatsColors(const io::path_t& filePath)
     return result;
 }
 
-Ret BackendApi::exportScorePngs(const INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator)
+void BackendApi::renderScorePngs(const INotationPtr notation, TaskGroup& tasks, PagesData& pngs)
 {
     TRACEFUNC
 
-    auto pngWriter = writers()->writer(PNG_WRITER_NAME);
-    if (!pngWriter) {
-        LOGW() << "Not found writer " << PNG_WRITER_NAME;
-        return make_ret(Ret::Code::InternalError);
+    pngs.resize(pages(notation).size());
+
+    for (size_t i = 0; i < pngs.size(); ++i) {
+        tasks.run([notation, i, &pngs]() {
+            INotationWriter::Options options {
+                { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
+                { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) }
+            };
+
+            pngs[i] = writeToBuffer(PNG_WRITER_NAME, notation, options);
+        });
     }
+}
 
-    jsonWriter.addKey("pngs");
-    jsonWriter.openArray();
+Ret BackendApi::renderScoreSvgs(const INotationPtr notation, const io::path_t& highlightConfigPath, PagesData& svgs)
+{
+    TRACEFUNC
 
-    PageList notationPages = pages(notation);
+    QVariantMap beatsColors = readBeatsColors(highlightConfigPath);
 
-    bool result = true;
-    for (size_t i = 0; i < notationPages.size(); ++i) {
-        QByteArray pngData;
-        QBuffer pngDevice(&pngData);
-        pngDevice.open(QIODevice::ReadWrite);
+    svgs.resize(pages(notation).size());
 
+    bool result = true;
+    for (size_t i = 0; i < svgs.size(); ++i) {
         INotationWriter::Options options {
             { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
-            { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) }
+            { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) },
+            { INotationWriter::OptionKey::BEATS_COLORS, Val::fromQVariant(beatsColors) }
         };
 
-        Ret writeRet = pngWriter->write(notation, pngDevice, options);
-        if (!writeRet) {
-            LOGW() << writeRet.toString();
-            result = false;
-        }
-
-        bool lastArrayValue = ((notationPages.size() - 1) == i);
-        jsonWriter.addValue(pngData.toBase64(), !lastArrayValue);
+        svgs[i] = writeToBuffer(SVG_WRITER_NAME, notation, options);
+        result &= svgs[i].ret.success();
     }
 
-    jsonWriter.closeArray(addSeparator);
-
     return result ? make_ret(Ret::Code::Ok) : make_ret(Ret::Code::InternalError);
 }
 
-Ret BackendApi::exportScoreSvgs(const INotationPtr notation, const io::path_t& highlightConfigPath, BackendJsonWriter& jsonWriter,
-                                bool addSeparator)
+Ret BackendApi::exportPages(const char* key, const PagesData& pagesData, BackendJsonWriter& jsonWriter, bool addSeparator)
 {
     TRACEFUNC
 
-    auto svgWriter = writers()->writer(SVG_WRITER_NAME);
-    if (!svgWriter) {
-        LOGW() << "Not found writer " << SVG_WRITER_NAME;
-        return make_ret(Ret::Code::InternalError);
-    }
-
-    jsonWriter.addKey("svgs");
+    jsonWriter.addKey(key);
     jsonWriter.openArray();
 
-    PageList notationPages = pages(notation);
-    QVariantMap beatsColors = readBeatsColors(highlightConfigPath);
-
     bool result = true;
-    for (size_t i = 0; i < notationPages.size(); ++i) {
-        QByteArray svgData;
-        QBuffer svgDevice(&svgData);
-        svgDevice.open(QIODevice::ReadWrite);
+    for (size_t i = 0; i < pagesData.size(); ++i) {
+        result &= pagesData[i].ret.success();
 
-        INotationWriter::Options options {
-            { INotationWriter::OptionKey::PAGE_NUMBER, Val(static_cast<int>(i)) },
-            { INotationWriter::OptionKey::TRANSPARENT_BACKGROUND, Val(false) },
-            { INotationWriter::OptionKey::BEATS_COLORS, Val::fromQVariant(beatsColors) }
-        };
-
-        Ret writeRet = svgWriter->write(notation, svgDevice, options);
-        if (!writeRet) {
-            LOGW() << writeRet.toString();
-            result = false;
-        }
-
-        bool lastArrayValue = ((notationPages.size() - 1) == i);
-        jsonWriter.addValue(svgData.toBase64(), !lastArrayValue);
+        bool lastArrayValue = ((pagesData.size() - 1) == i);
+        jsonWriter.addBase64Value(pagesData[i].val, !lastArrayValue);
     }
 
     jsonWriter.closeArray(addSeparator);
@@ -397,6 +395,20 @@ Ret BackendApi::exportScorePdf(const INotationPtr notation, BackendJsonWriter& j
     return make_ret(Ret::Code::Ok);
 }
 
+Ret BackendApi::exportScorePdf(const RetVal<QByteArray>& pdfData, BackendJsonWriter& jsonWriter, bool addSeparator)
+{
+    TRACEFUNC
+
+    if (!pdfData.ret) {
+        return pdfData.ret;
+    }
+
+    jsonWriter.addKey(PDF_WRITER_NAME.c_str());
+    jsonWriter.addBase64Value(pdfData.val, addSeparator);
+
+    return make_ret(Ret::Code::Ok);
+}
+
 Ret BackendApi::exportScorePdf(const INotationPtr notation, QIODevice& destinationDevice)
 {
     TRACEFUNC
@@ -474,7 +486,8 @@ Ret BackendApi::devInfo(const notation::INotationPtr notation, BackendJsonWriter
     return make_ret(Ret::Code::Ok);
 }
 
-mu::RetVal<QByteArray> BackendApi::processWriter(const std::string& writerName, const INotationPtr notation)
+mu::RetVal<QByteArray> BackendApi::writeToBuffer(const std::string& writerName, const INotationPtr notation,
+                                                 const INotationWriter::Options& options)
 {
     auto writer = writers()->writer(writerName);
     if (!writer) {
@@ -486,18 +499,24 @@ mu::RetVal<QByteArray> BackendApi::processWriter(const std::string& writerName,
     QBuffer device(&data);
     device.open(QIODevice::ReadWrite);
 
-    Ret writeRet = writer->write(notation, device);
+    Ret writeRet = writer->write(notation, device, options);
     if (!writeRet) {
         LOGW() << writeRet.toString();
         return writeRet;
     }
 
-    RetVal<QByteArray> result;
-    result.ret = make_ret(Ret::Code::Ok);
-    result.val = data.toBase64();
-
     device.close();
 
+    return RetVal<QByteArray>::make_ok(data);
+}
+
+mu::RetVal<QByteArray> BackendApi::processWriter(const std::string& writerName, const INotationPtr notation)
+{
+    RetVal<QByteArray> result = writeToBuffer(writerName, notation);
+    if (result.ret) {
+        result.val = result.val.toBase64();
+    }
+
     return result;
 }
 
@@ -22,6 +22,8 @@
 #ifndef MU_CONVERTER_BACKENDAPI_H
 #define MU_CONVERTER_BACKENDAPI_H
 
+#include <vector>
+
 #include "types/retval.h"
 
 #include "io/path.h"
@@ -31,6 +33,10 @@
 #include "project/iprojectcreator.h"
 #include "project/inotationwritersregister.h"
 
+namespace mu {
+class TaskGroup;
+}
+
 namespace mu::engraving {
 class Score;
 }
@@ -64,19 +70,24 @@ private:
 
     static QVariantMap readBeatsColors(const io::path_t& filePath);
 
-    static Ret exportScorePngs(const notation::INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator = false);
-    static Ret exportScoreSvgs(const notation::INotationPtr notation, const io::path_t& highlightConfigPath, BackendJsonWriter& jsonWriter,
-                               bool addSeparator = false);
+    using PagesData = std::vector<RetVal<QByteArray> >;
+
+    static void renderScorePngs(const notation::INotationPtr notation, TaskGroup& tasks, PagesData& pngs);
+    static Ret renderScoreSvgs(const notation::INotationPtr notation, const io::path_t& highlightConfigPath, PagesData& svgs);
+    static Ret exportPages(const char* key, const PagesData& pagesData, BackendJsonWriter& jsonWriter, bool addSeparator = false);
     static Ret exportScoreElementsPositions(const std::string& elementsPositionsWriterName, const std::string& elementsPositionsTagName,
                                             const notation::INotationPtr notation, BackendJsonWriter& jsonWriter,
                                             bool addSeparator = false);
     static Ret exportScorePdf(const notation::INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator = false);
+    static Ret exportScorePdf(const RetVal<QByteArray>& pdfData, BackendJsonWriter& jsonWriter, bool addSeparator = false);
     static Ret exportScorePdf(const notation::INotationPtr notation, QIODevice& destinationDevice);
     static Ret exportScoreMidi(const notation::INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator = false);
     static Ret exportScoreMusicXML(const notation::INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator = false);
     static Ret exportScoreMetaData(const notation::INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator = false);
     static Ret devInfo(const notation::INotationPtr notation, BackendJsonWriter& jsonWriter, bool addSeparator = false);
 
+    static mu::RetVal<QByteArray> writeToBuffer(const std::string& writerName, const notation::INotationPtr notation,
+                                                const project::INotationWriter::Options& options = {});
     static mu::RetVal<QByteArray> processWriter(const std::string& writerName, const notation::INotationPtr notation);
     static mu::RetVal<QByteArray> processWriter(const std::string& writerName, const notation::INotationPtrList notations,
                                                 const project::INotationWriter::Options& options);
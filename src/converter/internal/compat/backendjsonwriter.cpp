@@ -21,6 +21,8 @@
  */
 #include "backendjsonwriter.h"
 
+#include <algorithm>
+
 using namespace mu::converter;
 using namespace mu::io;
 
@@ -58,6 +60,23 @@ void BackendJsonWriter::addValue(const QByteArray& data, bool addSeparator, bool
     }
 }
 
+//! NOTE Encodes the data chunk by chunk straight to the device, without a base64 copy of the whole data
+void BackendJsonWriter::addBase64Value(const QByteArray& data, bool addSeparator)
+{
+    //! NOTE Multiple of 3, so that there is no padding inside the value
+    constexpr qsizetype CHUNK_SIZE = 3 * 16 * 1024;
+
+    m_destinationDevice->write("\"");
+    for (qsizetype pos = 0; pos < data.size(); pos += CHUNK_SIZE) {
+        QByteArray chunk = QByteArray::fromRawData(data.constData() + pos, std::min(CHUNK_SIZE, data.size() - pos));
+        m_destinationDevice->write(chunk.toBase64());
+    }
+    m_destinationDevice->write("\"");
+    if (addSeparator) {
+        m_destinationDevice->write(",\n");
+    }
+}
+
 void BackendJsonWriter::openArray()
 {
     m_destinationDevice->write(" [");
@@ -21,11 +21,25 @@
  */
 #include "convertercontroller.h"
 
+#include <set>
+#include <thread>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonParseError>
+#include <QProcess>
+#include <QTemporaryDir>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_MACOS)
+#include <sys/resource.h>
+#endif
 
 #include "io/dir.h"
 #include "stringutils.h"
@@ -42,7 +56,92 @@ using namespace mu::notation;
 static const std::string PDF_SUFFIX = "pdf";
 static const std::string PNG_SUFFIX = "png";
 
-mu::Ret ConverterController::batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath, bool forceMode)
+static void resetPeakMemoryUsage()
+{
+#if defined(Q_OS_LINUX)
+    //! NOTE Resets VmHWM, so that the peak is measured per job
+    QFile file("/proc/self/clear_refs");
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write("5");
+    }
+#endif
+}
+
+//! NOTE Where the peak can't be reset, it's the peak of the process up to now
+static uint64_t peakMemoryUsageKb()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize / 1024;
+    }
+#elif defined(Q_OS_MACOS)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return usage.ru_maxrss / 1024; // in bytes on macOS
+    }
+#elif defined(Q_OS_LINUX)
+    QFile file("/proc/self/status");
+    if (file.open(QIODevice::ReadOnly)) {
+        for (const QByteArray& line : file.readAll().split('\n')) {
+            if (line.startsWith("VmHWM:")) {
+                return line.mid(6).trimmed().split(' ').first().toULongLong();
+            }
+        }
+    }
+#endif
+    return 0;
+}
+
+static QJsonObject makeJobReport(const QString& in, const QString& out, const mu::Ret& ret, qint64 timeMs, uint64_t peakMemoryKb)
+{
+    QJsonObject obj;
+    obj["in"] = in;
+    obj["out"] = out;
+    obj["success"] = ret.success();
+    if (!ret) {
+        obj["error"] = QString::fromStdString(ret.toString());
+    }
+    obj["timeMs"] = timeMs;
+    obj["peakMemoryKb"] = static_cast<qint64>(peakMemoryKb);
+
+    return obj;
+}
+
+//! NOTE The report is written in the JSON Lines format, a line per job as soon as the job is done,
+//! so that it stays readable if the process crashes
+static void writeJobReport(QFile& reportFile, const QJsonObject& jobReport)
+{
+    if (!reportFile.isOpen()) {
+        return;
+    }
+
+    reportFile.write(QJsonDocument(jobReport).toJson(QJsonDocument::Compact));
+    reportFile.write("\n");
+    reportFile.flush();
+}
+
+static std::vector<QJsonObject> readJobReports(const QString& reportPath)
+{
+    std::vector<QJsonObject> reports;
+
+    QFile file(reportPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return reports;
+    }
+
+    for (const QByteArray& line : file.readAll().split('\n')) {
+        QJsonDocument doc = QJsonDocument::fromJson(line);
+        if (doc.isObject()) {
+            reports.push_back(doc.object());
+        }
+    }
+
+    return reports;
+}
+
+mu::Ret ConverterController::batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath, bool forceMode,
+                                          int workersCount, const io::path_t& reportPath)
 {
     TRACEFUNC;
 
@@ -52,16 +151,155 @@ mu::Ret ConverterController::batchConvert(const io::path_t& batchJobFile, const
         return batchJob.ret;
     }
 
-    Ret ret = make_ret(Ret::Code::Ok);
+    if (workersCount > 1 && batchJob.val.size() > 1) {
+        return batchConvertInWorkers(batchJob.val, workersCount, reportPath);
+    }
+
+    QFile reportFile(reportPath.toQString());
+    if (!reportPath.empty() && !reportFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        LOGE() << "failed open report file: " << reportPath;
+    }
+
+    //! NOTE A failed job doesn't stop the others, fonts, styles and other caches stay warm for the next jobs
+    size_t failedCount = 0;
     for (const Job& job : batchJob.val) {
-        ret = fileConvert(job.in, job.out, stylePath, forceMode);
+        resetPeakMemoryUsage();
+        QElapsedTimer timer;
+        timer.start();
+
+        Ret ret = convertJob(job, stylePath, forceMode);
+        if (!ret) {
+            LOGE() << "failed convert, err: " << ret.toString() << ", in: " << job.in << ", out: " << jobOutString(job);
+            ++failedCount;
+        }
+
+        writeJobReport(reportFile, makeJobReport(job.in.toQString(), jobOutString(job), ret, timer.elapsed(), peakMemoryUsageKb()));
+    }
+
+    if (failedCount > 0) {
+        LOGE() << "failed jobs: " << failedCount << " of " << batchJob.val.size();
+        return make_ret(Err::BatchJobFailed);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::Ret ConverterController::batchConvertInWorkers(const BatchJob& batchJob, int workersCount, const io::path_t& reportPath) const
+{
+    TRACEFUNC;
+
+    QTemporaryDir workDir;
+    if (!workDir.isValid()) {
+        LOGE() << "failed create temporary dir: " << workDir.errorString();
+        return make_ret(Err::UnknownError);
+    }
+
+    //! NOTE Jobs are dealt out in turn, so that big and small scores, which are usually grouped, are spread over the workers
+    std::vector<BatchJob> workersJobs(std::min(static_cast<size_t>(workersCount), batchJob.size()));
+    for (size_t i = 0; i < batchJob.size(); ++i) {
+        workersJobs[i % workersJobs.size()].push_back(batchJob[i]);
+    }
+
+    std::vector<std::vector<QJsonObject> > workersReports(workersJobs.size());
+    std::vector<std::thread> threads;
+    threads.reserve(workersJobs.size());
+
+    for (size_t i = 0; i < workersJobs.size(); ++i) {
+        io::path_t workerDir = workDir.filePath(QString::number(i));
+        threads.emplace_back([this, &jobs = workersJobs[i], &reports = workersReports[i], workerDir]() {
+            reports = runBatchJobWorker(jobs, workerDir);
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    QFile reportFile(reportPath.toQString());
+    if (!reportPath.empty() && !reportFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        LOGE() << "failed open report file: " << reportPath;
+    }
+
+    size_t failedCount = 0;
+    for (size_t i = 0; i < workersReports.size(); ++i) {
+        for (QJsonObject& jobReport : workersReports[i]) {
+            if (!jobReport["success"].toBool()) {
+                ++failedCount;
+            }
+
+            jobReport["worker"] = static_cast<int>(i);
+            writeJobReport(reportFile, jobReport);
+        }
+    }
+
+    if (failedCount > 0) {
+        LOGE() << "failed jobs: " << failedCount << " of " << batchJob.size();
+        return make_ret(Err::BatchJobFailed);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
+std::vector<QJsonObject> ConverterController::runBatchJobWorker(const BatchJob& batchJob, const io::path_t& workDir) const
+{
+    std::vector<QJsonObject> reports;
+
+    //! NOTE The worker is this application, started with the same options, but with its own part of the job
+    QStringList baseArgs;
+    QStringList appArgs = QCoreApplication::arguments();
+    for (int i = 1; i < appArgs.size(); ++i) {
+        const QString& arg = appArgs.at(i);
+        if (arg == "-j" || arg == "--job" || arg == "--job-workers" || arg == "--job-report") {
+            ++i; // skip value
+            continue;
+        }
+
+        if (arg.startsWith("--job=") || arg.startsWith("--job-workers=") || arg.startsWith("--job-report=")) {
+            continue;
+        }
+
+        baseArgs << arg;
+    }
+
+    io::Dir::mkpath(workDir);
+    const QString jobFile = workDir.toQString() + "/job.json";
+    const QString reportFile = workDir.toQString() + "/report.jsonl";
+
+    //! NOTE If the worker crashes, the job it was busy with is reported as failed,
+    //! and a new worker continues with the rest
+    size_t doneCount = 0;
+    while (doneCount < batchJob.size()) {
+        BatchJob restJob(batchJob.begin() + doneCount, batchJob.end());
+        Ret ret = writeBatchJob(restJob, jobFile);
         if (!ret) {
-            LOGE() << "failed convert, err: " << ret.toString() << ", in: " << job.in << ", out: " << job.out;
+            for (const Job& job : restJob) {
+                reports.push_back(makeJobReport(job.in.toQString(), jobOutString(job), ret, 0, 0));
+            }
             break;
         }
+
+        QFile::remove(reportFile);
+
+        QProcess process;
+        process.setProcessChannelMode(QProcess::ForwardedChannels);
+        process.start(QCoreApplication::applicationFilePath(), QStringList(baseArgs) << "-j" << jobFile << "--job-report" << reportFile);
+        process.waitForFinished(-1);
+
+        std::vector<QJsonObject> workerReports = readJobReports(reportFile);
+        workerReports.resize(std::min(workerReports.size(), restJob.size()));
+        doneCount += workerReports.size();
+        reports.insert(reports.end(), workerReports.begin(), workerReports.end());
+
+        if (doneCount < batchJob.size() && workerReports.size() < restJob.size()) {
+            const Job& job = batchJob.at(doneCount);
+            LOGE() << "worker process crashed, in: " << job.in << ", out: " << jobOutString(job);
+            reports.push_back(makeJobReport(job.in.toQString(), jobOutString(job),
+                                            make_ret(Err::BatchJobWorkerCrashed), 0, 0));
+            ++doneCount;
+        }
     }
 
-    return ret;
+    return reports;
 }
 
 mu::Ret ConverterController::fileConvert(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath, bool forceMode)
@@ -96,9 +334,89 @@ mu::Ret ConverterController::fileConvert(const io::path_t& in, const io::path_t&
 
     globalContext()->setCurrentProject(nullptr);
 
+    return ret;
+}
+
+mu::Ret ConverterController::convertJob(const Job& job, const io::path_t& stylePath, bool forceMode)
+{
+    if (isSoundTracksJob(job)) {
+        return convertToSoundTracks(job, stylePath, forceMode);
+    }
+
+    if (!job.stemsOut.empty()) {
+        LOGE() << "per track output is supported for audio only, out: " << jobOutString(job);
+        return make_ret(Err::ConvertTypeUnknown);
+    }
+
+    for (const io::path_t& out : job.out) {
+        Ret ret = fileConvert(job.in, out, stylePath, forceMode);
+        if (!ret) {
+            return ret;
+        }
+    }
+
     return make_ret(Ret::Code::Ok);
 }
 
+bool ConverterController::isSoundTracksJob(const Job& job) const
+{
+    if (!soundTracksExporter()) {
+        return false;
+    }
+
+    //! NOTE A single output goes the usual way, so that it behaves like the plain conversion,
+    //! the stems are only written this way
+    if (job.stemsOut.empty() && job.out.size() < 2) {
+        return false;
+    }
+
+    static const std::set<std::string> AUDIO_SUFFIXES = { "wav", "mp3", "ogg", "flac" };
+
+    for (const io::path_t& path : job.out) {
+        if (AUDIO_SUFFIXES.find(io::suffix(path)) == AUDIO_SUFFIXES.cend()) {
+            return false;
+        }
+    }
+
+    for (const iex::audioexport::StemsPath& stems : job.stemsOut) {
+        if (AUDIO_SUFFIXES.find(io::suffix(stems.prefix + stems.suffix)) == AUDIO_SUFFIXES.cend()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+mu::Ret ConverterController::convertToSoundTracks(const Job& job, const io::path_t& stylePath, bool forceMode)
+{
+    TRACEFUNC;
+
+    LOGI() << "in: " << job.in << ", out: " << jobOutString(job);
+    auto notationProject = notationCreator()->newProject();
+    IF_ASSERT_FAILED(notationProject) {
+        return make_ret(Err::UnknownError);
+    }
+
+    Ret ret = notationProject->load(job.in, stylePath, forceMode);
+    if (!ret) {
+        LOGE() << "failed load notation, err: " << ret.toString() << ", path: " << job.in;
+        return make_ret(Err::InFileFailedLoad);
+    }
+
+    globalContext()->setCurrentProject(notationProject);
+
+    //! NOTE All the files are written during one playback render of the score
+    ret = soundTracksExporter()->exportSoundTracks(notationProject->masterNotation()->notation(), job.out, job.stemsOut);
+    if (!ret) {
+        LOGE() << "failed export sound tracks, err: " << ret.toString();
+        ret = make_ret(Err::OutFileFailedWrite);
+    }
+
+    globalContext()->setCurrentProject(nullptr);
+
+    return ret;
+}
+
 mu::Ret ConverterController::convertScoreParts(const mu::io::path_t& in, const mu::io::path_t& out, const mu::io::path_t& stylePath,
                                                bool forceMode)
 {
@@ -162,9 +480,21 @@ mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(con
 
         Job job;
         job.in = correctUserInputPath(obj["in"].toString());
-        job.out = correctUserInputPath(obj["out"].toString());
 
-        if (!job.in.empty() && !job.out.empty()) {
+        //! NOTE "out" is either a path or an array of outputs of the same input,
+        //! an output ["prefix", "suffix"] means a file per track: prefix + track name + suffix
+        QJsonValue outVal = obj["out"];
+        QJsonArray outArr = outVal.isArray() ? outVal.toArray() : QJsonArray { outVal };
+        for (const QJsonValue out : outArr) {
+            if (out.isArray()) {
+                QJsonArray stems = out.toArray();
+                job.stemsOut.push_back({ correctUserInputPath(stems.at(0).toString()), correctUserInputPath(stems.at(1).toString()) });
+            } else if (!out.toString().isEmpty()) {
+                job.out.push_back(correctUserInputPath(out.toString()));
+            }
+        }
+
+        if (!job.in.empty() && !(job.out.empty() && job.stemsOut.empty())) {
             rv.val.push_back(std::move(job));
         }
     }
@@ -173,6 +503,50 @@ mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(con
     return rv;
 }
 
+QString ConverterController::jobOutString(const Job& job)
+{
+    QStringList outs;
+    for (const io::path_t& out : job.out) {
+        outs << out.toQString();
+    }
+
+    for (const iex::audioexport::StemsPath& stems : job.stemsOut) {
+        outs << stems.prefix.toQString() + "*" + stems.suffix.toQString();
+    }
+
+    return outs.join(", ");
+}
+
+mu::Ret ConverterController::writeBatchJob(const BatchJob& batchJob, const io::path_t& batchJobFile) const
+{
+    QJsonArray arr;
+    for (const Job& job : batchJob) {
+        QJsonObject obj;
+        obj["in"] = job.in.toQString();
+
+        QJsonArray outArr;
+        for (const io::path_t& out : job.out) {
+            outArr.append(out.toQString());
+        }
+
+        for (const iex::audioexport::StemsPath& stems : job.stemsOut) {
+            outArr.append(QJsonArray { stems.prefix.toQString(), stems.suffix.toQString() });
+        }
+
+        obj["out"] = outArr;
+        arr.append(obj);
+    }
+
+    QFile file(batchJobFile.toQString());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return make_ret(Err::BatchJobFileFailedOpen);
+    }
+
+    file.write(QJsonDocument(arr).toJson(QJsonDocument::Compact));
+
+    return make_ret(Ret::Code::Ok);
+}
+
 bool ConverterController::isConvertPageByPage(const std::string& suffix) const
 {
     QList<std::string> types {
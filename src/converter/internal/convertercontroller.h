@@ -22,7 +22,7 @@
 #ifndef MU_CONVERTER_CONVERTERCONTROLLER_H
 #define MU_CONVERTER_CONVERTERCONTROLLER_H
 
-#include <list>
+#include <vector>
 
 #include "../iconvertercontroller.h"
 
@@ -31,9 +31,12 @@
 #include "project/inotationwritersregister.h"
 #include "project/iprojectrwregister.h"
 #include "context/iglobalcontext.h"
+#include "importexport/audioexport/isoundtracksexporter.h"
 
 #include "types/retval.h"
 
+class QJsonObject;
+
 namespace mu::converter {
 class ConverterController : public IConverterController
 {
@@ -41,13 +44,15 @@ class ConverterController : public IConverterController
     INJECT(project::INotationWritersRegister, writers)
     INJECT(project::IProjectRWRegister, projectRW)
     INJECT(context::IGlobalContext, globalContext)
+    INJECT(iex::audioexport::ISoundTracksExporter, soundTracksExporter)
 
 public:
     ConverterController() = default;
 
     Ret fileConvert(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
                     bool forceMode = false) override;
-    Ret batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath = io::path_t(), bool forceMode = false) override;
+    Ret batchConvert(const io::path_t& batchJobFile, const io::path_t& stylePath = io::path_t(), bool forceMode = false,
+                     int workersCount = 1, const io::path_t& reportPath = io::path_t()) override;
     Ret convertScoreParts(const io::path_t& in, const io::path_t& out, const io::path_t& stylePath = io::path_t(),
                           bool forceMode = false) override;
 
@@ -71,12 +76,22 @@ private:
 
     struct Job {
         io::path_t in;
-        io::path_t out;
+        io::paths_t out;
+        iex::audioexport::StemsPaths stemsOut;
     };
 
-    using BatchJob = std::list<Job>;
+    using BatchJob = std::vector<Job>;
+
+    Ret convertJob(const Job& job, const io::path_t& stylePath, bool forceMode);
+    Ret convertToSoundTracks(const Job& job, const io::path_t& stylePath, bool forceMode);
+    bool isSoundTracksJob(const Job& job) const;
+    static QString jobOutString(const Job& job);
 
     RetVal<BatchJob> parseBatchJob(const io::path_t& batchJobFile) const;
+    Ret writeBatchJob(const BatchJob& batchJob, const io::path_t& batchJobFile) const;
+
+    Ret batchConvertInWorkers(const BatchJob& batchJob, int workersCount, const io::path_t& reportPath) const;
+    std::vector<QJsonObject> runBatchJobWorker(const BatchJob& batchJob, const io::path_t& workDir) const;
 
     bool isConvertPageByPage(const std::string& suffix) const;
     Ret convertPageByPage(project::INotationWriterPtr writer, notation::INotationPtr notation, const io::path_t& out) const;
@@ -145,7 +145,14 @@ Ret EngravingProject::loadMscz(const MscReader& msc, SettingsCompat& settingsCom
     TRACEFUNC;
     MScore::setError(MsError::MS_NO_ERROR);
     MscLoader loader;
-    return loader.loadMscz(m_masterScore, msc, settingsCompat, ignoreVersionError);
+    Ret ret = loader.loadMscz(m_masterScore, msc, settingsCompat, ignoreVersionError);
+    m_excerptsLoadStatistics = loader.excerptsStatistics();
+    return ret;
+}
+
+const std::vector<ExcerptLoadStatistics>& EngravingProject::excerptsLoadStatistics() const
+{
+    return m_excerptsLoadStatistics;
 }
 
 bool EngravingProject::writeMscz(MscWriter& writer, bool onlySelection, bool createThumbnail)
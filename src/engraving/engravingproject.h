@@ -69,6 +69,7 @@ public:
     Ret setupMasterScore(bool forceMode);
 
     Ret loadMscz(const MscReader& msc, SettingsCompat& settingsCompat, bool ignoreVersionError);
+    const std::vector<ExcerptLoadStatistics>& excerptsLoadStatistics() const;
     bool writeMscz(MscWriter& writer, bool onlySelection, bool createThumbnail);
 
     bool isCorruptedUponLoading() const;
@@ -86,6 +87,7 @@ private:
     MasterScore* m_masterScore = nullptr;
 
     bool m_isCorruptedUponLoading = false;
+    std::vector<ExcerptLoadStatistics> m_excerptsLoadStatistics;
 };
 
 using EngravingProjectPtr = std::shared_ptr<EngravingProject>;
@@ -192,7 +192,7 @@ void DebugPaint::paintPageDebug(Painter& painter, const Page* page)
                         PainterPath path;
                         path.setFillRule(PainterPath::FillRule::WindingFill);
 
-                        Shape shape = s->shapes().at(i);
+                        const Shape& shape = s->shapes().at(i);
                         for (const RectF& rect : shape) {
                             path.addRect(rect);
                         }
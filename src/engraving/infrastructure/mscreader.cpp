@@ -22,6 +22,7 @@
 #include "mscreader.h"
 
 #include "io/file.h"
+#include "io/buffer.h"
 #include "io/fileinfo.h"
 #include "io/dir.h"
 #include "serialization/zipreader.h"
@@ -257,7 +258,14 @@ bool MscReader::ZipFileReader::open(IODevice* device, const path_t& filePath)
 {
     m_device = device;
     if (!m_device) {
-        m_device = new File(filePath);
+        //! NOTE The file is mapped, not read, so only the central directory and the entries
+        //! that are actually requested (e.g. the score and the thumbnail for the meta) are loaded from disk
+        if (!File::mapFile(filePath, m_mappedData)) {
+            LOGD() << "failed open file: " << filePath;
+            return false;
+        }
+
+        m_device = new Buffer(&m_mappedData);
         m_selfDeviceOwner = true;
     }
 
@@ -282,6 +290,8 @@ void MscReader::ZipFileReader::close()
     if (m_device) {
         m_device->close();
     }
+
+    m_mappedData = ByteArray();
 }
 
 bool MscReader::ZipFileReader::isOpened() const
@@ -300,7 +310,10 @@ StringList MscReader::ZipFileReader::fileList() const
         return StringList();
     }
 
-    StringList files;
+    if (m_fileListScanned) {
+        return m_fileList;
+    }
+
     std::vector<ZipReader::FileInfo> fileInfoList = m_zip->fileInfoList();
     if (m_zip->hasError()) {
         LOGD() << "failed read meta";
@@ -308,11 +321,13 @@ StringList MscReader::ZipFileReader::fileList() const
 
     for (const ZipReader::FileInfo& fi : fileInfoList) {
         if (fi.isFile) {
-            files << fi.filePath.toString();
+            m_fileList << fi.filePath.toString();
         }
     }
 
-    return files;
+    m_fileListScanned = true;
+
+    return m_fileList;
 }
 
 bool MscReader::ZipFileReader::fileExists(const String& fileName) const
@@ -0,0 +1,278 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_ENGRAVING_SMALLVECTOR_H
+#define MU_ENGRAVING_SMALLVECTOR_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace mu::engraving {
+//---------------------------------------------------------
+//   SmallVector
+//    Vector which keeps up to N elements in place and only
+//    allocates when it grows beyond that. Meant for the
+//    many short-lived containers created during layout
+//    (most shapes have a single element).
+//    The iterators are plain pointers.
+//---------------------------------------------------------
+
+template<typename T, size_t N>
+class SmallVector
+{
+    static_assert(N > 0, "SmallVector needs an inline capacity");
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() = default;
+
+    SmallVector(const SmallVector& other)
+    {
+        append(other.begin(), other.end());
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        moveFrom(std::move(other));
+    }
+
+    ~SmallVector()
+    {
+        clear();
+        freeHeap();
+    }
+
+    SmallVector& operator=(const SmallVector& other)
+    {
+        if (this != &other) {
+            clear();
+            append(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &other) {
+            clear();
+            freeHeap();
+            moveFrom(std::move(other));
+        }
+        return *this;
+    }
+
+    iterator begin() { return m_data; }
+    const_iterator begin() const { return m_data; }
+    const_iterator cbegin() const { return m_data; }
+    iterator end() { return m_data + m_size; }
+    const_iterator end() const { return m_data + m_size; }
+    const_iterator cend() const { return m_data + m_size; }
+
+    T* data() { return m_data; }
+    const T* data() const { return m_data; }
+
+    size_t size() const { return m_size; }
+    size_t capacity() const { return m_capacity; }
+    bool empty() const { return m_size == 0; }
+    bool isInline() const { return m_data == inlineData(); }
+
+    T& operator[](size_t i) { return m_data[i]; }
+    const T& operator[](size_t i) const { return m_data[i]; }
+
+    T& at(size_t i)
+    {
+        assert(i < m_size);
+        return m_data[i];
+    }
+
+    const T& at(size_t i) const
+    {
+        assert(i < m_size);
+        return m_data[i];
+    }
+
+    T& front() { return m_data[0]; }
+    const T& front() const { return m_data[0]; }
+    T& back() { return m_data[m_size - 1]; }
+    const T& back() const { return m_data[m_size - 1]; }
+
+    void reserve(size_t capacity)
+    {
+        if (capacity <= m_capacity) {
+            return;
+        }
+
+        T* data = allocate(capacity);
+        moveTo(data, capacity);
+    }
+
+    void clear()
+    {
+        std::destroy(m_data, m_data + m_size);
+        m_size = 0;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template<typename ... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (m_size == m_capacity) {
+            //! NOTE the value may refer to an element of this vector
+            T value(std::forward<Args>(args)...);
+            reserve(size_t(m_capacity) * 2);
+            return *new (m_data + m_size++) T(std::move(value));
+        }
+        return *new (m_data + m_size++) T(std::forward<Args>(args)...);
+    }
+
+    void pop_back()
+    {
+        m_data[--m_size].~T();
+    }
+
+    template<typename InputIt>
+    iterator insert(const_iterator pos, InputIt first, InputIt last)
+    {
+        const size_t index = pos - m_data;
+        const size_t oldSize = m_size;
+        append(first, last);
+        std::rotate(m_data + index, m_data + oldSize, m_data + m_size);
+        return m_data + index;
+    }
+
+    iterator insert(const_iterator pos, const T& value)
+    {
+        const size_t index = pos - m_data;
+        emplace_back(value);
+        std::rotate(m_data + index, m_data + m_size - 1, m_data + m_size);
+        return m_data + index;
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        T* f = m_data + (first - m_data);
+        T* l = m_data + (last - m_data);
+        if (f != l) {
+            T* newEnd = std::move(l, end(), f);
+            std::destroy(newEnd, end());
+            m_size = static_cast<uint32_t>(newEnd - m_data);
+        }
+        return f;
+    }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    template<typename Predicate>
+    bool remove_if(Predicate p)
+    {
+        const size_t origSize = m_size;
+        erase(std::remove_if(begin(), end(), p), end());
+        return origSize != m_size;
+    }
+
+private:
+    T* inlineData() { return reinterpret_cast<T*>(m_inline); }
+    const T* inlineData() const { return reinterpret_cast<const T*>(m_inline); }
+
+    static T* allocate(size_t capacity)
+    {
+        assert(capacity <= UINT32_MAX);
+        return static_cast<T*>(::operator new(capacity * sizeof(T)));
+    }
+
+    void moveTo(T* data, size_t capacity)
+    {
+        std::uninitialized_move(m_data, m_data + m_size, data);
+        std::destroy(m_data, m_data + m_size);
+        freeHeap();
+
+        m_data = data;
+        m_capacity = static_cast<uint32_t>(capacity);
+    }
+
+    template<typename InputIt>
+    void append(InputIt first, InputIt last)
+    {
+        const size_t count = std::distance(first, last);
+        if (m_size + count <= m_capacity) {
+            std::uninitialized_copy(first, last, m_data + m_size);
+            m_size += static_cast<uint32_t>(count);
+            return;
+        }
+
+        //! NOTE [first, last) may point into this vector,
+        //! so it is copied to the new buffer before the old one is freed
+        const size_t capacity = std::max(m_size + count, size_t(m_capacity) * 2);
+        T* data = allocate(capacity);
+        std::uninitialized_copy(first, last, data + m_size);
+        moveTo(data, capacity);
+        m_size += static_cast<uint32_t>(count);
+    }
+
+    void moveFrom(SmallVector&& other)
+    {
+        if (other.isInline()) {
+            m_data = inlineData();
+            m_capacity = N;
+            std::uninitialized_move(other.begin(), other.end(), m_data);
+            m_size = other.m_size;
+            other.clear();
+        } else {
+            m_data = other.m_data;
+            m_size = other.m_size;
+            m_capacity = other.m_capacity;
+            other.m_data = other.inlineData();
+            other.m_size = 0;
+            other.m_capacity = N;
+        }
+    }
+
+    void freeHeap()
+    {
+        if (!isInline()) {
+            ::operator delete(m_data);
+            m_data = inlineData();
+            m_capacity = N;
+        }
+    }
+
+    alignas(T) unsigned char m_inline[N * sizeof(T)];
+    T* m_data = inlineData();
+    uint32_t m_size = 0;
+    uint32_t m_capacity = N;
+};
+}
+
+#endif // MU_ENGRAVING_SMALLVECTOR_H
@@ -94,6 +94,13 @@ void EngravingFont::ensureLoad()
         return;
     }
 
+    //! NOTE The measures of a system are laid out concurrently,
+    //! so the first use of a font may come from several threads at once
+    std::lock_guard lock(m_loadMutex);
+    if (m_loaded) {
+        return;
+    }
+
     if (-1 == fontProvider()->addSymbolFont(String::fromStdString(m_family), m_fontPath)) {
         LOGE() << "fatal error: cannot load internal font: " << m_fontPath;
         return;
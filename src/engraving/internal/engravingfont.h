@@ -22,6 +22,8 @@
 #ifndef MU_ENGRAVING_ENGRAVINGFONT_H
 #define MU_ENGRAVING_ENGRAVINGFONT_H
 
+#include <atomic>
+#include <mutex>
 #include <unordered_map>
 
 #include "iengravingfont.h"
@@ -125,7 +127,8 @@ private:
 
     bool useFallbackFont(SymId id) const;
 
-    bool m_loaded = false;
+    std::atomic<bool> m_loaded = false;
+    std::mutex m_loadMutex;
     std::vector<Sym> m_symbols;
     mutable draw::Font m_font;
 
@@ -33,6 +33,8 @@ void EngravingFontsProvider::addFont(const std::string& name, const std::string&
 {
     std::shared_ptr<EngravingFont> f = std::make_shared<EngravingFont>(name, family, filePath);
     m_symbolFonts.push_back(f);
+
+    std::lock_guard lock(m_fallbackMutex);
     m_fallback.font = nullptr;
 }
 
@@ -69,12 +71,15 @@ std::vector<IEngravingFontPtr> EngravingFontsProvider::fonts() const
 
 void EngravingFontsProvider::setFallbackFont(const std::string& name)
 {
+    std::lock_guard lock(m_fallbackMutex);
     m_fallback.name = name;
     m_fallback.font = nullptr;
 }
 
 std::shared_ptr<EngravingFont> EngravingFontsProvider::doFallbackFont() const
 {
+    //! NOTE May be called from the threads of a concurrent system layout
+    std::lock_guard lock(m_fallbackMutex);
     if (!m_fallback.font) {
         m_fallback.font = doFontByName(m_fallback.name);
         IF_ASSERT_FAILED(m_fallback.font) {
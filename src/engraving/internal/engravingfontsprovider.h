@@ -23,6 +23,7 @@
 #ifndef MU_ENGRAVING_ENGRAVINGFONTSPROVIDER_H
 #define MU_ENGRAVING_ENGRAVINGFONTSPROVIDER_H
 
+#include <mutex>
 #include <vector>
 
 #include "iengravingfontsprovider.h"
@@ -56,6 +57,7 @@ private:
     };
 
     mutable Fallback m_fallback;
+    mutable std::mutex m_fallbackMutex;
     std::vector<std::shared_ptr<EngravingFont> > m_symbolFonts;
 };
 }
@@ -80,6 +80,12 @@ class TimeSig;
 }
 
 namespace mu::engraving::layout {
+struct LayoutStatistics
+{
+    size_t recomputedSystems = 0; // collected and laid out from scratch
+    size_t reusedSystems = 0;     // taken unchanged from the previous layout
+};
+
 class ILayout : MODULE_INTERNAL_INTERFACE
 {
     INTERFACE_ID(IEngravingLayout)
@@ -89,6 +95,7 @@ public:
 
     // Layout Score
     virtual void layoutRange(Score* score, const LayoutOptions& options, const Fraction&, const Fraction&) = 0;
+    virtual LayoutStatistics lastLayoutStatistics() const = 0;
 
     // Layout Item
     using Supported = std::variant<std::monostate,
@@ -879,7 +879,7 @@ void BeamLayout::verticalAdjustBeamedRests(Rest* rest, Beam* beam, LayoutContext
     }
 
     Shape beamShape = beam->shape().translated(beam->pagePos());
-    mu::remove_if(beamShape, [&](ShapeElement& el) {
+    beamShape.remove_if([&](ShapeElement& el) {
         return el.toItem && el.toItem->isBeamSegment() && toBeamSegment(el.toItem)->isBeamlet;
     });
 
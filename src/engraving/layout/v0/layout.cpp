@@ -41,7 +41,12 @@ using namespace mu::engraving::layout::v0;
 
 void Layout::layoutRange(Score* score, const LayoutOptions& options, const Fraction& st, const Fraction& et)
 {
-    ScoreLayout::layoutRange(score, options, st, et);
+    m_lastStatistics = ScoreLayout::layoutRange(score, options, st, et);
+}
+
+LayoutStatistics Layout::lastLayoutStatistics() const
+{
+    return m_lastStatistics;
 }
 
 void Layout::doLayoutItem(EngravingItem* item)
@@ -36,6 +36,7 @@ public:
 
     // Layout Score
     void layoutRange(Score* score, const LayoutOptions& options, const Fraction& st, const Fraction& et) override;
+    LayoutStatistics lastLayoutStatistics() const override;
 
     // Layout Elements on Edit
     void layoutOnEdit(Arpeggio* item) override;
@@ -56,6 +57,8 @@ public:
 private:
     // Layout Single Item
     void doLayoutItem(EngravingItem* item) override;
+
+    LayoutStatistics m_lastStatistics;
 };
 }
 
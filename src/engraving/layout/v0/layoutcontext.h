@@ -63,6 +63,7 @@ public:
     MeasureBase* systemOldMeasure = nullptr;
     MeasureBase* pageOldMeasure = nullptr;
     bool rangeDone = false;
+    bool curSystemReused = false; // curSystem was taken unchanged from the previous layout
 
     MeasureBase* prevMeasure = nullptr;
     MeasureBase* curMeasure = nullptr;
@@ -73,6 +74,12 @@ public:
 
     double totalBracketsWidth = -1.0;
 
+    // full relayout: the independent per-measure and per-staff work of a system runs concurrently
+    bool parallelMeasureLayout = false;
+
+    size_t recomputedSystemsCount = 0;
+    size_t reusedSystemsCount = 0;
+
 private:
     Score* m_score = nullptr;
 };
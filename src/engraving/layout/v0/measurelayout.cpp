@@ -780,6 +780,8 @@ void MeasureLayout::getNextMeasure(const LayoutOptions& options, LayoutContext&
             ctx.measureNo += toMeasure(ctx.curMeasure)->mmRestCount() - 1;
         }
     }
+    ctx.curMeasure->incLayoutRevision();
+
     if (!ctx.curMeasure->isMeasure()) {
         ctx.curMeasure->setTick(ctx.tick);
         return;
@@ -137,10 +137,30 @@ void PageLayout::collectPage(const LayoutOptions& options, LayoutContext& ctx)
         double distance = ps->minDistance(cs);
         y += distance;
         cs->setPos(ctx.page->lm(), y);
+        cs->setUnstretchedY(y);
         SystemLayout::restoreLayout2(cs, ctx);
         y += cs->height();
     }
 
+    auto takeUnchangedSystem = [&ctx, &systemIdx]() -> System* {
+        System* system = nullptr;
+        if (systemIdx > 0) {
+            system = mu::value(ctx.score()->systems(), systemIdx++);
+            if (!system) {
+                // TODO: handle next movement
+            }
+        } else {
+            system = ctx.systemList.empty() ? 0 : mu::takeFirst(ctx.systemList);
+            if (system) {
+                ctx.score()->systems().push_back(system);
+            }
+        }
+        if (system) {
+            ++ctx.reusedSystemsCount;
+        }
+        return system;
+    };
+
     for (;;) {
         //
         // calculate distance to previous system
@@ -184,7 +204,14 @@ void PageLayout::collectPage(const LayoutOptions& options, LayoutContext& ctx)
         }
 
         y += distance;
+
+        // An unchanged system which lands on the same page at the same place as before
+        // is followed by the rest of that page exactly as it was laid out before
+        bool stable = ctx.curSystemReused && ctx.curSystem->page() == ctx.page
+                      && RealIsEqual(ctx.curSystem->unstretchedY(), y);
+
         ctx.curSystem->setPos(ctx.page->lm(), y);
+        ctx.curSystem->setUnstretchedY(y);
         SystemLayout::restoreLayout2(ctx.curSystem, ctx);
         ctx.page->appendSystem(ctx.curSystem);
         y += ctx.curSystem->height();
@@ -193,19 +220,21 @@ void PageLayout::collectPage(const LayoutOptions& options, LayoutContext& ctx)
         //  check for page break or if next system will fit on page
         //
         bool collected = false;
-        if (ctx.rangeDone) {
-            // take next system unchanged
-            if (systemIdx > 0) {
-                nextSystem = mu::value(ctx.score()->systems(), systemIdx++);
-                if (!nextSystem) {
-                    // TODO: handle next movement
-                }
-            } else {
-                nextSystem = ctx.systemList.empty() ? 0 : mu::takeFirst(ctx.systemList);
-                if (nextSystem) {
-                    ctx.score()->systems().push_back(nextSystem);
-                }
+        if (stable) {
+            // take the rest of the page as is, without measuring the distances again
+            nextSystem = takeUnchangedSystem();
+            while (nextSystem && nextSystem->page() == ctx.page) {
+                ctx.prevSystem = ctx.curSystem;
+                ctx.curSystem = nextSystem;
+                ctx.curSystem->setPos(ctx.page->lm(), ctx.curSystem->unstretchedY());
+                SystemLayout::restoreLayout2(ctx.curSystem, ctx);
+                ctx.page->appendSystem(ctx.curSystem);
+                y = ctx.curSystem->unstretchedY() + ctx.curSystem->height();
+
+                nextSystem = takeUnchangedSystem();
             }
+        } else if (ctx.rangeDone) {
+            nextSystem = takeUnchangedSystem();
         } else {
             nextSystem = SystemLayout::collectSystem(options, ctx, ctx.score());
             if (nextSystem) {
@@ -215,8 +244,10 @@ void PageLayout::collectPage(const LayoutOptions& options, LayoutContext& ctx)
         ctx.prevSystem = ctx.curSystem;
         assert(ctx.curSystem != nextSystem);
         ctx.curSystem  = nextSystem;
+        ctx.curSystemReused = nextSystem && !collected;
 
-        bool breakPage = !ctx.curSystem || (breakPages && ctx.prevSystem->pageBreak());
+        // the page ended there before, so it does now
+        bool breakPage = !ctx.curSystem || stable || (breakPages && ctx.prevSystem->pageBreak());
 
         if (!breakPage) {
             double dist = ctx.prevSystem->minDistance(ctx.curSystem) + ctx.curSystem->height();
@@ -256,7 +287,16 @@ void PageLayout::collectPage(const LayoutOptions& options, LayoutContext& ctx)
     }
 
     Fraction stick = Fraction(-1, 1);
+    const System* prevPageSystem = nullptr;
     for (System* s : ctx.page->systems()) {
+        // a system which has neither been changed nor moved vertically since
+        // the last time it was processed here can be kept as is
+        size_t fingerprint = SystemLayout::layoutFingerprint(s, prevPageSystem, ctx);
+        prevPageSystem = s;
+        if (fingerprint != 0 && fingerprint == s->layoutFingerprint()) {
+            continue;
+        }
+
         Score* currentScore = ctx.score();
         for (MeasureBase* mb : s->measures()) {
             if (!mb->isMeasure()) {
@@ -342,6 +382,8 @@ void PageLayout::collectPage(const LayoutOptions& options, LayoutContext& ctx)
             }
             MeasureLayout::layout2(m, ctx);
         }
+
+        s->setLayoutFingerprint(fingerprint);
     }
 
     if (options.isMode(LayoutMode::SYSTEM)) {
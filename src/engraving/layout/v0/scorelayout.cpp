@@ -40,11 +40,24 @@ public:
     ~CmdStateLocker() { m_score->cmdState().unlock(); }
 };
 
-void ScoreLayout::layoutRange(Score* score, const LayoutOptions& options, const Fraction& st, const Fraction& et)
+LayoutStatistics ScoreLayout::layoutRange(Score* score, const LayoutOptions& options, const Fraction& st, const Fraction& et)
 {
     CmdStateLocker cmdStateLocker(score);
     LayoutContext ctx(score);
 
+    doLayoutRange(options, ctx, st, et);
+
+    LayoutStatistics statistics;
+    statistics.recomputedSystems = ctx.recomputedSystemsCount;
+    statistics.reusedSystems = ctx.reusedSystemsCount;
+
+    return statistics;
+}
+
+void ScoreLayout::doLayoutRange(const LayoutOptions& options, LayoutContext& ctx, const Fraction& st, const Fraction& et)
+{
+    Score* score = ctx.score();
+
     Fraction stick(st);
     Fraction etick(et);
     assert(!(stick == Fraction(-1, 1) && etick == Fraction(-1, 1)));
@@ -178,6 +191,10 @@ void ScoreLayout::layoutRange(Score* score, const LayoutOptions& options, const
         score->pages().clear();
 
         ctx.nextMeasure = options.showVBox ? score->first() : score->firstMeasure();
+        ctx.parallelMeasureLayout = MScore::useParallelLayout;
+
+        //! NOTE Resolves and loads the fallback font here, rather than in the middle of the concurrent measure layout
+        score->engravingFonts()->fallbackFont();
     }
 
     ctx.prevMeasure = 0;
@@ -1,6 +1,7 @@
 #ifndef MU_ENGRAVING_SCORELAYOUT_H
 #define MU_ENGRAVING_SCORELAYOUT_H
 
+#include "../ilayout.h"
 #include "../layoutoptions.h"
 #include "layoutcontext.h"
 
@@ -13,10 +14,10 @@ class ScoreLayout
 {
 public:
 
-    static void layoutRange(Score* score, const LayoutOptions& options, const Fraction& st, const Fraction& et);
+    static LayoutStatistics layoutRange(Score* score, const LayoutOptions& options, const Fraction& st, const Fraction& et);
 
 private:
-    static void doLayoutRange(Score* score, const LayoutOptions& options, const Fraction&, const Fraction&);
+    static void doLayoutRange(const LayoutOptions& options, LayoutContext& ctx, const Fraction& st, const Fraction& et);
     static void layoutLinear(const LayoutOptions& options, LayoutContext& ctx);
     static void layoutLinear(bool layoutAll, const LayoutOptions& options, LayoutContext& ctx);
     static void resetSystems(bool layoutAll, const LayoutOptions& options, LayoutContext& ctx);
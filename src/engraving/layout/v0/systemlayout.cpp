@@ -45,6 +45,7 @@
 #include "libmscore/score.h"
 #include "libmscore/slur.h"
 #include "libmscore/spacer.h"
+#include "libmscore/spanner.h"
 #include "libmscore/staff.h"
 #include "libmscore/stafflines.h"
 #include "libmscore/stretchedbend.h"
@@ -54,6 +55,8 @@
 #include "libmscore/tuplet.h"
 #include "libmscore/volta.h"
 
+#include "concurrency/taskscheduler.h"
+
 #include "tlayout.h"
 #include "beamlayout.h"
 #include "chordlayout.h"
@@ -68,6 +71,41 @@
 using namespace mu::engraving;
 using namespace mu::engraving::layout::v0;
 
+static constexpr size_t PARALLEL_LAYOUT_MIN_ITEMS = 4;
+
+//---------------------------------------------------------
+//   forEachConcurrently
+//    calls func(idx) for idx in [0, count), concurrently on a full relayout.
+//    func must only modify the measure or staff it is given
+//---------------------------------------------------------
+
+template<typename FuncT>
+static void forEachConcurrently(const LayoutContext& ctx, size_t count, FuncT&& func)
+{
+    if (ctx.parallelMeasureLayout && count >= PARALLEL_LAYOUT_MIN_ITEMS) {
+        mu::parallelFor(size_t(0), count, std::forward<FuncT>(func));
+        return;
+    }
+
+    for (size_t idx = 0; idx < count; ++idx) {
+        func(idx);
+    }
+}
+
+static std::vector<Measure*> systemMeasures(const System* system)
+{
+    std::vector<Measure*> measures;
+    measures.reserve(system->measures().size());
+
+    for (MeasureBase* mb : system->measures()) {
+        if (mb->isMeasure()) {
+            measures.push_back(toMeasure(mb));
+        }
+    }
+
+    return measures;
+}
+
 //---------------------------------------------------------
 //   collectSystem
 //---------------------------------------------------------
@@ -93,6 +131,7 @@ System* SystemLayout::collectSystem(const LayoutOptions& options, LayoutContext&
     }
 
     System* system = getNextSystem(ctx);
+    ++ctx.recomputedSystemsCount;
     Fraction lcmTick = ctx.curMeasure->tick();
     SystemLayout::setInstrumentNames(system, ctx, ctx.startWithLongNames, lcmTick);
 
@@ -431,14 +470,16 @@ System* SystemLayout::collectSystem(const LayoutOptions& options, LayoutContext&
     // If system is currently larger than margin (because of acceptanceRange) compute width
     // with a reduced pre-stretch, because justifySystem expects curSysWidth < targetWidth
     double preStretch = targetSystemWidth > curSysWidth ? 1.0 : 1 - squeezability;
-    for (MeasureBase* mb : system->measures()) {
-        if (!mb->isMeasure()) {
-            continue;
-        }
-        Measure* m = toMeasure(mb);
-        double oldWidth = m->width();
-        MeasureLayout::computeWidth(m, ctx, minTicks, maxTicks, preStretch);
-        curSysWidth += m->width() - oldWidth;
+    std::vector<Measure*> measures = systemMeasures(system);
+    for (const Measure* m : measures) {
+        curSysWidth -= m->width();
+    }
+    // the system's min/max ticks are known by now, so the measures don't depend on each other
+    forEachConcurrently(ctx, measures.size(), [&](size_t idx) {
+        MeasureLayout::computeWidth(measures[idx], ctx, minTicks, maxTicks, preStretch);
+    });
+    for (const Measure* m : measures) {
+        curSysWidth += m->width();
     }
 
     if (curSysWidth > targetSystemWidth) {
@@ -466,17 +507,9 @@ System* SystemLayout::collectSystem(const LayoutOptions& options, LayoutContext&
             }
             mb->setPos(pos);
             mb->setParent(system);
-            Measure* m = toMeasure(mb);
-            MeasureLayout::layoutMeasureElements(m, ctx);
-            MeasureLayout::layoutStaffLines(m, ctx);
-            if (createBrackets) {
-                SystemLayout::addBrackets(system, toMeasure(mb), ctx);
-                createBrackets = false;
-            }
         } else if (mb->isHBox()) {
             mb->setPos(pos + PointF(toHBox(mb)->topGap(), 0.0));
             TLayout::layout(mb, ctx);
-            createBrackets = toHBox(mb)->createSystemHeader();
         } else if (mb->isVBox()) {
             mb->setPos(pos);
         }
@@ -484,6 +517,22 @@ System* SystemLayout::collectSystem(const LayoutOptions& options, LayoutContext&
     }
     system->setWidth(pos.x());
 
+    forEachConcurrently(ctx, measures.size(), [&](size_t idx) {
+        MeasureLayout::layoutMeasureElements(measures[idx], ctx);
+        MeasureLayout::layoutStaffLines(measures[idx], ctx);
+    });
+
+    for (MeasureBase* mb : system->measures()) {
+        if (mb->isMeasure()) {
+            if (createBrackets) {
+                SystemLayout::addBrackets(system, toMeasure(mb), ctx);
+                createBrackets = false;
+            }
+        } else if (mb->isHBox()) {
+            createBrackets = toHBox(mb)->createSystemHeader();
+        }
+    }
+
     layoutSystemElements(options, ctx, score, system);
     SystemLayout::layout2(system, ctx);     // compute staff distances
     for (MeasureBase* mb : system->measures()) {
@@ -752,7 +801,8 @@ void SystemLayout::layoutSystemElements(const LayoutOptions& options, LayoutCont
     //    create skylines
     //-------------------------------------------------------------
 
-    for (size_t staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+    // every staff only writes its own skyline
+    forEachConcurrently(ctx, score->nstaves(), [&](size_t staffIdx) {
         SysStaff* ss = system->staff(staffIdx);
         Skyline& skyline = ss->skyline();
         skyline.clear();
@@ -850,7 +900,7 @@ void SystemLayout::layoutSystemElements(const LayoutOptions& options, LayoutCont
                 }
             }
         }
-    }
+    });
 
     //-------------------------------------------------------------
     // layout articulations, fingering and stretched bends
@@ -2069,6 +2119,11 @@ void SystemLayout::layout2(System* system, LayoutContext& ctx)
         return;
     }
 
+    //! NOTE The skylines are complete here, the distances between the staves are computed from them
+    for (const auto& p : visibleStaves) {
+        p.second->skyline().buildFlat();
+    }
+
     for (auto i = visibleStaves.begin();; ++i) {
         SysStaff* ss  = i->second;
         staff_idx_t si1 = i->first;
@@ -2206,6 +2261,89 @@ void SystemLayout::restoreLayout2(System* system, LayoutContext& ctx)
     SystemLayout::setMeasureHeight(system, system->_systemHeight, ctx);
 }
 
+//---------------------------------------------------------
+//   layoutFingerprint
+//    hash of everything the page layout of the system depends on:
+//    its measures (widths, breaks, numbers, content), spanners
+//    and vertical geometry, including the one of the preceding system.
+//    Returns 0 if the system is affected by the current layout range
+//---------------------------------------------------------
+
+template<typename T>
+static void hashCombine(size_t& seed, const T& value)
+{
+    seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+size_t SystemLayout::layoutFingerprint(const System* system, const System* prevSystem, const LayoutContext& ctx)
+{
+    if (system->measures().empty()) {
+        return 0;
+    }
+
+    Score* score = ctx.score();
+    size_t fingerprint = 0;
+
+    for (const MeasureBase* mb : system->measures()) {
+        hashCombine(fingerprint, mb);
+        hashCombine(fingerprint, mb->tick().ticks());
+        hashCombine(fingerprint, mb->ticks().ticks());
+        hashCombine(fingerprint, mb->width());
+        hashCombine(fingerprint, mb->lineBreak());
+        hashCombine(fingerprint, mb->pageBreak());
+        hashCombine(fingerprint, mb->sectionBreak());
+        hashCombine(fingerprint, mb->noBreak());
+        hashCombine(fingerprint, mb->layoutRevision());
+
+        if (mb->isMeasure()) {
+            const Measure* m = toMeasure(mb);
+            hashCombine(fingerprint, m->no());
+            hashCombine(fingerprint, m->mmRestCount());
+        }
+    }
+
+    int stick = system->measures().front()->tick().ticks();
+    int etick = system->endTick().ticks();
+
+    auto spanners = score->spannerMap().findOverlapping(stick, etick);
+    for (auto interval : spanners) {
+        const Spanner* sp = interval.value;
+        if (sp->tick() <= ctx.endTick) {
+            // may have been changed by this layout
+            return 0;
+        }
+
+        hashCombine(fingerprint, sp);
+        hashCombine(fingerprint, sp->tick().ticks());
+        hashCombine(fingerprint, sp->tick2().ticks());
+    }
+
+    for (staff_idx_t staffIdx = 0; staffIdx < system->staves().size(); ++staffIdx) {
+        const SysStaff* ss = system->staves().at(staffIdx);
+        hashCombine(fingerprint, ss->show());
+        hashCombine(fingerprint, ss->y());
+        hashCombine(fingerprint, ss->bbox().height());
+
+        if (staffIdx < score->nstaves()) {
+            hashCombine(fingerprint, score->staff(staffIdx)->show());
+        }
+    }
+
+    hashCombine(fingerprint, system->height());
+    hashCombine(fingerprint, system->y());
+
+    // ties and slurs continued from the preceding system depend on its position too
+    if (prevSystem) {
+        hashCombine(fingerprint, prevSystem->y());
+        hashCombine(fingerprint, prevSystem->height());
+        for (const SysStaff* ss : prevSystem->staves()) {
+            hashCombine(fingerprint, ss->y());
+        }
+    }
+
+    return fingerprint;
+}
+
 void SystemLayout::setMeasureHeight(System* system, double height, LayoutContext& ctx)
 {
     double _spatium = system->spatium();
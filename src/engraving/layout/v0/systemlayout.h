@@ -49,6 +49,7 @@ public:
 
     static void layout2(System* system, LayoutContext& ctx);
     static void restoreLayout2(System* system, LayoutContext& ctx);
+    static size_t layoutFingerprint(const System* system, const System* prevSystem, const LayoutContext& ctx);
     static void setMeasureHeight(System* system, double height, LayoutContext& ctx);
     static void layoutBracketsVertical(System* system, LayoutContext& ctx);
     static void layoutInstrumentNames(System* system);
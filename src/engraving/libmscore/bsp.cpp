@@ -20,6 +20,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cmath>
 
 #include "bsp.h"
@@ -28,75 +29,105 @@
 using namespace mu;
 
 namespace mu::engraving {
+static constexpr size_t MAX_LOGGED_CHANGES = 4096;
+
 //---------------------------------------------------------
-//   InsertItemBspTreeVisitor
+//   BspTree
 //---------------------------------------------------------
 
-class InsertItemBspTreeVisitor : public BspTreeVisitor
+BspTree::BspTree()
+    : leafCnt(0)
 {
-    OBJECT_ALLOCATOR(engraving, InsertItemBspTreeVisitor)
-public:
-    EngravingItem* item;
-
-    inline void visit(std::list<EngravingItem*>* items) { items->push_front(item); }
-};
+    depth = 0;
+}
 
 //---------------------------------------------------------
-//   RemoveItemBspTreeVisitor
+//   intmaxlog
 //---------------------------------------------------------
 
-class RemoveItemBspTreeVisitor : public BspTreeVisitor
+static inline int intmaxlog(int n)
 {
-    OBJECT_ALLOCATOR(engraving, RemoveItemBspTreeVisitor)
-public:
-    EngravingItem* item;
-
-    inline void visit(std::list<EngravingItem*>* items) { items->remove(item); }
-};
+    return n > 0 ? std::max(int(::ceil(::log(double(n)) / ::log(double(2)))), 5) : 0;
+}
 
 //---------------------------------------------------------
-//   FindItemBspTreeVisitor
+//   climbTree
 //---------------------------------------------------------
 
-class FindItemBspTreeVisitor : public BspTreeVisitor
+template<typename Visitor>
+void BspTree::climbTree(const Visitor& visitor, const mu::PointF& pos, int index)
 {
-    OBJECT_ALLOCATOR(engraving, FindItemBspTreeVisitor)
-public:
-    std::list<EngravingItem*> foundItems;
-
-    void visit(std::list<EngravingItem*>* items)
-    {
-        for (auto it = items->begin(); it != items->end(); ++it) {
-            EngravingItem* item = *it;
-            if (!item->itemDiscovered) {
-                item->itemDiscovered = true;
-                foundItems.push_front(item);
-            }
-        }
+    if (nodes.empty()) {
+        return;
     }
-};
 
-//---------------------------------------------------------
-//   BspTree
-//---------------------------------------------------------
+    Node* node = &nodes[index];
+    int childIndex = firstChildIndex(index);
 
-BspTree::BspTree()
-    : leafCnt(0)
-{
-    depth = 0;
+    switch (node->type) {
+    case Node::Type::LEAF:
+        visitor(leaves[node->leafIndex]);
+        break;
+    case Node::Type::VERTICAL:
+        if (pos.x() < node->offset) {
+            climbTree(visitor, pos, childIndex);
+        } else {
+            climbTree(visitor, pos, childIndex + 1);
+        }
+        break;
+    case Node::Type::HORIZONTAL:
+        if (pos.y() < node->offset) {
+            climbTree(visitor, pos, childIndex);
+        } else {
+            climbTree(visitor, pos, childIndex + 1);
+        }
+        break;
+    }
 }
 
 //---------------------------------------------------------
-//   intmaxlog
+//   climbTree
 //---------------------------------------------------------
 
-static inline int intmaxlog(int n)
+template<typename Visitor>
+void BspTree::climbTree(const Visitor& visitor, const mu::RectF& rec, int index)
 {
-    return n > 0 ? std::max(int(::ceil(::log(double(n)) / ::log(double(2)))), 5) : 0;
+    if (nodes.empty()) {
+        return;
+    }
+
+    Node* node = &nodes[index];
+    int childIndex = firstChildIndex(index);
+
+    switch (node->type) {
+    case Node::Type::LEAF:
+        visitor(leaves[node->leafIndex]);
+        break;
+    case Node::Type::VERTICAL:
+        if (rec.left() < node->offset) {
+            climbTree(visitor, rec, childIndex);
+            if (rec.right() >= node->offset) {
+                climbTree(visitor, rec, childIndex + 1);
+            }
+        } else {
+            climbTree(visitor, rec, childIndex + 1);
+        }
+        break;
+    case Node::Type::HORIZONTAL:
+        if (rec.top() < node->offset) {
+            climbTree(visitor, rec, childIndex);
+            if (rec.bottom() >= node->offset) {
+                climbTree(visitor, rec, childIndex + 1);
+            }
+        } else {
+            climbTree(visitor, rec, childIndex + 1);
+        }
+    }
 }
 
 //---------------------------------------------------------
 //   initialize
+//    The tree is emptied, all items have to be inserted again.
 //---------------------------------------------------------
 
 void BspTree::initialize(const RectF& rec, int n)
@@ -105,9 +136,19 @@ void BspTree::initialize(const RectF& rec, int n)
     this->rect = rec;
     leafCnt    = 0;
 
+    m_entries.clear();
+    m_freeEntries.clear();
+    m_entryIndexes.clear();
+    m_entryIndexes.reserve(n);
+
+    m_changeLog.clear();
+    m_logStartRevision = ++m_revision;
+
     nodes.resize((1 << (depth + 1)) - 1);
     leaves.resize(1LL << depth);
-    std::fill(leaves.begin(), leaves.end(), std::list<EngravingItem*>());
+    for (std::vector<EntryIndex>& leaf : leaves) {
+        leaf.clear();
+    }
     initialize(rec, depth, 0);
 }
 
@@ -120,6 +161,82 @@ void BspTree::clear()
     leafCnt = 0;
     nodes.clear();
     leaves.clear();
+    m_entries.clear();
+    m_freeEntries.clear();
+    m_entryIndexes.clear();
+
+    m_changeLog.clear();
+    m_logStartRevision = ++m_revision;
+}
+
+//---------------------------------------------------------
+//   needsRebalance
+//    true if the tree got too shallow for the number of
+//    items it holds
+//---------------------------------------------------------
+
+bool BspTree::needsRebalance() const
+{
+    return intmaxlog(int(itemCount())) > int(depth);
+}
+
+//---------------------------------------------------------
+//   logChange
+//---------------------------------------------------------
+
+void BspTree::logChange(const RectF& r)
+{
+    if (m_changeLog.size() >= MAX_LOGGED_CHANGES) {
+        m_changeLog.clear();
+        m_logStartRevision = m_revision;
+    }
+    m_changeLog.emplace_back(++m_revision, r);
+}
+
+//---------------------------------------------------------
+//   changedAreasSince
+//---------------------------------------------------------
+
+bool BspTree::changedAreasSince(uint64_t revision, std::vector<RectF>& areas) const
+{
+    if (revision < m_logStartRevision || revision > m_revision) {
+        return false;
+    }
+
+    auto it = std::upper_bound(m_changeLog.begin(), m_changeLog.end(), revision,
+                               [](uint64_t rev, const std::pair<uint64_t, RectF>& change) { return rev < change.first; });
+    for (; it != m_changeLog.end(); ++it) {
+        areas.push_back(it->second);
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   insertEntry
+//---------------------------------------------------------
+
+void BspTree::insertEntry(EntryIndex idx)
+{
+    climbTree([idx](std::vector<EntryIndex>& leaf) {
+        leaf.push_back(idx);
+    }, m_entries[idx].rect);
+}
+
+//---------------------------------------------------------
+//   removeEntry
+//    Uses the rectangle the entry was inserted with, so the
+//    item itself is not accessed (it may be deleted already).
+//---------------------------------------------------------
+
+void BspTree::removeEntry(EntryIndex idx)
+{
+    climbTree([idx](std::vector<EntryIndex>& leaf) {
+        auto it = std::find(leaf.begin(), leaf.end(), idx);
+        if (it != leaf.end()) {
+            *it = leaf.back();
+            leaf.pop_back();
+        }
+    }, m_entries[idx].rect);
 }
 
 //---------------------------------------------------------
@@ -128,9 +245,32 @@ void BspTree::clear()
 
 void BspTree::insert(EngravingItem* element)
 {
-    InsertItemBspTreeVisitor insertVisitor;
-    insertVisitor.item = element;
-    climbTree(&insertVisitor, element->pageBoundingRect());
+    if (contains(element)) {
+        update(element);
+        return;
+    }
+
+    EntryIndex idx;
+    if (!m_freeEntries.empty()) {
+        idx = m_freeEntries.back();
+        m_freeEntries.pop_back();
+    } else {
+        idx = static_cast<EntryIndex>(m_entries.size());
+        m_entries.emplace_back();
+    }
+
+    Entry& entry = m_entries[idx];
+    entry.item = element;
+    entry.rect = element->pageBoundingRect();
+    entry.queryStamp = 0;
+    entry.syncStamp = m_syncStamp;
+
+    m_entryIndexes.emplace(element, idx);
+    insertEntry(idx);
+
+    if (m_syncing) {
+        logChange(entry.rect);
+    }
 }
 
 //---------------------------------------------------------
@@ -139,9 +279,124 @@ void BspTree::insert(EngravingItem* element)
 
 void BspTree::remove(EngravingItem* element)
 {
-    RemoveItemBspTreeVisitor removeVisitor;
-    removeVisitor.item = element;
-    climbTree(&removeVisitor, element->pageBoundingRect());
+    auto it = m_entryIndexes.find(element);
+    if (it == m_entryIndexes.end()) {
+        return;
+    }
+
+    EntryIndex idx = it->second;
+    removeEntry(idx);
+    logChange(m_entries[idx].rect);
+    m_entries[idx].item = nullptr;
+    m_freeEntries.push_back(idx);
+    m_entryIndexes.erase(it);
+}
+
+//---------------------------------------------------------
+//   update
+//    Reinserts the item if its bounding rect has changed
+//    since it was inserted.
+//---------------------------------------------------------
+
+void BspTree::update(EngravingItem* element)
+{
+    auto it = m_entryIndexes.find(element);
+    if (it == m_entryIndexes.end()) {
+        insert(element);
+        return;
+    }
+
+    EntryIndex idx = it->second;
+    Entry& entry = m_entries[idx];
+    entry.syncStamp = m_syncStamp;
+
+    RectF r = element->pageBoundingRect();
+    if (r == entry.rect) {
+        return;
+    }
+
+    removeEntry(idx);
+    logChange(entry.rect);
+    logChange(r);
+    entry.rect = r;
+    insertEntry(idx);
+}
+
+//---------------------------------------------------------
+//   contains
+//---------------------------------------------------------
+
+bool BspTree::contains(const EngravingItem* element) const
+{
+    return m_entryIndexes.find(element) != m_entryIndexes.end();
+}
+
+//---------------------------------------------------------
+//   beginSync
+//---------------------------------------------------------
+
+void BspTree::beginSync()
+{
+    ++m_syncStamp;
+    m_syncing = true;
+}
+
+//---------------------------------------------------------
+//   endSync
+//---------------------------------------------------------
+
+void BspTree::endSync()
+{
+    for (EntryIndex idx = 0; idx < m_entries.size(); ++idx) {
+        Entry& entry = m_entries[idx];
+        if (!entry.item || entry.syncStamp == m_syncStamp) {
+            continue;
+        }
+        removeEntry(idx);
+        logChange(entry.rect);
+        m_entryIndexes.erase(entry.item);
+        entry.item = nullptr;
+        m_freeEntries.push_back(idx);
+    }
+    m_syncing = false;
+}
+
+//---------------------------------------------------------
+//   nextQueryStamp
+//    Query stamps are used instead of a flag on the items
+//    to report every item only once.
+//---------------------------------------------------------
+
+uint32_t BspTree::nextQueryStamp()
+{
+    if (++m_queryStamp == 0) {
+        for (Entry& entry : m_entries) {
+            entry.queryStamp = 0;
+        }
+        m_queryStamp = 1;
+    }
+    return m_queryStamp;
+}
+
+//---------------------------------------------------------
+//   findItems
+//---------------------------------------------------------
+
+void BspTree::findItems(std::vector<EngravingItem*>& result, const RectF& rec)
+{
+    const uint32_t stamp = m_queryStamp;
+    climbTree([this, &result, &rec, stamp](const std::vector<EntryIndex>& leaf) {
+        for (EntryIndex idx : leaf) {
+            Entry& entry = m_entries[idx];
+            if (entry.queryStamp == stamp) {
+                continue;
+            }
+            entry.queryStamp = stamp;
+            if (entry.rect.intersects(rec)) {
+                result.push_back(entry.item);
+            }
+        }
+    }, rec);
 }
 
 //---------------------------------------------------------
@@ -150,14 +405,24 @@ void BspTree::remove(EngravingItem* element)
 
 std::vector<EngravingItem*> BspTree::items(const RectF& rec)
 {
-    FindItemBspTreeVisitor findVisitor;
-    climbTree(&findVisitor, rec);
     std::vector<EngravingItem*> l;
-    for (EngravingItem* e : findVisitor.foundItems) {
-        e->itemDiscovered = false;
-        if (e->pageBoundingRect().intersects(rec)) {
-            l.push_back(e);
-        }
+    nextQueryStamp();
+    findItems(l, rec);
+    return l;
+}
+
+//---------------------------------------------------------
+//   items
+//    Every item is reported once even if it intersects
+//    several of the given rectangles.
+//---------------------------------------------------------
+
+std::vector<EngravingItem*> BspTree::items(const std::vector<RectF>& rects)
+{
+    std::vector<EngravingItem*> l;
+    nextQueryStamp();
+    for (const RectF& rec : rects) {
+        findItems(l, rec);
     }
     return l;
 }
@@ -168,16 +433,20 @@ std::vector<EngravingItem*> BspTree::items(const RectF& rec)
 
 std::vector<EngravingItem*> BspTree::items(const PointF& pos)
 {
-    FindItemBspTreeVisitor findVisitor;
-    climbTree(&findVisitor, pos);
-
     std::vector<EngravingItem*> l;
-    for (EngravingItem* e : findVisitor.foundItems) {
-        e->itemDiscovered = false;
-        if (e->contains(pos)) {
-            l.push_back(e);
+    const uint32_t stamp = nextQueryStamp();
+    climbTree([this, &l, &pos, stamp](const std::vector<EntryIndex>& leaf) {
+        for (EntryIndex idx : leaf) {
+            Entry& entry = m_entries[idx];
+            if (entry.queryStamp == stamp) {
+                continue;
+            }
+            entry.queryStamp = stamp;
+            if (entry.item->contains(pos)) {
+                l.push_back(entry.item);
+            }
         }
-    }
+    }, pos);
     return l;
 }
 
@@ -262,79 +531,6 @@ void BspTree::initialize(const RectF& rec, int dep, int index)
     }
 }
 
-//---------------------------------------------------------
-//   climbTree
-//---------------------------------------------------------
-
-void BspTree::climbTree(BspTreeVisitor* visitor, const mu::PointF& pos, int index)
-{
-    if (nodes.empty()) {
-        return;
-    }
-
-    Node* node = &nodes[index];
-    int childIndex = firstChildIndex(index);
-
-    switch (node->type) {
-    case Node::Type::LEAF:
-        visitor->visit(&leaves[node->leafIndex]);
-        break;
-    case Node::Type::VERTICAL:
-        if (pos.x() < node->offset) {
-            climbTree(visitor, pos, childIndex);
-        } else {
-            climbTree(visitor, pos, childIndex + 1);
-        }
-        break;
-    case Node::Type::HORIZONTAL:
-        if (pos.y() < node->offset) {
-            climbTree(visitor, pos, childIndex);
-        } else {
-            climbTree(visitor, pos, childIndex + 1);
-        }
-        break;
-    }
-}
-
-//---------------------------------------------------------
-//   climbTree
-//---------------------------------------------------------
-
-void BspTree::climbTree(BspTreeVisitor* visitor, const mu::RectF& rec, int index)
-{
-    if (nodes.empty()) {
-        return;
-    }
-
-    Node* node = &nodes[index];
-    int childIndex = firstChildIndex(index);
-
-    switch (node->type) {
-    case Node::Type::LEAF:
-        visitor->visit(&leaves[node->leafIndex]);
-        break;
-    case Node::Type::VERTICAL:
-        if (rec.left() < node->offset) {
-            climbTree(visitor, rec, childIndex);
-            if (rec.right() >= node->offset) {
-                climbTree(visitor, rec, childIndex + 1);
-            }
-        } else {
-            climbTree(visitor, rec, childIndex + 1);
-        }
-        break;
-    case Node::Type::HORIZONTAL:
-        if (rec.top() < node->offset) {
-            climbTree(visitor, rec, childIndex);
-            if (rec.bottom() >= node->offset) {
-                climbTree(visitor, rec, childIndex + 1);
-            }
-        } else {
-            climbTree(visitor, rec, childIndex + 1);
-        }
-    }
-}
-
 //---------------------------------------------------------
 //   rectForIndex
 //---------------------------------------------------------
@@ -23,23 +23,25 @@
 #ifndef __BSP_H__
 #define __BSP_H__
 
-#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
-#include "global/allocator.h"
 #include "types/string.h"
 #include "draw/types/geometry.h"
 
 namespace mu::engraving {
-class BspTreeVisitor;
-class InsertItemBspTreeVisitor;
-class RemoveItemBspTreeVisitor;
-class FindItemBspTreeVisitor;
-
 class EngravingItem;
 
 //---------------------------------------------------------
 //   BspTree
 //    binary space partitioning
+//
+//    Items are kept in a flat entry table together with the
+//    page rectangle they were inserted with; leaves only hold
+//    indices into that table. This allows to move or remove a
+//    single item without rebuilding the tree and to answer
+//    queries from contiguous memory.
 //---------------------------------------------------------
 
 class BspTree
@@ -55,21 +57,49 @@ public:
         };
         Type type;
     };
+
 private:
+    using EntryIndex = uint32_t;
+
+    struct Entry {
+        EngravingItem* item = nullptr;
+        mu::RectF rect;                 // page bounding rect at the time of insertion
+        uint32_t queryStamp = 0;
+        uint32_t syncStamp = 0;
+    };
+
     unsigned int depth;
     void initialize(const mu::RectF& rect, int depth, int index);
-    void climbTree(BspTreeVisitor* visitor, const mu::PointF& pos, int index = 0);
-    void climbTree(BspTreeVisitor* visitor, const mu::RectF& rect, int index = 0);
 
-    void findItems(std::list<EngravingItem*>* foundItems, const mu::RectF& rect, int index);
-    void findItems(std::list<EngravingItem*>* foundItems, const mu::PointF& pos, int index);
+    template<typename Visitor>
+    void climbTree(const Visitor& visitor, const mu::PointF& pos, int index = 0);
+    template<typename Visitor>
+    void climbTree(const Visitor& visitor, const mu::RectF& rect, int index = 0);
+
     mu::RectF rectForIndex(int index) const;
 
+    void logChange(const mu::RectF& r);
+    void insertEntry(EntryIndex idx);
+    void removeEntry(EntryIndex idx);
+    void findItems(std::vector<EngravingItem*>& result, const mu::RectF& rect);
+    uint32_t nextQueryStamp();
+
     std::vector<Node> nodes;
-    std::vector<std::list<EngravingItem*> > leaves;
+    std::vector<std::vector<EntryIndex> > leaves;
     int leafCnt;
     mu::RectF rect;
 
+    std::vector<Entry> m_entries;
+    std::vector<EntryIndex> m_freeEntries;
+    std::unordered_map<const EngravingItem*, EntryIndex> m_entryIndexes;
+    uint32_t m_queryStamp = 0;
+    uint32_t m_syncStamp = 0;
+    bool m_syncing = false;
+
+    std::vector<std::pair<uint64_t, mu::RectF> > m_changeLog;
+    uint64_t m_revision = 0;
+    uint64_t m_logStartRevision = 0;
+
 public:
     BspTree();
 
@@ -78,8 +108,30 @@ public:
 
     void insert(EngravingItem* item);
     void remove(EngravingItem* item);
+    void update(EngravingItem* item);
+    bool contains(const EngravingItem* item) const;
+
+    // Incremental synchronization: every item that is still present
+    // has to be passed to update() between beginSync() and endSync(),
+    // endSync() removes all the items which were not seen.
+    void beginSync();
+    void endSync();
+
+    // Every change made by update(), remove() or a sync is logged
+    // with the page rect it affects and gets a new revision number.
+    // changedAreasSince() returns false if the changes since the
+    // given revision are not known (the tree was rebuilt, or the
+    // log was trimmed), everything has to be assumed changed then.
+    uint64_t revision() const { return m_revision; }
+    bool changedAreasSince(uint64_t revision, std::vector<mu::RectF>& areas) const;
+
+    bool isInitialized() const { return !nodes.empty(); }
+    bool needsRebalance() const;
+    const mu::RectF& bounds() const { return rect; }
+    size_t itemCount() const { return m_entryIndexes.size(); }
 
     std::vector<EngravingItem*> items(const mu::RectF& rect);
+    std::vector<EngravingItem*> items(const std::vector<mu::RectF>& rects);
     std::vector<EngravingItem*> items(const mu::PointF& pos);
 
     int leafCount() const { return leafCnt; }
@@ -94,17 +146,5 @@ public:
     String debug(int index) const;
 #endif
 };
-
-//---------------------------------------------------------
-//   BspTreeVisitor
-//---------------------------------------------------------
-
-class BspTreeVisitor
-{
-    OBJECT_ALLOCATOR(engraving, BspTreeVisitor)
-public:
-    virtual ~BspTreeVisitor() {}
-    virtual void visit(std::list<EngravingItem*>* items) = 0;
-};
 } // namespace mu::engraving
 #endif
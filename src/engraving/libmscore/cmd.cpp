@@ -426,6 +426,9 @@ void Score::update(bool resetCmdState, bool layoutAllParts)
         ms->deletePostponed();
 
         if (cs.layoutRange()) {
+            //! NOTE The open scores are laid out one after another, not concurrently.
+            //! Layout pushes undo commands onto the undo stack of the master score and changes the elements
+            //! linked to other scores (undoChangeProperty, undoAddElement, the links of mm-rest barlines)
             for (Score* s : ms->scoreList()) {
                 if (s != this && !s->isOpen() && ms->scoreList().size() > 1 && !layoutAllParts) {
                     continue;
@@ -141,6 +141,8 @@ public:
 
     int no() const { return _no; }
     void setNo(int n) { _no = n; }
+    size_t layoutRevision() const { return _layoutRevision; }
+    void incLayoutRevision() { ++_layoutRevision; }
     int noOffset() const { return _noOffset; }
     void setNoOffset(int n) { _noOffset = n; }
 
@@ -196,6 +198,7 @@ private:
     int _no                { 0 };         ///< Measure number, counting from zero
     int _noOffset          { 0 };         ///< Offset to measure number
     double m_oldWidth       { 0 };         ///< Used to restore layout during recalculations in Score::collectSystem()
+    size_t _layoutRevision { 0 };         ///< Incremented each time the measure is laid out again
 };
 } // namespace mu::engraving
 #endif
@@ -43,6 +43,8 @@ bool MScore::noHorizontalStretch = false;
 bool MScore::noVerticalStretch   = false;
 bool MScore::useFallbackFont     = true;
 // #endif
+bool MScore::useFlatSkylines     = false;
+bool MScore::useParallelLayout   = true;
 
 bool MScore::saveTemplateMode = false;
 bool MScore::noGui = false;
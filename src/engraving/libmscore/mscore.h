@@ -211,6 +211,8 @@ public:
     static bool noVerticalStretch;
     static bool useFallbackFont;
 // #endif
+    static bool useFlatSkylines;          // keep structure-of-arrays skylines and use them in SkylineLine::minDistance()
+    static bool useParallelLayout;        // lay out the measures and staves of a system concurrently on a full relayout
     static bool debugMode;
     static bool testMode;
     static bool testWriteStyleToScore;
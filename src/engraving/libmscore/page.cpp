@@ -61,19 +61,60 @@ Page::Page(RootItem* parent)
 std::vector<EngravingItem*> Page::items(const RectF& rect)
 {
     if (!bspTreeValid) {
-        doRebuildBspTree();
+        doUpdateBspTree();
     }
     return bspTree.items(rect);
 }
 
+//---------------------------------------------------------
+//   items
+//    batched query, every item is reported once
+//---------------------------------------------------------
+
+std::vector<EngravingItem*> Page::items(const std::vector<RectF>& rects)
+{
+    if (!bspTreeValid) {
+        doUpdateBspTree();
+    }
+    return bspTree.items(rects);
+}
+
 std::vector<EngravingItem*> Page::items(const mu::PointF& point)
 {
     if (!bspTreeValid) {
-        doRebuildBspTree();
+        doUpdateBspTree();
     }
     return bspTree.items(point);
 }
 
+//---------------------------------------------------------
+//   itemsRevision
+//    revision of the spatial index, changes whenever an
+//    item of the page was added, moved or removed
+//---------------------------------------------------------
+
+uint64_t Page::itemsRevision()
+{
+    if (!bspTreeValid) {
+        doUpdateBspTree();
+    }
+    return bspTree.revision();
+}
+
+//---------------------------------------------------------
+//   changedAreasSince
+//    page rects affected by the item changes made after the
+//    given revision; returns false if they are not known
+//---------------------------------------------------------
+
+bool Page::changedAreasSince(uint64_t revision, std::vector<RectF>& areas)
+{
+    if (!bspTreeValid) {
+        doUpdateBspTree();
+    }
+    return bspTree.changedAreasSince(revision, areas);
+}
+
 //---------------------------------------------------------
 //   appendSystem
 //---------------------------------------------------------
@@ -333,15 +374,20 @@ static void countElements(void* data, EngravingItem* /*e*/)
 }
 
 //---------------------------------------------------------
-//   doRebuildBspTree
+//   bspUpdate
 //---------------------------------------------------------
 
-void Page::doRebuildBspTree()
+static void bspUpdate(void* bspTree, EngravingItem* e)
 {
-    int n = 0;
-    scanElements(&n, countElements, false);
+    ((BspTree*)bspTree)->update(e);
+}
+
+//---------------------------------------------------------
+//   bspTreeRect
+//---------------------------------------------------------
 
-    RectF r;
+RectF Page::bspTreeRect() const
+{
     if (score()->linearMode()) {
         double w = 0.0;
         double h = 0.0;
@@ -352,16 +398,51 @@ void Page::doRebuildBspTree()
                 w = mb->x() + mb->width();
             }
         }
-        r = RectF(0.0, 0.0, w, h);
-    } else {
-        r = abbox();
+        return RectF(0.0, 0.0, w, h);
     }
+    return abbox();
+}
+
+//---------------------------------------------------------
+//   doRebuildBspTree
+//---------------------------------------------------------
+
+void Page::doRebuildBspTree()
+{
+    int n = 0;
+    scanElements(&n, countElements, false);
 
-    bspTree.initialize(r, n);
+    bspTree.initialize(bspTreeRect(), n);
     scanElements(&bspTree, &bspInsert, false);
     bspTreeValid = true;
 }
 
+//---------------------------------------------------------
+//   doUpdateBspTree
+//    Only the items which were added, moved or removed since
+//    the last update are touched. The tree is rebuilt from
+//    scratch if the page area has changed or the tree became
+//    too shallow for the number of items.
+//---------------------------------------------------------
+
+void Page::doUpdateBspTree()
+{
+    if (!bspTree.isInitialized() || bspTree.bounds() != bspTreeRect()) {
+        doRebuildBspTree();
+        return;
+    }
+
+    bspTree.beginSync();
+    scanElements(&bspTree, &bspUpdate, false);
+    bspTree.endSync();
+
+    if (bspTree.needsRebalance()) {
+        doRebuildBspTree();
+        return;
+    }
+    bspTreeValid = true;
+}
+
 //---------------------------------------------------------
 //   replaceTextMacros
 //   (keep in sync with toolTipHeaderFooter in EditStyle::EditStyle())
@@ -54,7 +54,9 @@ class Page final : public EngravingItem
     BspTree bspTree;
     bool bspTreeValid;
 
+    mu::RectF bspTreeRect() const;
     void doRebuildBspTree();
+    void doUpdateBspTree();
 
     friend class Factory;
     Page(RootItem* parent);
@@ -89,8 +91,11 @@ public:
     void scanElements(void* data, void (* func)(void*, EngravingItem*), bool all=true) override;
 
     std::vector<EngravingItem*> items(const mu::RectF& r);
+    std::vector<EngravingItem*> items(const std::vector<mu::RectF>& rects);
     std::vector<EngravingItem*> items(const mu::PointF& p);
     void invalidateBspTree() { bspTreeValid = false; }
+    uint64_t itemsRevision();
+    bool changedAreasSince(uint64_t revision, std::vector<mu::RectF>& areas);
     mu::PointF pagePos() const override { return mu::PointF(); }       ///< position in page coordinates
     std::vector<EngravingItem*> elements() const;              ///< list of visible elements
     mu::RectF tbbox();                             // tight bounding box, excluding white space
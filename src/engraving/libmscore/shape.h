@@ -26,6 +26,8 @@
 #include "global/allocator.h"
 #include "draw/types/geometry.h"
 
+#include "../infrastructure/smallvector.h"
+
 namespace mu::draw {
 class Painter;
 }
@@ -53,9 +55,14 @@ public:
 
 //---------------------------------------------------------
 //   Shape
+//    Most shapes consist of a single rectangle, it is kept
+//    in place to avoid an allocation. A bigger inline buffer
+//    would grow every stored shape (segments keep one per staff).
 //---------------------------------------------------------
 
-class Shape : public std::vector<ShapeElement>
+static constexpr size_t SHAPE_INLINE_CAPACITY = 1;
+
+class Shape : public SmallVector<ShapeElement, SHAPE_INLINE_CAPACITY>
 {
     OBJECT_ALLOCATOR(engraving, Shape)
 private:
@@ -95,9 +102,9 @@ public:
     double top() const;
     double bottom() const;
 
-    size_t size() const { return std::vector<ShapeElement>::size(); }
-    bool empty() const { return std::vector<ShapeElement>::empty(); }
-    void clear() { std::vector<ShapeElement>::clear(); }
+    size_t size() const { return SmallVector::size(); }
+    bool empty() const { return SmallVector::empty(); }
+    void clear() { SmallVector::clear(); }
 
     bool contains(const mu::PointF&) const;
     bool intersects(const mu::RectF& rr) const;
@@ -30,6 +30,7 @@
 
 #include "draw/painter.h"
 
+#include "mscore.h"
 #include "shape.h"
 
 #include "realfn.h"
@@ -97,10 +98,10 @@ void Skyline::add(const ShapeElement& r)
         }
     }
     if (!crossNorth) {
-        _north.add(r.x(), r.top(), r.width());
+        _north.addSegment(r.x(), r.top(), r.width());
     }
     if (!crossSouth) {
-        _south.add(r.x(), r.bottom(), r.width());
+        _south.addSegment(r.x(), r.bottom(), r.width());
     }
 }
 
@@ -146,36 +147,69 @@ SkylineLine::SegConstIter SkylineLine::find(double x) const
     return const_cast<SkylineLine*>(this)->find(x);
 }
 
+//---------------------------------------------------------
+//   reserve
+//    Adding a shape element splits at most one segment and
+//    inserts one, keep the growth geometric though.
+//---------------------------------------------------------
+
+void SkylineLine::reserve(size_t additionalSegments)
+{
+    const size_t needed = seg.size() + 2 * additionalSegments;
+    if (seg.capacity() < needed) {
+        seg.reserve(std::max(needed, 2 * seg.capacity()));
+    }
+}
+
 //---------------------------------------------------------
 //   add
 //---------------------------------------------------------
 
 void SkylineLine::add(const Shape& s)
 {
-    for (const auto& r : s) {
-        add(r);
+    reserve(s.size());
+    if (north) {
+        for (const ShapeElement& r : s) {
+            addSegment(r.x(), r.top(), r.width());
+        }
+    } else {
+        for (const ShapeElement& r : s) {
+            addSegment(r.x(), r.bottom(), r.width());
+        }
     }
 }
 
 void SkylineLine::add(const ShapeElement& r)
 {
     if (north) {
-        add(r.x(), r.top(), r.width());
+        addSegment(r.x(), r.top(), r.width());
     } else {
-        add(r.x(), r.bottom(), r.width());
+        addSegment(r.x(), r.bottom(), r.width());
     }
 }
 
 void Skyline::add(const Shape& s)
 {
+    _north.reserve(s.size());
+    _south.reserve(s.size());
     for (const auto& r : s) {
         add(r);
     }
 }
 
 void SkylineLine::add(double x, double y, double w)
+{
+    addSegment(x, y, w);
+}
+
+//---------------------------------------------------------
+//   addSegment
+//---------------------------------------------------------
+
+void SkylineLine::addSegment(double x, double y, double w)
 {
 //      assert(w >= 0.0);
+    flatDirty = true;
     if (x < 0.0) {
         w -= -x;
         x = 0.0;
@@ -261,12 +295,28 @@ void SkylineLine::add(double x, double y, double w)
 //   clear
 //---------------------------------------------------------
 
+void SkylineLine::clear()
+{
+    seg.clear();
+    flatDirty = true;
+}
+
 void Skyline::clear()
 {
     _north.clear();
     _south.clear();
 }
 
+//---------------------------------------------------------
+//   buildFlat
+//---------------------------------------------------------
+
+void Skyline::buildFlat()
+{
+    _north.buildFlat();
+    _south.buildFlat();
+}
+
 //-------------------------------------------------------------------
 //   minDistance
 //    a is located below this skyline.
@@ -279,6 +329,18 @@ double Skyline::minDistance(const Skyline& s) const
 }
 
 double SkylineLine::minDistance(const SkylineLine& sl) const
+{
+    if (MScore::useFlatSkylines && !flatDirty && !sl.flatDirty) {
+        return flatMinDistance(sl);
+    }
+    return segmentMinDistance(sl);
+}
+
+//---------------------------------------------------------
+//   segmentMinDistance
+//---------------------------------------------------------
+
+double SkylineLine::segmentMinDistance(const SkylineLine& sl) const
 {
     double dist = MINIMUM_Y;
 
@@ -315,6 +377,88 @@ double SkylineLine::minDistance(const SkylineLine& sl) const
     return dist;
 }
 
+//---------------------------------------------------------
+//   buildFlat
+//    the changes of the line are not followed, so that
+//    a line built element by element is copied once
+//---------------------------------------------------------
+
+void SkylineLine::buildFlat()
+{
+    if (!MScore::useFlatSkylines || !flatDirty) {
+        return;
+    }
+
+    const size_t n = seg.size();
+    flatSeg.start.resize(n);
+    flatSeg.end.resize(n);
+    flatSeg.y.resize(n);
+
+    // positions are accumulated exactly like in segmentMinDistance()
+    double x = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const SkylineSegment& s = seg[i];
+        flatSeg.start[i] = x;
+        flatSeg.end[i] = x + s.w;
+        flatSeg.y[i] = s.y;
+        x += s.w;
+    }
+    flatDirty = false;
+}
+
+//---------------------------------------------------------
+//   flatMinDistance
+//    Same result as segmentMinDistance(): for every segment
+//    of this line the overlapping range of sl is located
+//    first, then the distance is reduced over that range
+//    without branches on contiguous arrays, which the
+//    compiler can vectorize.
+//---------------------------------------------------------
+
+double SkylineLine::flatMinDistance(const SkylineLine& sl) const
+{
+    const FlatLine& a = flatSeg;
+    const FlatLine& b = sl.flatSeg;
+    const size_t na = a.y.size();
+    const size_t nb = b.y.size();
+
+    const double* bStart = b.start.data();
+    const double* bEnd = b.end.data();
+    const double* bY = b.y.data();
+
+    double dist = MINIMUM_Y;
+    size_t k = 0;
+    for (size_t i = 0; i < na; ++i) {
+        const double x1 = a.start[i];
+        const double x1End = a.end[i];
+
+        while (k < nb && bEnd[k] < x1) {
+            ++k;
+        }
+        if (k == nb) {
+            break;
+        }
+
+        size_t last = k;
+        while (last < nb && bEnd[last] < x1End) {
+            ++last;
+        }
+        const size_t rangeEnd = std::min(last + 1, nb);
+
+        const double y = a.y[i];
+        for (size_t m = k; m < rangeEnd; ++m) {
+            const bool overlap = (x1End > bStart[m]) & (x1 < bEnd[m]);
+            dist = std::max(dist, overlap ? y - bY[m] : MINIMUM_Y);
+        }
+
+        if (last == nb) {
+            break;
+        }
+        k = last;
+    }
+    return dist;
+}
+
 void Skyline::paint(Painter& painter, double lineWidth) const
 {
     painter.save();
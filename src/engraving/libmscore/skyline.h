@@ -54,15 +54,39 @@ struct SkylineSegment {
 
 class SkylineLine
 {
+    //---------------------------------------------------------
+    //   FlatLine
+    //    structure-of-arrays copy of the segments with their
+    //    accumulated start and end positions, used by the flat
+    //    minDistance() kernel. It is built by buildFlat() once
+    //    the line is complete, a change of the line makes it
+    //    outdated until the next build
+    //---------------------------------------------------------
+
+    struct FlatLine {
+        std::vector<double> start;
+        std::vector<double> end;
+        std::vector<double> y;
+    };
+
     const bool north;
     std::vector<SkylineSegment> seg;
+    FlatLine flatSeg;
+    bool flatDirty = true;
     typedef std::vector<SkylineSegment>::iterator SegIter;
     typedef std::vector<SkylineSegment>::const_iterator SegConstIter;
 
+    friend class Skyline;
+
     SegIter insert(SegIter i, double x, double y, double w);
     void append(double x, double y, double w);
     SegIter find(double x);
     SegConstIter find(double x) const;
+    void reserve(size_t additionalSegments);
+    void addSegment(double x, double y, double w);
+
+    double segmentMinDistance(const SkylineLine&) const;
+    double flatMinDistance(const SkylineLine&) const;
 
 public:
     SkylineLine(bool n)
@@ -72,7 +96,8 @@ public:
     void add(double x, double y, double w);
     void add(const RectF& r) { add(ShapeElement(r)); }
 
-    void clear() { seg.clear(); }
+    void clear();
+    void buildFlat();
     void paint(mu::draw::Painter& painter) const;
     void dump() const;
     double minDistance(const SkylineLine&) const;
@@ -81,9 +106,7 @@ public:
     bool valid(const SkylineSegment& s) const;
     bool isNorth() const { return north; }
 
-    SegIter begin() { return seg.begin(); }
     SegConstIter begin() const { return seg.begin(); }
-    SegIter end() { return seg.end(); }
     SegConstIter end() const { return seg.end(); }
 };
 
@@ -104,6 +127,7 @@ public:
     void add(const Shape& s);
     void add(const ShapeElement& r);
     void add(const RectF& r) { add(ShapeElement(r)); }
+    void buildFlat();
 
     double minDistance(const Skyline&) const;
 
@@ -377,7 +377,7 @@ Shape SlurSegment::getSegmentShape(Segment* seg, ChordRest* startCR, ChordRest*
         segShape.add(secondStaffShape);
     }
     // Remove items that the slur shouldn't try to avoid
-    mu::remove_if(segShape, [&](ShapeElement& shapeEl) {
+    segShape.remove_if([&](ShapeElement& shapeEl) {
         if (!shapeEl.toItem || !shapeEl.toItem->parentItem()) {
             return true;
         }
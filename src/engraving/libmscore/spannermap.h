@@ -38,7 +38,6 @@ class SpannerMap : std::multimap<int, Spanner*>
     mutable bool dirty;
     mutable interval_tree::IntervalTree<Spanner*> tree;
     mutable interval_tree::IntervalTree<Spanner*> collisionFreeTree;
-    mutable std::vector<interval_tree::Interval<Spanner*> > results;
 
 public:
     typedef typename std::multimap<int, Spanner*>::const_reverse_iterator const_reverse_it;
@@ -48,8 +47,9 @@ public:
 
     SpannerMap();
 
-    const IntervalList& findContained(int start, int stop, bool excludeCollisions = false) const;
-    const IntervalList& findOverlapping(int start, int stop, bool excludeCollisions = false) const;
+    //! NOTE The results are returned by value, so that an up to date map can be queried from several threads
+    IntervalList findContained(int start, int stop, bool excludeCollisions = false) const;
+    IntervalList findOverlapping(int start, int stop, bool excludeCollisions = false) const;
     const std::multimap<int, Spanner*>& map() const { return *this; }
 
     void collectIntervals(IntervalList& regularIntervals, IntervalList& collisionFreeIntervals) const;
@@ -166,6 +166,7 @@ void System::clear()
         }
     }
     _spannerSegments.clear();
+    _layoutFingerprint = 0;
     // _systemDividers are reused
 }
 
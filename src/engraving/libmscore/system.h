@@ -185,6 +185,11 @@ public:
     double distance() const { return _distance; }
     void setDistance(double d) { _distance = d; }
 
+    size_t layoutFingerprint() const { return _layoutFingerprint; }
+    void setLayoutFingerprint(size_t fingerprint) { _layoutFingerprint = fingerprint; }
+    double unstretchedY() const { return _unstretchedY; }
+    void setUnstretchedY(double y) { _unstretchedY = y; }
+
     staff_idx_t firstSysStaffOfPart(const Part* part) const;
     staff_idx_t firstVisibleSysStaffOfPart(const Part* part) const;
     staff_idx_t lastSysStaffOfPart(const Part* part) const;
@@ -225,6 +230,8 @@ private:
     mutable bool fixedDownDistance { false };
     double _distance                { 0.0 };     /// temp. variable used during layout
     double _systemHeight            { 0.0 };
+    size_t _layoutFingerprint       { 0 };       /// inputs of the last page layout, 0 if it has to be redone
+    double _unstretchedY            { 0.0 };     /// position on the page before the vertical justification
 };
 
 typedef std::vector<System*>::iterator iSystem;
@@ -2530,8 +2530,9 @@ bool TextBase::validateText(String& s)
     String ss = u"<data>" + d + u"</data>\n";
     ByteArray ba = ss.toUtf8();
     XmlReader xml(ba);
-    while (xml.readNextStartElement()) {
-        // LOGD("  token %d <%s>", int(xml.tokenType()), muPrintable(xml.name().toString()));
+    //! NOTE The errors are found while reading, so the whole text is read
+    while (!xml.atEnd()) {
+        xml.readNext();
     }
     if (xml.error() == XmlReader::NoError) {
         s = d;
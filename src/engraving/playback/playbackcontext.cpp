@@ -39,6 +39,24 @@
 using namespace mu::engraving;
 using namespace mu::mpe;
 
+template<typename T>
+static bool hasEqualEntries(const std::map<int, T>& map, const std::map<int, T>& otherMap, const int positionTickFrom,
+                            const int positionTickTo, const int otherPositionTickOffset)
+{
+    auto it = map.lower_bound(positionTickFrom);
+    auto end = map.lower_bound(positionTickTo);
+    auto otherIt = otherMap.lower_bound(positionTickFrom + otherPositionTickOffset);
+    auto otherEnd = otherMap.lower_bound(positionTickTo + otherPositionTickOffset);
+
+    for (; it != end && otherIt != otherEnd; ++it, ++otherIt) {
+        if (it->first + otherPositionTickOffset != otherIt->first || it->second != otherIt->second) {
+            return false;
+        }
+    }
+
+    return it == end && otherIt == otherEnd;
+}
+
 dynamic_level_t PlaybackContext::appliableDynamicLevel(const int nominalPositionTick) const
 {
     auto it = findLessOrEqual(m_dynamicsMap, nominalPositionTick);
@@ -98,6 +116,21 @@ DynamicLevelMap PlaybackContext::dynamicLevelMap(const Score* score) const
     return result;
 }
 
+bool PlaybackContext::hasEqualData(const PlaybackContext& other, const int positionTickFrom, const int positionTickTo,
+                                   const int otherPositionTickOffset) const
+{
+    const int otherPositionTickFrom = positionTickFrom + otherPositionTickOffset;
+
+    if (appliableDynamicLevel(positionTickFrom) != other.appliableDynamicLevel(otherPositionTickFrom)
+        || persistentArticulationType(positionTickFrom) != other.persistentArticulationType(otherPositionTickFrom)) {
+        return false;
+    }
+
+    return hasEqualEntries(m_dynamicsMap, other.m_dynamicsMap, positionTickFrom, positionTickTo, otherPositionTickOffset)
+           && hasEqualEntries(m_playTechniquesMap, other.m_playTechniquesMap, positionTickFrom, positionTickTo,
+                              otherPositionTickOffset);
+}
+
 dynamic_level_t PlaybackContext::nominalDynamicLevel(const int positionTick) const
 {
     auto search = m_dynamicsMap.find(positionTick);
@@ -47,6 +47,9 @@ public:
 
     mpe::DynamicLevelMap dynamicLevelMap(const Score* score) const;
 
+    bool hasEqualData(const PlaybackContext& other, const int positionTickFrom, const int positionTickTo,
+                      const int otherPositionTickOffset) const;
+
 private:
     mpe::dynamic_level_t nominalDynamicLevel(const int positionTick) const;
 
@@ -22,6 +22,9 @@
 
 #include "playbackmodel.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "libmscore/fret.h"
 #include "libmscore/instrument.h"
 #include "libmscore/masterscore.h"
@@ -32,6 +35,9 @@
 #include "libmscore/segment.h"
 #include "libmscore/tempo.h"
 
+#include "async/async.h"
+#include "concurrency/taskscheduler.h"
+#include "realfn.h"
 #include "log.h"
 
 using namespace mu;
@@ -44,6 +50,15 @@ static const std::string CHORD_SYMBOLS_INSTRUMENT_ID("chord_symbols");
 
 const InstrumentTrackId PlaybackModel::METRONOME_TRACK_ID = { 999, METRONOME_INSTRUMENT_ID };
 
+//! NOTE Rounding of the timestamps and durations may make an event look like it ends slightly
+//! after the end of its piece of the timeline, which shouldn't make it be rendered again
+static constexpr timestamp_t TIMESTAMP_ROUNDING_TOLERANCE = 1000;
+
+//! NOTE Scores up to this size are rendered at once, the bigger ones are rendered
+//! window by window, starting from the playback position
+static constexpr size_t SYNC_RENDERING_MEASURES_LIMIT = 64;
+static constexpr size_t RENDERING_WINDOW_MEASURES_COUNT = 16;
+
 static const Harmony* findChordSymbol(const EngravingItem* item)
 {
     if (item->isHarmony()) {
@@ -55,6 +70,98 @@ static const Harmony* findChordSymbol(const EngravingItem* item)
     return nullptr;
 }
 
+static bool isSameTempoEvent(const TEvent& event, const TEvent& other)
+{
+    //! NOTE The precomputed time is not compared, it only reflects the changes before the event
+    return event.type == other.type
+           && event.tempo == other.tempo
+           && RealIsEqual(event.pause, other.pause);
+}
+
+static bool isSameTempoMap(const TempoMap& tempoMap, const TempoMap& other)
+{
+    if (tempoMap.size() != other.size() || tempoMap.tempoMultiplier() != other.tempoMultiplier()) {
+        return false;
+    }
+
+    for (auto it = tempoMap.cbegin(), otherIt = other.cbegin(); it != tempoMap.cend(); ++it, ++otherIt) {
+        if (it->first != otherIt->first || !isSameTempoEvent(it->second, otherIt->second)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//! NOTE Collects the tick ranges where the tempo itself has been changed (the events there
+//! have to be rendered again) and the ticks after which the events are moved by a different offset
+static void collectTempoChanges(const TempoMap& oldTempoMap, const TempoMap& tempoMap,
+                                std::vector<std::pair<int, int> >& dirtyTickRanges, std::set<int>& splitTicks)
+{
+    if (oldTempoMap.tempoMultiplier() != tempoMap.tempoMultiplier()) {
+        dirtyTickRanges.emplace_back(0, std::numeric_limits<int>::max());
+        return;
+    }
+
+    std::set<int> ticks;
+
+    for (const auto& pair : oldTempoMap) {
+        ticks.insert(pair.first);
+    }
+
+    for (const auto& pair : tempoMap) {
+        ticks.insert(pair.first);
+    }
+
+    for (auto it = ticks.cbegin(); it != ticks.cend(); ++it) {
+        int tick = *it;
+
+        auto oldEvent = oldTempoMap.find(tick);
+        auto event = tempoMap.find(tick);
+
+        if (oldEvent != oldTempoMap.cend() && event != tempoMap.cend() && isSameTempoEvent(oldEvent->second, event->second)) {
+            continue;
+        }
+
+        splitTicks.insert(tick);
+
+        if (oldTempoMap.tempo(tick) == tempoMap.tempo(tick)) {
+            continue;
+        }
+
+        auto next = std::next(it);
+        dirtyTickRanges.emplace_back(tick, next != ticks.cend() ? *next : std::numeric_limits<int>::max());
+    }
+}
+
+static std::string memoryUsageInfo(const PlaybackEventsMap& events)
+{
+    PlaybackEventsMemoryUsage usage = memoryUsage(events);
+
+    return std::to_string(usage.eventsCount) + " events at " + std::to_string(usage.timestampsCount) + " timestamps, "
+           + std::to_string(usage.eventsBytes / 1024) + " KB of events, "
+           + std::to_string(usage.sharedDataBytes / 1024) + " KB of curves and articulations";
+}
+
+static bool isEventWithinRange(const PlaybackEvent& event, const timestamp_t timestampFrom, const timestamp_t timestampTo)
+{
+    const NoteEvent* noteEvent = std::get_if<NoteEvent>(&event);
+    if (!noteEvent) {
+        return true;
+    }
+
+    for (const auto& pair : noteEvent->expressionCtx().articulations) {
+        const ArticulationMeta& meta = pair.second.meta;
+
+        if (meta.timestamp < timestampFrom
+            || meta.timestamp + meta.overallDuration - TIMESTAMP_ROUNDING_TOLERANCE > timestampTo) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void PlaybackModel::load(Score* score)
 {
     if (!score || score->measures()->empty() || !score->lastMeasure()) {
@@ -71,18 +178,38 @@ void PlaybackModel::load(Score* score)
         TrackBoundaries trackRange = trackBoundaries(range);
 
         clearExpiredTracks();
-        clearExpiredContexts(trackRange.trackFrom, trackRange.trackTo);
-        clearExpiredEvents(tickRange.tickFrom, tickRange.tickTo, trackRange.trackFrom, trackRange.trackTo);
 
         InstrumentTrackIdSet oldTracks = existingTrackIdSet();
-
         ChangedTrackIdSet trackChanges;
+
+        bool isWholeScoreChanged = tickRange.tickFrom == 0
+                                   && tickRange.tickTo == m_score->lastMeasure()->endTick().ticks()
+                                   && trackRange.trackFrom == 0
+                                   && trackRange.trackTo == m_score->ntracks();
+
+        if (isWholeScoreChanged) {
+            cancelRendering();
+        }
+
+        //! NOTE Tempo and repeat changes move the events in time, but usually don't change them,
+        //! so the events rendered before the change are reused wherever it is possible
+        if (!isWholeScoreChanged && isTimelineChanged()) {
+            remapTimeline(&trackChanges);
+        }
+
+        clearExpiredContexts(trackRange.trackFrom, trackRange.trackTo);
+        clearExpiredEvents(tickRange.tickFrom, tickRange.tickTo, trackRange.trackFrom, trackRange.trackTo);
+
         update(tickRange.tickFrom, tickRange.tickTo, trackRange.trackFrom, trackRange.trackTo, &trackChanges);
 
         notifyAboutChanges(oldTracks, trackChanges);
+        takeTimelineSnapshot();
     });
 
-    update(0, m_score->lastMeasure()->endTick().ticks(), 0, m_score->ntracks());
+    updateSetupData();
+    updateContext(0, m_score->ntracks());
+    takeTimelineSnapshot();
+    startRendering();
 
     for (const auto& pair : m_playbackDataMap) {
         m_trackAdded.send(pair.first);
@@ -93,13 +220,12 @@ void PlaybackModel::load(Score* score)
 
 void PlaybackModel::reload()
 {
-    int trackFrom = 0;
-    size_t trackTo = m_score->ntracks();
-
-    const Measure* lastMeasure = m_score->lastMeasure();
+    if (!m_score || !m_score->lastMeasure()) {
+        return;
+    }
 
-    int tickFrom = 0;
-    int tickTo = lastMeasure ? lastMeasure->endTick().ticks() : 0;
+    track_idx_t trackFrom = 0;
+    track_idx_t trackTo = m_score->ntracks();
 
     clearExpiredTracks();
     clearExpiredContexts(trackFrom, trackTo);
@@ -108,13 +234,12 @@ void PlaybackModel::reload()
         pair.second.originEvents.clear();
     }
 
-    update(tickFrom, tickTo, trackFrom, trackTo);
-
-    for (auto& pair : m_playbackDataMap) {
-        pair.second.mainStream.send(pair.second.originEvents);
-    }
+    updateSetupData();
+    updateContext(trackFrom, trackTo);
+    takeTimelineSnapshot();
+    startRendering();
 
-    m_dataChanged.notify();
+    notifyAboutRenderedEvents();
 }
 
 Notification PlaybackModel::dataChanged() const
@@ -217,11 +342,15 @@ void PlaybackModel::triggerEventsForItems(const std::vector<const EngravingItem*
             continue;
         }
 
+        auto ctx = m_playbackCtxMap.find(trackId);
+        if (ctx == m_playbackCtxMap.cend()) {
+            continue;
+        }
+
         int utick = repeatList().tick2utick(item->tick().ticks());
-        const PlaybackContext& ctx = m_playbackCtxMap[trackId];
 
-        m_renderer.render(item, actualTimestamp, actualDuration, actualDynamicLevel, ctx.persistentArticulationType(utick), profile,
-                          result);
+        m_renderer.render(item, actualTimestamp, actualDuration, actualDynamicLevel, ctx->second.persistentArticulationType(utick),
+                          profile, result);
     }
 
     trackPlaybackData->second.offStream.send(std::move(result));
@@ -239,6 +368,11 @@ void PlaybackModel::triggerMetronome(int tick)
     trackPlaybackData->second.offStream.send(std::move(result));
 }
 
+void PlaybackModel::setPlaybackPositionTick(const int tick)
+{
+    m_playbackPositionTick = tick;
+}
+
 InstrumentTrackIdSet PlaybackModel::existingTrackIdSet() const
 {
     InstrumentTrackIdSet result;
@@ -338,6 +472,12 @@ void PlaybackModel::processSegment(const int tickPositionOffset, const Segment*
 
         InstrumentTrackId trackId = chordSymbolsTrackId(item->part()->id());
 
+        //! NOTE Runs concurrently for different parts, so the maps are only looked up here, never changed
+        auto trackData = m_playbackDataMap.find(trackId);
+        if (trackData == m_playbackDataMap.end()) {
+            continue;
+        }
+
         ArticulationsProfilePtr profile = defaultActiculationProfile(trackId);
         if (!profile) {
             LOGE() << "unsupported instrument family: " << item->part()->id();
@@ -345,8 +485,7 @@ void PlaybackModel::processSegment(const int tickPositionOffset, const Segment*
         }
 
         if (chordSymbol->play()) {
-            m_renderer.renderChordSymbol(chordSymbol, tickPositionOffset, profile,
-                                         m_playbackDataMap[trackId].originEvents);
+            m_renderer.renderChordSymbol(chordSymbol, tickPositionOffset, profile, trackData->second.originEvents);
         }
 
         collectChangesTracks(trackId, trackChanges);
@@ -387,7 +526,11 @@ void PlaybackModel::processSegment(const int tickPositionOffset, const Segment*
             }
         }
 
-        const PlaybackContext& ctx = m_playbackCtxMap[trackId];
+        auto ctx = m_playbackCtxMap.find(trackId);
+        auto trackData = m_playbackDataMap.find(trackId);
+        if (ctx == m_playbackCtxMap.cend() || trackData == m_playbackDataMap.end()) {
+            continue;
+        }
 
         ArticulationsProfilePtr profile = defaultActiculationProfile(trackId);
         if (!profile) {
@@ -395,9 +538,9 @@ void PlaybackModel::processSegment(const int tickPositionOffset, const Segment*
             continue;
         }
 
-        m_renderer.render(item, tickPositionOffset, ctx.appliableDynamicLevel(segmentStartTick + tickPositionOffset),
-                          ctx.persistentArticulationType(segmentStartTick + tickPositionOffset), std::move(profile),
-                          m_playbackDataMap[trackId].originEvents);
+        m_renderer.render(item, tickPositionOffset, ctx->second.appliableDynamicLevel(segmentStartTick + tickPositionOffset),
+                          ctx->second.persistentArticulationType(segmentStartTick + tickPositionOffset), std::move(profile),
+                          trackData->second.originEvents);
 
         collectChangesTracks(trackId, trackChanges);
     }
@@ -408,9 +551,82 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
 {
     TRACEFUNC;
 
-    std::set<staff_idx_t> changedStaffIdSet = m_score->staffIdsFromRange(trackFrom, trackTo);
+    std::vector<const Part*> parts;
 
-    for (const RepeatSegment* repeatSegment : repeatList()) {
+    for (const Part* part : m_score->parts()) {
+        if (trackTo < part->startTrack() || trackFrom >= part->endTrack()) {
+            continue;
+        }
+
+        parts.push_back(part);
+    }
+
+    processParts(repeatList(), tickFrom, tickTo, parts, true /*withMetronome*/, trackChanges);
+}
+
+void PlaybackModel::processParts(const RepeatList& repeats, const int tickFrom, const int tickTo, const std::vector<const Part*>& parts,
+                                 const bool withMetronome, ChangedTrackIdSet* trackChanges)
+{
+    //! NOTE Everything the rendering jobs share is prepared here, so that they only look it up:
+    //! the contexts and the tracks of every part, including the chord symbols one, exist before the jobs start
+    for (const Part* part : parts) {
+        InstrumentTrackIdSet trackIds = part->instrumentTrackIdSet();
+        if (part->hasChordSymbol()) {
+            trackIds.insert(chordSymbolsTrackId(part->id()));
+        }
+
+        for (const InstrumentTrackId& trackId : trackIds) {
+            if (!mu::contains(m_playbackCtxMap, trackId)) {
+                updateContext(trackId);
+            }
+
+            defaultActiculationProfile(trackId);
+        }
+    }
+
+    //! NOTE Rebuilds the spanner lookup tree if it has been invalidated by the edits
+    m_score->spannerMap().findOverlapping(tickFrom, tickTo);
+
+    //! NOTE Every part writes only to its own tracks and the metronome is rendered by a job of its own,
+    //! so the result doesn't depend on the order the jobs are run in
+    std::vector<ChangedTrackIdSet> jobsTrackChanges(parts.size() + 1);
+
+    TaskGroup group;
+
+    for (size_t i = 0; i < parts.size(); ++i) {
+        ChangedTrackIdSet* jobTrackChanges = trackChanges ? &jobsTrackChanges[i] : nullptr;
+
+        group.run([this, &repeats, tickFrom, tickTo, part = parts[i], jobTrackChanges]() {
+            NoteCurvesSharingScope curvesSharing;
+            processRange(repeats, tickFrom, tickTo, part->staveIdxList(), false /*withMetronome*/, jobTrackChanges);
+        });
+    }
+
+    if (withMetronome) {
+        ChangedTrackIdSet* jobTrackChanges = trackChanges ? &jobsTrackChanges.back() : nullptr;
+
+        group.run([this, &repeats, tickFrom, tickTo, jobTrackChanges]() {
+            NoteCurvesSharingScope curvesSharing;
+            processRange(repeats, tickFrom, tickTo, {}, true /*withMetronome*/, jobTrackChanges);
+        });
+    }
+
+    group.wait();
+
+    if (!trackChanges) {
+        return;
+    }
+
+    for (const ChangedTrackIdSet& jobTrackChanges : jobsTrackChanges) {
+        trackChanges->insert(jobTrackChanges.cbegin(), jobTrackChanges.cend());
+    }
+}
+
+void PlaybackModel::processRange(const RepeatList& repeats, const int tickFrom, const int tickTo,
+                                 const std::set<staff_idx_t>& changedStaffIdSet, const bool withMetronome,
+                                 ChangedTrackIdSet* trackChanges)
+{
+    for (const RepeatSegment* repeatSegment : repeats) {
         int tickPositionOffset = repeatSegment->utick - repeatSegment->tick;
         int repeatStartTick = repeatSegment->tick;
         int repeatEndTick = repeatStartTick + repeatSegment->len();
@@ -427,26 +643,433 @@ void PlaybackModel::updateEvents(const int tickFrom, const int tickTo, const tra
                 continue;
             }
 
-            for (Segment* segment = measure->first(); segment; segment = segment->next()) {
-                if (!segment->isChordRestType()) {
+            if (!changedStaffIdSet.empty()) {
+                processMeasure(tickPositionOffset, measure, tickFrom, tickTo, changedStaffIdSet, trackChanges);
+            }
+
+            if (withMetronome) {
+                processMetronome(tickPositionOffset, measure, trackChanges);
+            }
+        }
+    }
+}
+
+void PlaybackModel::processMeasure(const int tickPositionOffset, const Measure* measure, const int tickFrom, const int tickTo,
+                                   const std::set<staff_idx_t>& changedStaffIdSet, ChangedTrackIdSet* trackChanges)
+{
+    for (Segment* segment = measure->first(); segment; segment = segment->next()) {
+        if (!segment->isChordRestType()) {
+            continue;
+        }
+
+        int segmentStartTick = segment->tick().ticks();
+        int segmentEndTick = segmentStartTick + segment->ticks().ticks();
+
+        if (segmentStartTick > tickTo || segmentEndTick <= tickFrom) {
+            continue;
+        }
+
+        processSegment(tickPositionOffset, segment, changedStaffIdSet, trackChanges);
+    }
+}
+
+void PlaybackModel::processMetronome(const int tickPositionOffset, const Measure* measure, ChangedTrackIdSet* trackChanges)
+{
+    auto trackData = m_playbackDataMap.find(METRONOME_TRACK_ID);
+    if (trackData == m_playbackDataMap.end()) {
+        return;
+    }
+
+    m_renderer.renderMetronome(m_score, measure->tick().ticks(), measure->endTick().ticks(), tickPositionOffset,
+                               trackData->second.originEvents);
+    collectChangesTracks(METRONOME_TRACK_ID, trackChanges);
+}
+
+void PlaybackModel::startRendering()
+{
+    TRACEFUNC;
+
+    cancelRendering();
+
+    std::vector<const Measure*> measures;
+    for (const Measure* measure = m_score->firstMeasure(); measure; measure = measure->nextMeasure()) {
+        measures.push_back(measure);
+    }
+
+    if (measures.empty()) {
+        return;
+    }
+
+    size_t windowMeasuresCount = measures.size() <= SYNC_RENDERING_MEASURES_LIMIT
+                                 ? measures.size()
+                                 : RENDERING_WINDOW_MEASURES_COUNT;
+
+    for (size_t i = 0; i < measures.size(); i += windowMeasuresCount) {
+        const Measure* lastWindowMeasure = measures[std::min(i + windowMeasuresCount, measures.size()) - 1];
+        m_pendingWindows.push_back({ measures[i]->tick().ticks(), lastWindowMeasure->endTick().ticks() });
+    }
+
+    //! NOTE The events around the playback position have to be available right away
+    renderPendingWindow();
+
+    if (!m_pendingWindows.empty()) {
+        m_nextNotificationWindowsCount = 1;
+        scheduleRendering(m_renderingToken);
+    } else {
+        logMemoryUsage();
+    }
+}
+
+void PlaybackModel::cancelRendering()
+{
+    ++m_renderingToken;
+
+    m_pendingWindows.clear();
+    m_renderedWindowsCount = 0;
+    m_nextNotificationWindowsCount = 0;
+}
+
+void PlaybackModel::scheduleRendering(const uint64_t renderingToken)
+{
+    //! NOTE The score can't be read while it's being edited, so the windows are rendered on the main thread,
+    //! one per event loop iteration. The parts of each window are rendered in parallel
+    Async::call(this, [this, renderingToken]() {
+        if (renderingToken != m_renderingToken || m_pendingWindows.empty()) {
+            return;
+        }
+
+        renderPendingWindow();
+        ++m_renderedWindowsCount;
+
+        //! NOTE Every notification makes the listeners copy all the events of the tracks,
+        //! so they are sent less and less often
+        if (m_pendingWindows.empty() || m_renderedWindowsCount == m_nextNotificationWindowsCount) {
+            m_nextNotificationWindowsCount *= 2;
+            notifyAboutRenderedEvents();
+        }
+
+        if (!m_pendingWindows.empty()) {
+            scheduleRendering(renderingToken);
+        } else {
+            logMemoryUsage();
+        }
+    });
+}
+
+void PlaybackModel::renderPendingWindow()
+{
+    if (m_pendingWindows.empty()) {
+        return;
+    }
+
+    size_t windowIdx = nextPendingWindowIdx();
+    TickBoundaries window = m_pendingWindows.at(windowIdx);
+    m_pendingWindows.erase(m_pendingWindows.begin() + windowIdx);
+
+    renderWindow(repeatList(), window);
+}
+
+void PlaybackModel::renderWindow(const RepeatList& repeats, const TickBoundaries& window)
+{
+    TRACEFUNC;
+
+    //! NOTE Rendering a window again replaces its events. The window end belongs to the next window
+    for (const RepeatSegment* repeatSegment : repeats) {
+        int tickPositionOffset = repeatSegment->utick - repeatSegment->tick;
+        int tickFrom = std::max(window.tickFrom, repeatSegment->tick);
+        int tickTo = std::min(window.tickTo, repeatSegment->tick + repeatSegment->len());
+
+        if (tickFrom >= tickTo) {
+            continue;
+        }
+
+        removeEventsFromRange(0, m_score->ntracks(), timestampFromTicks(m_score, tickFrom + tickPositionOffset),
+                              timestampFromTicks(m_score, tickTo + tickPositionOffset - 1));
+    }
+
+    std::vector<const Part*> parts(m_score->parts().cbegin(), m_score->parts().cend());
+
+    processParts(repeats, window.tickFrom, window.tickTo - 1, parts, true /*withMetronome*/, nullptr);
+}
+
+size_t PlaybackModel::nextPendingWindowIdx() const
+{
+    for (size_t i = 0; i < m_pendingWindows.size(); ++i) {
+        if (m_pendingWindows.at(i).tickTo > m_playbackPositionTick) {
+            return i;
+        }
+    }
+
+    return m_pendingWindows.size() - 1;
+}
+
+void PlaybackModel::notifyAboutRenderedEvents()
+{
+    for (auto& pair : m_playbackDataMap) {
+        pair.second.mainStream.send(pair.second.originEvents);
+    }
+
+    m_dataChanged.notify();
+}
+
+void PlaybackModel::logMemoryUsage() const
+{
+    for (const auto& pair : m_playbackDataMap) {
+        LOGD() << "track " << pair.first.partId.toUint64() << " " << pair.first.instrumentId << ": "
+               << memoryUsageInfo(pair.second.originEvents);
+    }
+}
+
+bool PlaybackModel::isTimelineChanged() const
+{
+    if (!isSameTempoMap(m_timelineSnapshot.tempoMap, *m_score->tempomap())) {
+        return true;
+    }
+
+    const RepeatList& repeats = repeatList();
+
+    if (repeats.size() != m_timelineSnapshot.repeatSegments.size()) {
+        return true;
+    }
+
+    for (size_t i = 0; i < repeats.size(); ++i) {
+        const RepeatSegment* repeatSegment = repeats.at(i);
+        const TimelineSnapshot::RepeatSegmentData& oldRepeatSegment = m_timelineSnapshot.repeatSegments.at(i);
+
+        if (repeatSegment->tick != oldRepeatSegment.tick
+            || repeatSegment->len() != oldRepeatSegment.len
+            || repeatSegment->utick != oldRepeatSegment.utick) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void PlaybackModel::takeTimelineSnapshot()
+{
+    m_timelineSnapshot.tempoMap = *m_score->tempomap();
+    m_timelineSnapshot.repeatSegments.clear();
+
+    for (const RepeatSegment* repeatSegment : repeatList()) {
+        m_timelineSnapshot.repeatSegments.push_back({ repeatSegment->tick, repeatSegment->len(),
+                                                      repeatSegment->utick, repeatSegment->timeOffset });
+    }
+}
+
+void PlaybackModel::remapTimeline(ChangedTrackIdSet* trackChanges)
+{
+    TRACEFUNC;
+
+    //! NOTE The contexts are bound to the repeat list, so all of them are rebuilt here.
+    //!      The old ones tell whether the events of a piece of the timeline are still valid
+    std::unordered_map<InstrumentTrackId, PlaybackContext> oldContexts;
+    oldContexts.swap(m_playbackCtxMap);
+
+    updateSetupData();
+    updateContext(0, m_score->ntracks());
+
+    std::unordered_map<InstrumentTrackId, PlaybackEventsMap> oldEvents;
+
+    for (auto& pair : m_playbackDataMap) {
+        oldEvents.emplace(pair.first, std::move(pair.second.originEvents));
+        pair.second.originEvents.clear();
+        collectChangesTracks(pair.first, trackChanges);
+    }
+
+    std::vector<std::pair<int, int> > dirtyTickRanges;
+    std::set<int> splitTicks;
+    collectTempoChanges(m_timelineSnapshot.tempoMap, *m_score->tempomap(), dirtyTickRanges, splitTicks);
+
+    const std::set<staff_idx_t> allStaffIdSet = m_score->staffIdsFromRange(0, m_score->ntracks());
+    const std::vector<TimelineSnapshot::RepeatSegmentData>& oldRepeatSegments = m_timelineSnapshot.repeatSegments;
+
+    for (const RepeatSegment* repeatSegment : repeatList()) {
+        const std::vector<const Measure*>& measures = repeatSegment->measureList();
+        if (measures.empty()) {
+            continue;
+        }
+
+        const int tickPositionOffset = repeatSegment->utick - repeatSegment->tick;
+        const TimelineSnapshot::RepeatSegmentData* oldRepeatSegment
+            = m_timelineSnapshot.findRepeatSegment(repeatSegment->tick, repeatSegment->len());
+
+        std::vector<bool> dirtyMeasures(measures.size(), oldRepeatSegment == nullptr);
+
+        for (size_t i = 0; i < measures.size(); ++i) {
+            for (const auto& range : dirtyTickRanges) {
+                if (measures[i]->tick().ticks() < range.second && measures[i]->endTick().ticks() > range.first) {
+                    dirtyMeasures[i] = true;
+                    break;
+                }
+            }
+        }
+
+        auto oldTimestamp = [&](const int tick) -> timestamp_t {
+            if (tick == oldRepeatSegment->tick && oldRepeatSegment == &oldRepeatSegments.front()) {
+                return std::numeric_limits<timestamp_t>::min();
+            }
+
+            if (tick == oldRepeatSegment->tick + oldRepeatSegment->len && oldRepeatSegment == &oldRepeatSegments.back()) {
+                return std::numeric_limits<timestamp_t>::max();
+            }
+
+            return m_timelineSnapshot.timestamp(*oldRepeatSegment, tick);
+        };
+
+        auto measureIdx = [&](const int tick, const TimelinePiece& piece) -> size_t {
+            auto it = std::upper_bound(measures.cbegin(), measures.cend(), tick, [](const int tick, const Measure* measure) {
+                return tick < measure->tick().ticks();
+            });
+
+            size_t idx = it == measures.cbegin() ? 0 : static_cast<size_t>(std::distance(measures.cbegin(), it) - 1);
+            return std::clamp(idx, piece.measureFrom, piece.measureTo - 1);
+        };
+
+        //! NOTE Find the pieces of the timeline whose events can be moved. The events which refer to
+        //!      the time outside of their piece (slurs, ties, pedal lines...) are rendered again
+        std::vector<TimelinePiece> pieces = timelinePieces(measures, dirtyMeasures, splitTicks);
+
+        for (bool piecesChanged = oldRepeatSegment != nullptr; piecesChanged;) {
+            piecesChanged = false;
+
+            for (const TimelinePiece& piece : pieces) {
+                if (piece.isDirty) {
+                    continue;
+                }
+
+                bool isContextChanged = false;
+                const int oldTickPositionOffset = oldRepeatSegment->utick - oldRepeatSegment->tick;
+
+                for (const auto& pair : m_playbackCtxMap) {
+                    auto oldCtx = oldContexts.find(pair.first);
+
+                    if (oldCtx == oldContexts.cend()
+                        || !pair.second.hasEqualData(oldCtx->second, piece.tickFrom + tickPositionOffset,
+                                                     piece.tickTo + tickPositionOffset, oldTickPositionOffset - tickPositionOffset)) {
+                        isContextChanged = true;
+                        break;
+                    }
+                }
+
+                if (isContextChanged) {
+                    std::fill(dirtyMeasures.begin() + piece.measureFrom, dirtyMeasures.begin() + piece.measureTo, true);
+                    piecesChanged = true;
                     continue;
                 }
 
-                int segmentStartTick = segment->tick().ticks();
-                int segmentEndTick = segmentStartTick + segment->ticks().ticks();
+                const timestamp_t timestampFrom = oldTimestamp(piece.tickFrom);
+                const timestamp_t timestampTo = oldTimestamp(piece.tickTo);
+
+                for (const auto& pair : oldEvents) {
+                    auto it = pair.second.lower_bound(timestampFrom);
+                    auto end = pair.second.lower_bound(timestampTo);
+
+                    for (; it != end; ++it) {
+                        for (const PlaybackEvent& event : it->second) {
+                            if (isEventWithinRange(event, timestampFrom, timestampTo)) {
+                                continue;
+                            }
+
+                            double secs = it->first / 1000000.0 - oldRepeatSegment->timeOffset;
+                            dirtyMeasures[measureIdx(m_timelineSnapshot.tempoMap.time2tick(secs), piece)] = true;
+                            piecesChanged = true;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            if (piecesChanged) {
+                pieces = timelinePieces(measures, dirtyMeasures, splitTicks);
+            }
+        }
+
+        for (const TimelinePiece& piece : pieces) {
+            if (piece.isDirty) {
+                for (size_t i = piece.measureFrom; i < piece.measureTo; ++i) {
+                    processMeasure(tickPositionOffset, measures[i], measures[i]->tick().ticks(), measures[i]->endTick().ticks(),
+                                   allStaffIdSet, trackChanges);
+                    processMetronome(tickPositionOffset, measures[i], trackChanges);
+                }
+
+                continue;
+            }
+
+            const timestamp_t timestampFrom = oldTimestamp(piece.tickFrom);
+            const timestamp_t timestampTo = oldTimestamp(piece.tickTo);
+            const timestamp_t offset = timestampFromTicks(m_score, piece.tickFrom + tickPositionOffset)
+                                       - m_timelineSnapshot.timestamp(*oldRepeatSegment, piece.tickFrom);
 
-                if (segmentStartTick > tickTo || segmentEndTick <= tickFrom) {
+            for (auto& pair : m_playbackDataMap) {
+                auto search = oldEvents.find(pair.first);
+                if (search == oldEvents.cend()) {
                     continue;
                 }
 
-                processSegment(tickPositionOffset, segment, changedStaffIdSet, trackChanges);
+                auto it = search->second.lower_bound(timestampFrom);
+                auto end = search->second.lower_bound(timestampTo);
+
+                for (; it != end; ++it) {
+                    PlaybackEventList& events = pair.second.originEvents[it->first + offset];
+
+                    for (PlaybackEvent event : it->second) {
+                        std::visit([offset](auto& e) { e.shiftTimestamp(offset); }, event);
+                        events.push_back(std::move(event));
+                    }
+                }
             }
+        }
+    }
+}
+
+std::vector<PlaybackModel::TimelinePiece> PlaybackModel::timelinePieces(const std::vector<const Measure*>& measures,
+                                                                        const std::vector<bool>& dirtyMeasures,
+                                                                        const std::set<int>& splitTicks) const
+{
+    std::vector<TimelinePiece> result;
+
+    for (size_t i = 0; i < measures.size(); ++i) {
+        int measureStartTick = measures[i]->tick().ticks();
+        int measureEndTick = measures[i]->endTick().ticks();
+        bool isDirty = dirtyMeasures[i];
+
+        if (!result.empty() && result.back().isDirty == isDirty && (isDirty || !mu::contains(splitTicks, measureStartTick))) {
+            result.back().tickTo = measureEndTick;
+            result.back().measureTo = i + 1;
+        } else {
+            result.push_back({ measureStartTick, measureEndTick, i, i + 1, isDirty });
+        }
+
+        if (isDirty) {
+            continue;
+        }
 
-            m_renderer.renderMetronome(m_score, measureStartTick, measureEndTick, tickPositionOffset,
-                                       m_playbackDataMap[METRONOME_TRACK_ID].originEvents);
-            collectChangesTracks(METRONOME_TRACK_ID, trackChanges);
+        for (auto it = splitTicks.upper_bound(measureStartTick); it != splitTicks.cend() && *it < measureEndTick; ++it) {
+            result.back().tickTo = *it;
+            result.push_back({ *it, measureEndTick, i, i + 1, false });
         }
     }
+
+    return result;
+}
+
+const PlaybackModel::TimelineSnapshot::RepeatSegmentData* PlaybackModel::TimelineSnapshot::findRepeatSegment(const int tick,
+                                                                                                              const int len) const
+{
+    for (const RepeatSegmentData& repeatSegment : repeatSegments) {
+        if (repeatSegment.tick == tick && repeatSegment.len == len) {
+            return &repeatSegment;
+        }
+    }
+
+    return nullptr;
+}
+
+timestamp_t PlaybackModel::TimelineSnapshot::timestamp(const RepeatSegmentData& repeatSegment, const int tick) const
+{
+    //! NOTE The same computation as timestampFromTicks() does, but for the snapshot
+    return (tempoMap.tick2time(tick) + repeatSegment.timeOffset) * 1000000;
 }
 
 bool PlaybackModel::hasToReloadTracks(const ScoreChangesRange& changesRange) const
@@ -492,16 +1115,7 @@ bool PlaybackModel::hasToReloadScore(const std::unordered_set<ElementType>& chan
 {
     static const std::unordered_set<ElementType> REQUIRED_TYPES = {
         ElementType::SCORE,
-        ElementType::GRADUAL_TEMPO_CHANGE,
-        ElementType::GRADUAL_TEMPO_CHANGE_SEGMENT,
-        ElementType::TEMPO_TEXT,
-        ElementType::LAYOUT_BREAK,
-        ElementType::FERMATA,
-        ElementType::VOLTA,
-        ElementType::VOLTA_SEGMENT,
         ElementType::SYSTEM_TEXT,
-        ElementType::JUMP,
-        ElementType::MARKER,
     };
 
     for (const ElementType type : REQUIRED_TYPES) {
@@ -26,6 +26,7 @@
 #include <unordered_map>
 #include <map>
 #include <functional>
+#include <vector>
 
 #include "async/asyncable.h"
 #include "async/channel.h"
@@ -35,6 +36,7 @@
 #include "mpe/events.h"
 #include "mpe/iarticulationprofilesrepository.h"
 
+#include "libmscore/tempo.h"
 #include "types/types.h"
 #include "playbackeventsrenderer.h"
 #include "playbacksetupdataresolver.h"
@@ -46,6 +48,8 @@ class Note;
 class EngravingItem;
 class Segment;
 class Instrument;
+class Measure;
+class Part;
 class RepeatList;
 
 class PlaybackModel : public async::Asyncable
@@ -74,6 +78,8 @@ public:
 
     void triggerMetronome(int tick);
 
+    void setPlaybackPositionTick(const int tick);
+
     InstrumentTrackIdSet existingTrackIdSet() const;
     async::Channel<InstrumentTrackId> trackAdded() const;
     async::Channel<InstrumentTrackId> trackRemoved() const;
@@ -96,6 +102,34 @@ private:
         track_idx_t trackTo = mu::nidx;
     };
 
+    //! NOTE The tempo map and the repeat list the current events have been rendered with,
+    //! used to move the already rendered events when only their position in time changes
+    struct TimelineSnapshot
+    {
+        struct RepeatSegmentData
+        {
+            int tick = 0;
+            int len = 0;
+            int utick = 0;
+            double timeOffset = 0.0;
+        };
+
+        TempoMap tempoMap;
+        std::vector<RepeatSegmentData> repeatSegments;
+
+        const RepeatSegmentData* findRepeatSegment(const int tick, const int len) const;
+        mpe::timestamp_t timestamp(const RepeatSegmentData& repeatSegment, const int tick) const;
+    };
+
+    struct TimelinePiece
+    {
+        int tickFrom = 0;
+        int tickTo = 0;
+        size_t measureFrom = 0;
+        size_t measureTo = 0;
+        bool isDirty = false;
+    };
+
     InstrumentTrackId idKey(const EngravingItem* item) const;
     InstrumentTrackId idKey(const std::vector<const EngravingItem*>& items) const;
     InstrumentTrackId idKey(const ID& partId, const std::string& instrumentId) const;
@@ -110,6 +144,28 @@ private:
 
     void processSegment(const int tickPositionOffset, const Segment* segment, const std::set<staff_idx_t>& changedStaffIdSet,
                         ChangedTrackIdSet* trackChanges);
+    void processMeasure(const int tickPositionOffset, const Measure* measure, const int tickFrom, const int tickTo,
+                        const std::set<staff_idx_t>& changedStaffIdSet, ChangedTrackIdSet* trackChanges);
+    void processMetronome(const int tickPositionOffset, const Measure* measure, ChangedTrackIdSet* trackChanges);
+    void processParts(const RepeatList& repeats, const int tickFrom, const int tickTo, const std::vector<const Part*>& parts,
+                      const bool withMetronome, ChangedTrackIdSet* trackChanges);
+    void processRange(const RepeatList& repeats, const int tickFrom, const int tickTo, const std::set<staff_idx_t>& changedStaffIdSet,
+                      const bool withMetronome, ChangedTrackIdSet* trackChanges);
+
+    void startRendering();
+    void cancelRendering();
+    void scheduleRendering(const uint64_t renderingToken);
+    void renderPendingWindow();
+    void renderWindow(const RepeatList& repeats, const TickBoundaries& window);
+    size_t nextPendingWindowIdx() const;
+    void notifyAboutRenderedEvents();
+    void logMemoryUsage() const;
+
+    bool isTimelineChanged() const;
+    void takeTimelineSnapshot();
+    void remapTimeline(ChangedTrackIdSet* trackChanges);
+    std::vector<TimelinePiece> timelinePieces(const std::vector<const Measure*>& measures, const std::vector<bool>& dirtyMeasures,
+                                              const std::set<int>& splitTicks) const;
 
     bool hasToReloadTracks(const ScoreChangesRange& changesRange) const;
     bool hasToReloadScore(const std::unordered_set<ElementType>& changedTypes) const;
@@ -145,6 +201,16 @@ private:
     std::unordered_map<InstrumentTrackId, PlaybackContext> m_playbackCtxMap;
     std::unordered_map<InstrumentTrackId, mpe::PlaybackData> m_playbackDataMap;
 
+    TimelineSnapshot m_timelineSnapshot;
+
+    //! NOTE The parts of the score which haven't been rendered yet, the ones
+    //! around the playback position are rendered first
+    int m_playbackPositionTick = 0;
+    std::vector<TickBoundaries> m_pendingWindows;
+    uint64_t m_renderingToken = 0;
+    size_t m_renderedWindowsCount = 0;
+    size_t m_nextNotificationWindowsCount = 0;
+
     async::Notification m_dataChanged;
     async::Channel<InstrumentTrackId> m_trackAdded;
     async::Channel<InstrumentTrackId> m_trackRemoved;
@@ -21,6 +21,7 @@
  */
 #include "mscloader.h"
 
+#include <chrono>
 #include <memory>
 #include <map>
 
@@ -71,6 +72,11 @@ static RetVal<IReaderPtr> makeReader(int version, bool ignoreVersionError)
     return RetVal<IReaderPtr>::make_ok(RWRegister::reader(version));
 }
 
+static int64_t elapsedMs(std::chrono::steady_clock::time_point since)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - since).count();
+}
+
 mu::Ret MscLoader::loadMscz(MasterScore* masterScore, const MscReader& mscReader, SettingsCompat& settingsCompat,
                             bool ignoreVersionError)
 {
@@ -84,6 +90,8 @@ mu::Ret MscLoader::loadMscz(MasterScore* masterScore, const MscReader& mscReader
 
     ScoreLoad sl;
 
+    m_excerptsStatistics.clear();
+
     // Read style
     {
         ByteArray styleData = mscReader.readStyleFile();
@@ -135,6 +143,18 @@ mu::Ret MscLoader::loadMscz(MasterScore* masterScore, const MscReader& mscReader
     if (ret && masterScore->mscVersion() >= 400) {
         std::vector<String> excerptNames = mscReader.excerptNames();
         for (const String& excerptName : excerptNames) {
+            ExcerptLoadStatistics stat;
+            stat.name = excerptName;
+
+            auto start = std::chrono::steady_clock::now();
+
+            ByteArray excerptStyleData = mscReader.readExcerptStyleFile(excerptName);
+            ByteArray excerptData = mscReader.readExcerptFile(excerptName);
+
+            stat.dataSize = excerptStyleData.size() + excerptData.size();
+            stat.readFilesTimeMs = elapsedMs(start);
+            start = std::chrono::steady_clock::now();
+
             Score* partScore = masterScore->createScore();
 
             compat::ReadStyleHook::setupDefaultStyle(partScore);
@@ -142,14 +162,11 @@ mu::Ret MscLoader::loadMscz(MasterScore* masterScore, const MscReader& mscReader
             Excerpt* ex = new Excerpt(masterScore);
             ex->setExcerptScore(partScore);
 
-            ByteArray excerptStyleData = mscReader.readExcerptStyleFile(excerptName);
             Buffer excerptStyleBuf(&excerptStyleData);
             excerptStyleBuf.open(IODevice::ReadOnly);
             partScore->style().read(&excerptStyleBuf);
 
-            ByteArray excerptData = mscReader.readExcerptFile(excerptName);
-
-            XmlReader xml(excerptData);
+            XmlReader xml(std::move(excerptData));
             xml.setDocName(excerptName);
 
             ReadInOutData partReadInData;
@@ -172,6 +189,9 @@ mu::Ret MscLoader::loadMscz(MasterScore* masterScore, const MscReader& mscReader
             ex->setName(excerptName);
 
             masterScore->addExcerpt(ex);
+
+            stat.readScoreTimeMs = elapsedMs(start);
+            m_excerptsStatistics.push_back(stat);
         }
     }
 
@@ -192,6 +212,11 @@ mu::Ret MscLoader::loadMscz(MasterScore* masterScore, const MscReader& mscReader
     return ret;
 }
 
+const std::vector<ExcerptLoadStatistics>& MscLoader::excerptsStatistics() const
+{
+    return m_excerptsStatistics;
+}
+
 mu::Ret MscLoader::readMasterScore(MasterScore* score, XmlReader& e, bool ignoreVersionError, ReadInOutData* out,
                                    compat::ReadStyleHook* styleHook)
 {
@@ -45,10 +45,14 @@ public:
 
     Ret loadMscz(MasterScore* score, const MscReader& mscReader, SettingsCompat& settingsCompat, bool ignoreVersionError);
 
+    const std::vector<ExcerptLoadStatistics>& excerptsStatistics() const;
+
 private:
     friend class MasterScore;
     Ret readMasterScore(MasterScore* score, XmlReader&, bool ignoreVersionError, rw::ReadInOutData* out = nullptr,
                         compat::ReadStyleHook* styleHook = nullptr);
+
+    std::vector<ExcerptLoadStatistics> m_excerptsStatistics;
 };
 }
 
@@ -39,6 +39,8 @@ public:
     XmlReader() = default;
     XmlReader(const mu::ByteArray& d)
         : XmlStreamReader(d) {}
+    XmlReader(mu::ByteArray&& d)
+        : XmlStreamReader(std::move(d)) {}
     XmlReader(mu::io::IODevice* d)
         : XmlStreamReader(d) {}
 
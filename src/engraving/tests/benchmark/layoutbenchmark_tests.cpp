@@ -0,0 +1,111 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "libmscore/masterscore.h"
+
+#include "utils/scorerw.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+//! NOTE The allocation counter replaces the global operator new/delete,
+//! that's why the benchmarks have their own test binary.
+//! It only counts while a benchmark explicitly enables it.
+
+static std::atomic<bool> s_countAllocations { false };
+static std::atomic<size_t> s_allocations { 0 };
+
+static void* countedAlloc(std::size_t size)
+{
+    if (s_countAllocations.load(std::memory_order_relaxed)) {
+        s_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+static const String LAYOUT_BENCHMARK_SCORE("concertpitch_data/concertpitchbenchmark.mscx");
+
+class Engraving_LayoutBenchmarkTests : public ::testing::Test
+{
+};
+
+//---------------------------------------------------------
+//   allocationsPerMeasure
+//    counts heap allocations made by a full layout of a large
+//    score; run on two revisions to compare the numbers:
+//    --gtest_also_run_disabled_tests --gtest_filter=*allocationsPerMeasure
+//---------------------------------------------------------
+
+TEST_F(Engraving_LayoutBenchmarkTests, DISABLED_allocationsPerMeasure)
+{
+    MasterScore* score = ScoreRW::readScore(LAYOUT_BENCHMARK_SCORE);
+    ASSERT_TRUE(score);
+
+    size_t measures = score->nmeasures();
+    ASSERT_GT(measures, 0);
+
+    // warm up caches that are filled lazily on the first layout
+    score->doLayout();
+
+    constexpr int RUNS = 3;
+    size_t total = 0;
+
+    for (int i = 0; i < RUNS; ++i) {
+        s_allocations = 0;
+        s_countAllocations = true;
+        score->doLayout();
+        s_countAllocations = false;
+        total += s_allocations.load();
+    }
+
+    double perMeasure = double(total) / RUNS / measures;
+
+    RecordProperty("measures", std::to_string(measures));
+    RecordProperty("allocationsPerLayout", std::to_string(total / RUNS));
+    RecordProperty("allocationsPerMeasure", std::to_string(perMeasure));
+
+    LOGI() << "layout of " << measures << " measures: " << total / RUNS << " allocations, "
+           << perMeasure << " per measure";
+
+    delete score;
+}
@@ -0,0 +1,201 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/page.h"
+#include "libmscore/segment.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String ALL_ELEMENTS_DATA_DIR("all_elements_data/");
+
+class Engraving_BspTests : public ::testing::Test
+{
+public:
+    static std::vector<EngravingItem*> bruteForceItems(Page* page, const RectF& rect);
+    static std::vector<EngravingItem*> sorted(std::vector<EngravingItem*> items);
+    static void checkPage(Page* page);
+};
+
+//---------------------------------------------------------
+//   bruteForceItems
+//    items of the page intersecting rect, found without
+//    the help of the page's BspTree
+//---------------------------------------------------------
+
+std::vector<EngravingItem*> Engraving_BspTests::bruteForceItems(Page* page, const RectF& rect)
+{
+    struct Data {
+        RectF rect;
+        std::vector<EngravingItem*> items;
+    } data { rect, {} };
+
+    page->scanElements(&data, [](void* d, EngravingItem* e) {
+        Data* data = static_cast<Data*>(d);
+        if (e->pageBoundingRect().intersects(data->rect)) {
+            data->items.push_back(e);
+        }
+    }, false);
+
+    return data.items;
+}
+
+std::vector<EngravingItem*> Engraving_BspTests::sorted(std::vector<EngravingItem*> items)
+{
+    std::sort(items.begin(), items.end());
+    return items;
+}
+
+//---------------------------------------------------------
+//   checkPage
+//    compare BspTree queries of a page with a brute force
+//    search, for the whole page, its quarters and a batch
+//    of all quarters
+//---------------------------------------------------------
+
+void Engraving_BspTests::checkPage(Page* page)
+{
+    const RectF pageRect = page->abbox();
+    const double w = pageRect.width() / 2;
+    const double h = pageRect.height() / 2;
+
+    std::vector<RectF> quarters;
+    for (int row = 0; row < 2; ++row) {
+        for (int col = 0; col < 2; ++col) {
+            quarters.push_back(RectF(pageRect.left() + col * w, pageRect.top() + row * h, w, h));
+        }
+    }
+
+    EXPECT_EQ(sorted(page->items(pageRect)), sorted(bruteForceItems(page, pageRect)));
+
+    for (const RectF& quarter : quarters) {
+        EXPECT_EQ(sorted(page->items(quarter)), sorted(bruteForceItems(page, quarter)));
+    }
+
+    std::vector<EngravingItem*> batched = sorted(page->items(quarters));
+    EXPECT_TRUE(std::adjacent_find(batched.begin(), batched.end()) == batched.end());
+    EXPECT_EQ(batched, sorted(bruteForceItems(page, pageRect)));
+}
+
+//---------------------------------------------------------
+//   queries
+//---------------------------------------------------------
+
+TEST_F(Engraving_BspTests, queries)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_FALSE(score->pages().empty());
+
+    for (Page* page : score->pages()) {
+        checkPage(page);
+    }
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   incrementalUpdate
+//    after an edit the tree is updated incrementally and
+//    has to give the same results as a brute force search
+//---------------------------------------------------------
+
+TEST_F(Engraving_BspTests, incrementalUpdate)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    Page* page = score->pages().front();
+    checkPage(page);
+
+    Segment* segment = score->firstMeasure()->first(SegmentType::ChordRest);
+    ASSERT_TRUE(segment);
+    EngravingItem* item = segment->element(0);
+    ASSERT_TRUE(item);
+
+    score->startCmd();
+    item->undoChangeProperty(Pid::OFFSET, PointF(0.0, 20.0));
+    score->endCmd();
+
+    checkPage(page);
+
+    score->undoRedo(true, nullptr);
+    checkPage(page);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   changedAreas
+//    the areas of the items moved by an edit are logged
+//---------------------------------------------------------
+
+TEST_F(Engraving_BspTests, changedAreas)
+{
+    MasterScore* score = ScoreRW::readScore(ALL_ELEMENTS_DATA_DIR + u"moonlight.mscx");
+    ASSERT_TRUE(score);
+
+    Page* page = score->pages().front();
+    uint64_t revision = page->itemsRevision();
+
+    std::vector<RectF> areas;
+    EXPECT_TRUE(page->changedAreasSince(revision, areas));
+    EXPECT_TRUE(areas.empty());
+
+    Segment* segment = score->firstMeasure()->first(SegmentType::ChordRest);
+    ASSERT_TRUE(segment);
+    EngravingItem* item = segment->element(0);
+    ASSERT_TRUE(item);
+    RectF oldRect = item->pageBoundingRect();
+
+    score->startCmd();
+    item->undoChangeProperty(Pid::OFFSET, PointF(0.0, 20.0));
+    score->endCmd();
+
+    RectF newRect = item->pageBoundingRect();
+
+    areas.clear();
+    ASSERT_TRUE(page->changedAreasSince(revision, areas));
+    EXPECT_FALSE(areas.empty());
+
+    bool oldRectCovered = false;
+    bool newRectCovered = false;
+    for (const RectF& area : areas) {
+        oldRectCovered = oldRectCovered || area.contains(oldRect);
+        newRectCovered = newRectCovered || area.contains(newRect);
+    }
+    EXPECT_TRUE(oldRectCovered);
+    EXPECT_TRUE(newRectCovered);
+
+    // unknown revisions
+    EXPECT_FALSE(page->changedAreasSince(page->itemsRevision() + 1, areas));
+
+    delete score;
+}
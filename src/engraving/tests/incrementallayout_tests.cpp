@@ -0,0 +1,168 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "libmscore/articulation.h"
+#include "libmscore/chord.h"
+#include "libmscore/factory.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/measurenumber.h"
+#include "libmscore/page.h"
+#include "libmscore/segment.h"
+#include "libmscore/system.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String INCREMENTAL_LAYOUT_SCORE("concertpitch_data/concertpitchbenchmark.mscx");
+
+class Engraving_IncrementalLayoutTests : public ::testing::Test
+{
+public:
+    struct LayoutSnapshot {
+        std::vector<double> positions;
+        std::vector<String> measureNumbers;
+    };
+
+    //! NOTE Everything the page layout of the systems decides
+    static LayoutSnapshot layoutSnapshot(const Score* score)
+    {
+        LayoutSnapshot snapshot;
+
+        for (const Page* page : score->pages()) {
+            snapshot.positions.push_back(static_cast<double>(page->systems().size()));
+
+            for (const System* system : page->systems()) {
+                snapshot.positions.push_back(system->y());
+                snapshot.positions.push_back(system->height());
+
+                for (const MeasureBase* mb : system->measures()) {
+                    snapshot.positions.push_back(mb->x());
+                    snapshot.positions.push_back(mb->width());
+
+                    if (!mb->isMeasure()) {
+                        continue;
+                    }
+
+                    const MeasureNumber* number = toMeasure(mb)->noText(0);
+                    snapshot.measureNumbers.push_back(number ? number->xmlText() : String());
+                }
+            }
+        }
+
+        return snapshot;
+    }
+
+    static void expectEqual(const LayoutSnapshot& actual, const LayoutSnapshot& expected)
+    {
+        ASSERT_EQ(actual.positions.size(), expected.positions.size());
+        for (size_t i = 0; i < actual.positions.size(); ++i) {
+            EXPECT_DOUBLE_EQ(actual.positions[i], expected.positions[i]) << "at " << i;
+        }
+
+        ASSERT_EQ(actual.measureNumbers.size(), expected.measureNumbers.size());
+        for (size_t i = 0; i < actual.measureNumbers.size(); ++i) {
+            EXPECT_EQ(actual.measureNumbers[i], expected.measureNumbers[i]) << "at " << i;
+        }
+    }
+
+    static Chord* firstChord(const Score* score)
+    {
+        for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+            EngravingItem* e = s->element(0);
+            if (e && e->isChord()) {
+                return toChord(e);
+            }
+        }
+
+        return nullptr;
+    }
+};
+
+//---------------------------------------------------------
+//   editStopsAtFirstStableSystem
+//    an edit which doesn't change the line breaks only lays out
+//    the edited system, the rest is taken from the previous layout
+//---------------------------------------------------------
+
+TEST_F(Engraving_IncrementalLayoutTests, editStopsAtFirstStableSystem)
+{
+    MasterScore* score = ScoreRW::readScore(INCREMENTAL_LAYOUT_SCORE);
+    ASSERT_TRUE(score);
+
+    score->doLayout();
+    const size_t systemsCount = score->systems().size();
+    ASSERT_GT(score->npages(), 2u);
+
+    Chord* chord = firstChord(score);
+    ASSERT_TRUE(chord);
+
+    score->startCmd();
+    Articulation* articulation = Factory::createArticulation(chord);
+    articulation->setSymId(SymId::articAccentAbove);
+    articulation->setParent(chord);
+    articulation->setTrack(chord->track());
+    score->undoAddElement(articulation);
+    score->endCmd();
+
+    layout::LayoutStatistics statistics = score->layout()->lastLayoutStatistics();
+    EXPECT_GT(statistics.recomputedSystems, 0);
+    EXPECT_LT(statistics.recomputedSystems + statistics.reusedSystems, systemsCount);
+
+    LayoutSnapshot incremental = layoutSnapshot(score);
+
+    score->doLayout();
+    expectEqual(incremental, layoutSnapshot(score));
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   insertMeasureBeforeReusedSystems
+//    the systems after an inserted measure keep their layout,
+//    but their measure numbers have to follow
+//---------------------------------------------------------
+
+TEST_F(Engraving_IncrementalLayoutTests, insertMeasureBeforeReusedSystems)
+{
+    MasterScore* score = ScoreRW::readScore(INCREMENTAL_LAYOUT_SCORE);
+    ASSERT_TRUE(score);
+
+    score->doLayout();
+
+    score->startCmd();
+    score->insertMeasure(ElementType::MEASURE, score->firstMeasure()->nextMeasure());
+    score->endCmd();
+
+    LayoutSnapshot incremental = layoutSnapshot(score);
+
+    score->doLayout();
+    expectEqual(incremental, layoutSnapshot(score));
+
+    delete score;
+}
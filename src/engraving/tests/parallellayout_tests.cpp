@@ -0,0 +1,120 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/mscore.h"
+#include "libmscore/segment.h"
+#include "libmscore/system.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String PARALLEL_LAYOUT_SCORE("concertpitch_data/concertpitchbenchmark.mscx");
+
+class Engraving_ParallelLayoutTests : public ::testing::Test
+{
+public:
+    //! NOTE Positions and sizes of everything the concurrent part of system layout computes
+    static std::vector<double> layoutSnapshot(const Score* score)
+    {
+        std::vector<double> snapshot;
+
+        for (const System* system : score->systems()) {
+            snapshot.push_back(system->x());
+            snapshot.push_back(system->y());
+            snapshot.push_back(system->width());
+            snapshot.push_back(system->height());
+
+            for (const SysStaff* staff : system->staves()) {
+                snapshot.push_back(staff->y());
+                snapshot.push_back(staff->skyline().north().max());
+                snapshot.push_back(staff->skyline().south().max());
+            }
+
+            for (const MeasureBase* mb : system->measures()) {
+                snapshot.push_back(mb->x());
+                snapshot.push_back(mb->width());
+
+                if (!mb->isMeasure()) {
+                    continue;
+                }
+
+                for (const Segment* s = toMeasure(mb)->first(); s; s = s->next()) {
+                    snapshot.push_back(s->x());
+                    snapshot.push_back(s->width());
+                }
+            }
+        }
+
+        return snapshot;
+    }
+};
+
+//---------------------------------------------------------
+//   parallelLayoutMatchesSerial
+//    the measures and staves of a system are laid out concurrently
+//    on a full relayout, which must not change the result
+//---------------------------------------------------------
+
+TEST_F(Engraving_ParallelLayoutTests, parallelLayoutMatchesSerial)
+{
+    // [GIVEN] Scores with many measures and staves per system
+    const String vtestDir = ScoreRW::rootPath() + u"/../../../vtest/scores/";
+    const std::vector<String> scores = {
+        ScoreRW::rootPath() + u"/" + PARALLEL_LAYOUT_SCORE,
+        vtestDir + u"mmrest-1.mscx",
+        vtestDir + u"bravura-10.mscx",
+        vtestDir + u"barline-1.mscx",
+        vtestDir + u"system-7.mscx",
+        vtestDir + u"measure-repeat-3.mscx",
+    };
+
+    for (const String& path : scores) {
+        MasterScore* score = ScoreRW::readScore(path, true);
+        ASSERT_TRUE(score) << path.toStdString();
+
+        // [WHEN] The score is laid out serially, then concurrently
+        MScore::useParallelLayout = false;
+        score->doLayout();
+        std::vector<double> serial = layoutSnapshot(score);
+
+        MScore::useParallelLayout = true;
+        score->doLayout();
+        std::vector<double> parallel = layoutSnapshot(score);
+
+        // [THEN] The layout is the same
+        EXPECT_FALSE(serial.empty()) << path.toStdString();
+        ASSERT_EQ(serial.size(), parallel.size()) << path.toStdString();
+        for (size_t i = 0; i < serial.size(); ++i) {
+            EXPECT_EQ(serial[i], parallel[i]) << path.toStdString() << " at " << i;
+        }
+
+        delete score;
+    }
+}
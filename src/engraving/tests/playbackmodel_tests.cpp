@@ -22,10 +22,12 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <map>
 #include <memory>
 
 #include "async/asyncable.h"
 #include "async/channel.h"
+#include "async/processevents.h"
 #include "mpe/tests/utils/articulationutils.h"
 #include "mpe/tests/mocks/articulationprofilesrepositorymock.h"
 
@@ -35,6 +37,7 @@
 #include "libmscore/chord.h"
 
 #include "playback/playbackmodel.h"
+#include "playback/utils/arrangementutils.h"
 
 using ::testing::NiceMock;
 using ::testing::Return;
@@ -693,3 +696,207 @@ TEST_F(Engraving_PlaybackModelTests, Playback_Setup_Data_MultiInstrument)
         }
     }
 }
+
+/**
+ * @brief PlaybackModelTests_Tempo_Change_Remaps_Events
+ * @details In this case we're building up a playback model of a simple score - Violin, 4/4, 120bpm, Treble Cleff, 4 measures
+ *          Additionally, there is a simple repeat from measure 2 up to measure 3.
+ *
+ *          When the model will be loaded we'll change the tempo at the beginning of the 3-rd measure. The events rendered before
+ *          the change are moved in time instead of being rendered again, so that the result must match a freshly loaded model
+ */
+TEST_F(Engraving_PlaybackModelTests, Tempo_Change_Remaps_Events)
+{
+    // [GIVEN] Simple piece of score (Violin, 4/4, 120 bpm, Treble Cleff)
+    Score* score = ScoreRW::readScore(PLAYBACK_MODEL_TEST_FILES_DIR + "repeat_range/repeat_range.mscx");
+
+    ASSERT_TRUE(score);
+    ASSERT_EQ(score->parts().size(), 1);
+
+    const Part* part = score->parts().at(0);
+    ASSERT_TRUE(part);
+
+    // [GIVEN] The articulation profiles repository will be returning profiles for StringsArticulation family
+    EXPECT_CALL(*m_repositoryMock, defaultProfile(_)).WillRepeatedly(Return(m_defaultProfile));
+
+    // [GIVEN] The playback model requested to be loaded
+    PlaybackModel model;
+    model.setprofilesRepository(m_repositoryMock);
+    model.load(score);
+
+    InstrumentTrackId trackId = { part->id(), part->instrumentId().toStdString() };
+    timestamp_t lastTimestampBefore = model.resolveTrackPlaybackData(trackId).originEvents.rbegin()->first;
+
+    // [WHEN] The tempo has been changed on the 3-rd measure
+    score->setTempo(Fraction(2, 1), BeatsPerSecond(3.0));
+
+    ScoreChangesRange range;
+    range.tickFrom = 3840;
+    range.tickTo = 3840;
+    range.staffIdxFrom = 0;
+    range.staffIdxTo = 0;
+    range.changedTypes = { ElementType::TEMPO_TEXT };
+
+    score->changesChannel().send(range);
+
+    // [WHEN] Another model has been loaded from scratch
+    PlaybackModel expectedModel;
+    expectedModel.setprofilesRepository(m_repositoryMock);
+    expectedModel.load(score);
+
+    const PlaybackEventsMap& result = model.resolveTrackPlaybackData(trackId).originEvents;
+    const PlaybackEventsMap& expected = expectedModel.resolveTrackPlaybackData(trackId).originEvents;
+
+    // [THEN] The events have been moved
+    EXPECT_LT(result.rbegin()->first, lastTimestampBefore);
+
+    // [THEN] The moved events match the freshly rendered ones, up to the rounding of timestamps
+    ASSERT_EQ(result.size(), expected.size());
+
+    for (auto it = result.cbegin(), expectedIt = expected.cbegin(); it != result.cend(); ++it, ++expectedIt) {
+        EXPECT_LE(std::abs(it->first - expectedIt->first), 1);
+        ASSERT_EQ(it->second.size(), expectedIt->second.size());
+
+        for (size_t i = 0; i < it->second.size(); ++i) {
+            const NoteEvent& event = std::get<NoteEvent>(it->second.at(i));
+            const NoteEvent& expectedEvent = std::get<NoteEvent>(expectedIt->second.at(i));
+
+            EXPECT_EQ(event.arrangementCtx().nominalDuration, expectedEvent.arrangementCtx().nominalDuration);
+            EXPECT_EQ(event.pitchCtx().nominalPitchLevel, expectedEvent.pitchCtx().nominalPitchLevel);
+        }
+    }
+}
+
+/**
+ * @brief PlaybackModelTests_Parallel_Rendering_Matches_Serial
+ * @details In this case we're building up a playback model of a score with 12 instruments, so that the parts are rendered
+ *          in parallel on load. Then every part is changed on its own, so that the parts are rendered again one by one.
+ *          The result of both must be the same
+ */
+TEST_F(Engraving_PlaybackModelTests, Parallel_Rendering_Matches_Serial)
+{
+    // [GIVEN] Score with 12 instruments
+    Score* score = ScoreRW::readScore(
+        PLAYBACK_MODEL_TEST_FILES_DIR + "playback_setup_instruments/playback_setup_instruments.mscx");
+
+    ASSERT_TRUE(score);
+    ASSERT_EQ(score->parts().size(), 12);
+
+    // [GIVEN] The articulation profiles repository will be returning the default profile for every family
+    EXPECT_CALL(*m_repositoryMock, defaultProfile(_)).WillRepeatedly(Return(m_defaultProfile));
+
+    // [GIVEN] The playback model requested to be loaded, all the parts are rendered in parallel
+    PlaybackModel model;
+    model.setprofilesRepository(m_repositoryMock);
+    model.load(score);
+
+    std::map<InstrumentTrackId, PlaybackEventsMap> parallelEvents;
+    for (const Part* part : score->parts()) {
+        for (const InstrumentTrackId& trackId : part->instrumentTrackIdSet()) {
+            parallelEvents.emplace(trackId, model.resolveTrackPlaybackData(trackId).originEvents);
+        }
+    }
+
+    // [WHEN] Every part has been changed on its own, so that the parts are rendered one by one
+    for (const Part* part : score->parts()) {
+        ScoreChangesRange range;
+        range.tickFrom = 0;
+        range.tickTo = score->lastMeasure()->endTick().ticks();
+        range.staffIdxFrom = part->startTrack() / VOICES;
+        range.staffIdxTo = part->endTrack() / VOICES - 1;
+        range.changedTypes = { ElementType::NOTE };
+
+        score->changesChannel().send(range);
+    }
+
+    // [THEN] The events rendered one by one match the ones rendered in parallel
+    for (const auto& pair : parallelEvents) {
+        EXPECT_FALSE(pair.second.empty());
+        EXPECT_EQ(model.resolveTrackPlaybackData(pair.first).originEvents, pair.second);
+    }
+}
+
+/**
+ * @brief PlaybackModelTests_Windowed_Rendering_And_Cancellation
+ * @details In this case we're building up a playback model of a score with 12 staves and 108 measures, which is too long
+ *          to be rendered on load at once. Only the first window of measures is rendered right away, the rest is rendered
+ *          by the queued calls. When the whole score is changed, the windows which are still pending are cancelled
+ */
+TEST_F(Engraving_PlaybackModelTests, Windowed_Rendering_And_Cancellation)
+{
+    // [GIVEN] Score with 12 staves and 108 measures
+    Score* score = ScoreRW::readScore(u"concertpitch_data/concertpitchbenchmark.mscx");
+
+    ASSERT_TRUE(score);
+    ASSERT_EQ(score->nmeasures(), 108);
+
+    // [GIVEN] The end of the first rendering window (16 measures)
+    const Measure* firstNotRenderedMeasure = score->crMeasure(16);
+    ASSERT_TRUE(firstNotRenderedMeasure);
+    timestamp_t firstWindowEnd = timestampFromTicks(score, firstNotRenderedMeasure->tick().ticks());
+
+    // [GIVEN] The articulation profiles repository will be returning the default profile for every family
+    EXPECT_CALL(*m_repositoryMock, defaultProfile(_)).WillRepeatedly(Return(m_defaultProfile));
+
+    std::vector<InstrumentTrackId> trackIds;
+    for (const Part* part : score->parts()) {
+        for (const InstrumentTrackId& trackId : part->instrumentTrackIdSet()) {
+            trackIds.push_back(trackId);
+        }
+    }
+
+    // [WHEN] The playback model requested to be loaded
+    PlaybackModel model;
+    model.setprofilesRepository(m_repositoryMock);
+    model.load(score);
+
+    // [THEN] Only the events of the first window have been rendered
+    for (const InstrumentTrackId& trackId : trackIds) {
+        const PlaybackEventsMap& events = model.resolveTrackPlaybackData(trackId).originEvents;
+        ASSERT_FALSE(events.empty());
+        EXPECT_LT(events.rbegin()->first, firstWindowEnd);
+    }
+
+    // [WHEN] The queued calls have been processed, one window per call
+    for (size_t i = 0; i < score->nmeasures(); ++i) {
+        async::processEvents();
+    }
+
+    // [THEN] The whole score has been rendered
+    std::map<InstrumentTrackId, PlaybackEventsMap> renderedEvents;
+    for (const InstrumentTrackId& trackId : trackIds) {
+        const PlaybackEventsMap& events = model.resolveTrackPlaybackData(trackId).originEvents;
+        EXPECT_GT(events.rbegin()->first, firstWindowEnd);
+
+        renderedEvents.emplace(trackId, events);
+    }
+
+    // [WHEN] Another model has been loaded and the whole score has been changed right away
+    PlaybackModel changedModel;
+    changedModel.setprofilesRepository(m_repositoryMock);
+    changedModel.load(score);
+
+    ScoreChangesRange range;
+    range.tickFrom = 0;
+    range.tickTo = score->lastMeasure()->endTick().ticks();
+    range.staffIdxFrom = 0;
+    range.staffIdxTo = score->nstaves() - 1;
+    range.changedTypes = { ElementType::NOTE };
+
+    score->changesChannel().send(range);
+
+    // [THEN] The whole score has been rendered at once and it matches the events rendered window by window
+    for (const InstrumentTrackId& trackId : trackIds) {
+        EXPECT_EQ(changedModel.resolveTrackPlaybackData(trackId).originEvents, renderedEvents.at(trackId));
+    }
+
+    // [WHEN] The queued calls have been processed again
+    for (size_t i = 0; i < score->nmeasures(); ++i) {
+        async::processEvents();
+    }
+
+    // [THEN] The cancelled windows haven't been rendered again on top of the changed events
+    for (const InstrumentTrackId& trackId : trackIds) {
+        EXPECT_EQ(changedModel.resolveTrackPlaybackData(trackId).originEvents, renderedEvents.at(trackId));
+    }
+}
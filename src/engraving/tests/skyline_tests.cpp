@@ -0,0 +1,152 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "io/dir.h"
+
+#include "libmscore/masterscore.h"
+#include "libmscore/page.h"
+#include "libmscore/skyline.h"
+#include "libmscore/system.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu;
+using namespace mu::engraving;
+
+static const String VTEST_SCORES_DIR("../../../vtest/scores");
+
+class Engraving_SkylineTests : public ::testing::Test
+{
+public:
+    static void checkMinDistance(SkylineLine& south, SkylineLine& north, const String& what);
+};
+
+//---------------------------------------------------------
+//   checkMinDistance
+//    the flat kernel has to give exactly the same result
+//    as the segment walk
+//---------------------------------------------------------
+
+void Engraving_SkylineTests::checkMinDistance(SkylineLine& south, SkylineLine& north, const String& what)
+{
+    MScore::useFlatSkylines = false;
+    double segmentDist = south.minDistance(north);
+
+    MScore::useFlatSkylines = true;
+    south.buildFlat();
+    north.buildFlat();
+    double flatDist = south.minDistance(north);
+
+    EXPECT_EQ(segmentDist, flatDist) << what.toStdString();
+}
+
+//---------------------------------------------------------
+//   generatedLines
+//---------------------------------------------------------
+
+TEST_F(Engraving_SkylineTests, generatedLines)
+{
+    // simple LCG to get reproducible shapes
+    uint32_t state = 12345;
+    auto next = [&state](double max) {
+        state = state * 1103515245u + 12345u;
+        return double((state >> 8) % 10000) / 10000.0 * max;
+    };
+
+    MScore::useFlatSkylines = true;
+
+    for (int run = 0; run < 50; ++run) {
+        Skyline upper;
+        Skyline lower;
+
+        Shape upperShape;
+        Shape lowerShape;
+        for (int i = 0; i < run * 4 + 1; ++i) {
+            upperShape.add(RectF(next(300.0) - 10.0, next(40.0), next(30.0), next(20.0)));
+            lowerShape.add(RectF(next(300.0) - 10.0, next(40.0) + 10.0, next(30.0), next(20.0)));
+        }
+        upper.add(upperShape);
+        lower.add(lowerShape);
+
+        upper.buildFlat();
+        lower.buildFlat();
+
+        // single segments added after the build, the outdated flat copy must not be used
+        upper.add(RectF(next(300.0), next(40.0), next(10.0), next(10.0)));
+        lower.add(RectF(next(300.0), next(40.0), next(10.0), next(10.0)));
+
+        double outdatedDist = upper.south().minDistance(lower.north());
+        MScore::useFlatSkylines = false;
+        EXPECT_EQ(outdatedDist, upper.south().minDistance(lower.north())) << run;
+        MScore::useFlatSkylines = true;
+
+        checkMinDistance(upper.south(), lower.north(), String(u"run %1").arg(run));
+        checkMinDistance(lower.south(), upper.north(), String(u"reversed run %1").arg(run));
+    }
+
+    MScore::useFlatSkylines = false;
+}
+
+//---------------------------------------------------------
+//   vtestScores
+//    compare the kernels for all the staff skylines of the
+//    vtest scores, between the staves of a system and
+//    between consecutive systems
+//---------------------------------------------------------
+
+TEST_F(Engraving_SkylineTests, vtestScores)
+{
+    RetVal<io::paths_t> files = io::Dir::scanFiles(ScoreRW::rootPath() + u"/" + VTEST_SCORES_DIR, { "*.mscx" },
+                                                   io::ScanMode::FilesInCurrentDir);
+    ASSERT_TRUE(files.ret);
+
+    MScore::useFlatSkylines = true;
+
+    for (const io::path_t& file : files.val) {
+        MasterScore* score = ScoreRW::readScore(file.toString(), true);
+        if (!score) {
+            continue;
+        }
+
+        for (const Page* page : score->pages()) {
+            const System* prevSystem = nullptr;
+            for (const System* system : page->systems()) {
+                const std::vector<SysStaff*>& staves = system->staves();
+                for (size_t i = 0; i + 1 < staves.size(); ++i) {
+                    checkMinDistance(staves[i]->skyline().south(), staves[i + 1]->skyline().north(),
+                                     file.toString() + u" staff " + String::number(i));
+                }
+                if (prevSystem && !prevSystem->staves().empty() && !staves.empty()) {
+                    checkMinDistance(prevSystem->staves().back()->skyline().south(), staves.front()->skyline().north(),
+                                     file.toString() + u" systems");
+                }
+                prevSystem = system;
+            }
+        }
+
+        delete score;
+    }
+
+    MScore::useFlatSkylines = false;
+}
@@ -0,0 +1,108 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "infrastructure/smallvector.h"
+
+using namespace mu::engraving;
+
+class Engraving_SmallVectorTests : public ::testing::Test
+{
+};
+
+//---------------------------------------------------------
+//   appendGrowsBeyondInlineCapacity
+//---------------------------------------------------------
+
+TEST_F(Engraving_SmallVectorTests, appendGrowsBeyondInlineCapacity)
+{
+    SmallVector<std::string, 2> v;
+    v.push_back("a");
+    v.push_back("b");
+    EXPECT_TRUE(v.isInline());
+
+    v.push_back("c");
+    EXPECT_FALSE(v.isInline());
+
+    ASSERT_EQ(v.size(), 3);
+    EXPECT_EQ(v[0], "a");
+    EXPECT_EQ(v[1], "b");
+    EXPECT_EQ(v[2], "c");
+}
+
+//---------------------------------------------------------
+//   insertOwnElements
+//    the inserted range may point into the vector itself,
+//    also when it has to grow
+//---------------------------------------------------------
+
+TEST_F(Engraving_SmallVectorTests, insertOwnElements)
+{
+    SmallVector<std::string, 2> v;
+    v.push_back("a");
+    v.push_back("b");
+
+    v.insert(v.begin(), v.begin(), v.end());
+
+    ASSERT_EQ(v.size(), 4);
+    EXPECT_EQ(v[0], "a");
+    EXPECT_EQ(v[1], "b");
+    EXPECT_EQ(v[2], "a");
+    EXPECT_EQ(v[3], "b");
+
+    v.insert(v.end(), v.begin() + 1, v.begin() + 3);
+
+    ASSERT_EQ(v.size(), 6);
+    EXPECT_EQ(v[4], "b");
+    EXPECT_EQ(v[5], "a");
+}
+
+//---------------------------------------------------------
+//   copyAndMove
+//---------------------------------------------------------
+
+TEST_F(Engraving_SmallVectorTests, copyAndMove)
+{
+    SmallVector<std::string, 1> heap;
+    heap.push_back("a");
+    heap.push_back("b");
+
+    SmallVector<std::string, 1> copy = heap;
+    SmallVector<std::string, 1> moved = std::move(heap);
+
+    EXPECT_TRUE(heap.empty());
+    ASSERT_EQ(copy.size(), 2);
+    ASSERT_EQ(moved.size(), 2);
+    EXPECT_EQ(copy[1], "b");
+    EXPECT_EQ(moved[1], "b");
+
+    SmallVector<std::string, 1> inlineVector;
+    inlineVector.push_back("c");
+    moved = std::move(inlineVector);
+
+    ASSERT_EQ(moved.size(), 1);
+    EXPECT_EQ(moved[0], "c");
+    EXPECT_TRUE(moved.isInline());
+}
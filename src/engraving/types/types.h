@@ -1007,6 +1007,13 @@ struct PartAudioSettingsCompat {
 struct SettingsCompat {
     std::map<ID /*partid*/, PartAudioSettingsCompat> audioSettings;
 };
+
+struct ExcerptLoadStatistics {
+    String name;
+    size_t dataSize = 0;
+    int64_t readFilesTimeMs = 0; // reading (decompressing) the excerpt files
+    int64_t readScoreTimeMs = 0; // reading the part score from them
+};
 } // mu::engraving
 
 template<>
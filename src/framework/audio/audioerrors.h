@@ -60,6 +60,7 @@ enum class Err {
     NoAudioToExport = 349,
     ErrorEncode = 350,
     UnknownPluginType = 351,
+    IncompatibleSoundTrackFormats = 352,
 
     // clock
     InvalidTimeLoop = 360,
@@ -0,0 +1,129 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "audiosignalmeter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace mu::audio;
+
+AudioSignalMeter::AudioSignalMeter(size_t decimation)
+{
+    setDecimation(decimation);
+}
+
+size_t AudioSignalMeter::decimation() const
+{
+    return m_decimation.load(std::memory_order_relaxed);
+}
+
+void AudioSignalMeter::setDecimation(size_t blocksCount)
+{
+    m_decimation.store(std::max(blocksCount, size_t(1)), std::memory_order_relaxed);
+}
+
+void AudioSignalMeter::write(audioch_t audioChNum, float peak, float squaredSum, samples_t samplesCount)
+{
+    if (audioChNum >= MAX_AUDIO_CHANNELS) {
+        return;
+    }
+
+    Channel& ch = m_channels[audioChNum];
+    Accumulator& acc = ch.accumulator;
+
+    acc.peak = std::max(acc.peak, std::abs(peak));
+    acc.squaredSum += squaredSum;
+    acc.samplesCount += samplesCount;
+    acc.blocksCount++;
+
+    if (acc.blocksCount < m_decimation.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    Frame frame;
+    frame.peak = acc.peak;
+    frame.rms = acc.samplesCount > 0 ? std::sqrt(acc.squaredSum / acc.samplesCount) : 0.f;
+    acc = Accumulator();
+
+    uint64_t index = ch.writtenFramesCount.load(std::memory_order_relaxed);
+    ch.frames[index % FRAMES_COUNT].store(pack(frame), std::memory_order_relaxed);
+    ch.writtenFramesCount.store(index + 1, std::memory_order_release);
+}
+
+bool AudioSignalMeter::read(audioch_t audioChNum, uint64_t& readFramesCount, Frame& frame) const
+{
+    if (audioChNum >= MAX_AUDIO_CHANNELS) {
+        return false;
+    }
+
+    const Channel& ch = m_channels[audioChNum];
+
+    uint64_t written = ch.writtenFramesCount.load(std::memory_order_acquire);
+    if (written == readFramesCount) {
+        return false;
+    }
+
+    //! NOTE If the reader is late, the overwritten frames are lost
+    uint64_t from = std::max(readFramesCount, written > FRAMES_COUNT ? written - FRAMES_COUNT : 0);
+
+    frame = Frame();
+    for (uint64_t i = from; i < written; ++i) {
+        Frame f = unpack(ch.frames[i % FRAMES_COUNT].load(std::memory_order_relaxed));
+        frame.peak = std::max(frame.peak, f.peak);
+        frame.rms = std::max(frame.rms, f.rms);
+    }
+
+    readFramesCount = written;
+
+    return true;
+}
+
+AudioSignalVal AudioSignalMeter::signalVal(const Frame& frame)
+{
+    AudioSignalVal val;
+    val.amplitude = frame.rms;
+    val.pressure = frame.rms > 0.f ? 20.f * std::log10(frame.rms) : MINIMUM_OPERABLE_DBFS_LEVEL;
+    val.pressure = std::max(val.pressure, MINIMUM_OPERABLE_DBFS_LEVEL);
+    return val;
+}
+
+//! NOTE A frame is stored in one atomic word, so it is never read half written
+uint64_t AudioSignalMeter::pack(const Frame& frame)
+{
+    uint32_t peak = 0;
+    uint32_t rms = 0;
+    std::memcpy(&peak, &frame.peak, sizeof(peak));
+    std::memcpy(&rms, &frame.rms, sizeof(rms));
+    return (static_cast<uint64_t>(peak) << 32) | rms;
+}
+
+AudioSignalMeter::Frame AudioSignalMeter::unpack(uint64_t value)
+{
+    uint32_t peak = static_cast<uint32_t>(value >> 32);
+    uint32_t rms = static_cast<uint32_t>(value);
+
+    Frame frame;
+    std::memcpy(&frame.peak, &peak, sizeof(peak));
+    std::memcpy(&frame.rms, &rms, sizeof(rms));
+    return frame;
+}
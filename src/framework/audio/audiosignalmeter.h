@@ -0,0 +1,92 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_AUDIOSIGNALMETER_H
+#define MU_AUDIO_AUDIOSIGNALMETER_H
+
+#include <array>
+#include <atomic>
+#include <memory>
+
+#include "audiotypes.h"
+
+namespace mu::audio {
+//! NOTE Signal levels of a mixer channel. The audio worker writes them on every processed block,
+//! the UI reads them at display rate, nothing is sent between the threads.
+//! The blocks are summarized into frames (peak and RMS), every frame covers `decimation` blocks,
+//! the last FRAMES_COUNT frames of each audio channel are kept in a ring.
+//! There is one writer (the thread processing the mixer channel), the readers keep their own read positions,
+//! neither of them blocks or allocates
+class AudioSignalMeter
+{
+public:
+    static constexpr audioch_t MAX_AUDIO_CHANNELS = 8;
+    static constexpr size_t FRAMES_COUNT = 64;
+
+    struct Frame {
+        float peak = 0.f;
+        float rms = 0.f;
+    };
+
+    explicit AudioSignalMeter(size_t decimation = 1);
+
+    size_t decimation() const;
+    void setDecimation(size_t blocksCount);
+
+    // Writer
+    void write(audioch_t audioChNum, float peak, float squaredSum, samples_t samplesCount);
+
+    // Readers
+    //! NOTE The loudest frame among the frames written since the given read position,
+    //! returns false if there are none
+    bool read(audioch_t audioChNum, uint64_t& readFramesCount, Frame& frame) const;
+
+    //! NOTE Pressure of the RMS in dBFS, not less than MINIMUM_OPERABLE_DBFS_LEVEL
+    static AudioSignalVal signalVal(const Frame& frame);
+
+    static constexpr volume_dbfs_t MINIMUM_OPERABLE_DBFS_LEVEL = -100.f;
+
+private:
+    static uint64_t pack(const Frame& frame);
+    static Frame unpack(uint64_t value);
+
+    struct Accumulator {
+        float peak = 0.f;
+        float squaredSum = 0.f;
+        samples_t samplesCount = 0;
+        size_t blocksCount = 0;
+    };
+
+    struct Channel {
+        Accumulator accumulator;
+
+        std::array<std::atomic<uint64_t>, FRAMES_COUNT> frames {};
+        std::atomic<uint64_t> writtenFramesCount { 0 };
+    };
+
+    std::atomic<size_t> m_decimation { 1 };
+    std::array<Channel, MAX_AUDIO_CHANNELS> m_channels;
+};
+
+using AudioSignalMeterPtr = std::shared_ptr<AudioSignalMeter>;
+}
+
+#endif // MU_AUDIO_AUDIOSIGNALMETER_H
@@ -90,6 +90,27 @@ struct SoundTrackFormat {
     }
 };
 
+static constexpr TrackId MASTER_MIX_TRACK_ID = -1;
+
+//! NOTE Stands for the stems of all the track channels of a sequence. Such a target is expanded into a stem target
+//! per track, the destination of each one is the target destination, then the track name, then stemsSuffix
+static constexpr TrackId ALL_TRACKS_STEMS_ID = -2;
+
+//! NOTE One output of an export pass: either the master mix or the stem of a single track
+struct SoundTrackTarget {
+    io::path_t destination;
+    SoundTrackFormat format;
+    TrackId trackId = MASTER_MIX_TRACK_ID;
+    io::path_t stemsSuffix; // ALL_TRACKS_STEMS_ID only
+
+    bool isStem() const
+    {
+        return trackId != MASTER_MIX_TRACK_ID;
+    }
+};
+
+using SoundTrackTargetList = std::vector<SoundTrackTarget>;
+
 using AudioSourceName = std::string;
 using AudioResourceId = std::string;
 using AudioResourceIdList = std::vector<AudioResourceId>;
@@ -354,38 +375,6 @@ struct AudioSignalVal {
     volume_dbfs_t pressure = 0.f;
 };
 
-using AudioSignalChanges = async::Channel<audioch_t, AudioSignalVal>;
-
-struct AudioSignalsNotifier {
-    void updateSignalValues(const audioch_t audioChNumber, const float newAmplitude, const volume_dbfs_t newPressure)
-    {
-        AudioSignalVal& signalVal = m_signalValuesMap[audioChNumber];
-
-        volume_dbfs_t validatedPressure = std::max(newPressure, MINIMUM_OPERABLE_DBFS_LEVEL);
-
-        if (RealIsEqual(signalVal.pressure, validatedPressure)) {
-            return;
-        }
-
-        if (std::abs(signalVal.pressure - validatedPressure) < PRESSURE_MINIMAL_VALUABLE_DIFF) {
-            return;
-        }
-
-        signalVal.amplitude = newAmplitude;
-        signalVal.pressure = validatedPressure;
-
-        audioSignalChanges.send(audioChNumber, signalVal);
-    }
-
-    AudioSignalChanges audioSignalChanges;
-
-private:
-    static constexpr volume_dbfs_t PRESSURE_MINIMAL_VALUABLE_DIFF = 2.5f;
-    static constexpr volume_dbfs_t MINIMUM_OPERABLE_DBFS_LEVEL = -100.f;
-
-    std::map<audioch_t, AudioSignalVal> m_signalValuesMap;
-};
-
 enum class PlaybackStatus {
     Stopped = 0,
     Paused,
@@ -30,6 +30,7 @@
 #include "async/channel.h"
 
 #include "audiotypes.h"
+#include "audiosignalmeter.h"
 
 namespace mu::audio {
 class IAudioOutput
@@ -48,11 +49,17 @@ public:
 
     virtual async::Promise<AudioResourceMetaList> availableOutputResources() const = 0;
 
-    virtual async::Promise<AudioSignalChanges> signalChanges(const TrackSequenceId sequenceId, const TrackId trackId) const = 0;
-    virtual async::Promise<AudioSignalChanges> masterSignalChanges() const = 0;
+    virtual async::Promise<AudioSignalMeterPtr> signalMeter(const TrackSequenceId sequenceId, const TrackId trackId) const = 0;
+    virtual async::Promise<AudioSignalMeterPtr> masterSignalMeter() const = 0;
+
+    //! NOTE Number of blocks which took longer to mix than their own duration
+    virtual async::Promise<uint64_t> overrunsCount() const = 0;
 
     virtual async::Promise<bool> saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                                 const SoundTrackFormat& format) = 0;
+
+    //! NOTE Renders the sequence once and writes all the targets (master mix in several formats and/or track stems)
+    virtual async::Promise<bool> saveSoundTracks(const TrackSequenceId sequenceId, const SoundTrackTargetList& targets) = 0;
     virtual void abortSavingAllSoundTracks() = 0;
 
     virtual framework::Progress saveSoundTrackProgress(const TrackSequenceId sequenceId) = 0;
@@ -39,6 +39,8 @@ public:
     static void setupWorkerThread();
     static std::thread::id workerThread();
     static bool isWorkerThread();
+
+    static void setupWorkerPoolThread();
 };
 }
 
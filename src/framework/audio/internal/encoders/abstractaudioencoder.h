@@ -29,11 +29,13 @@
 
 #include "log.h"
 #include "io/path.h"
-#include "progress.h"
 
 #include "audiotypes.h"
 
 namespace mu::audio::encode {
+//! NOTE Encoders are fed chunk by chunk: encode() is called once per rendered block,
+//! flush() once at the end. totalSamplesNumber passed to init() is an estimate
+//! of the samples per channel, used for the headers only
 class AbstractAudioEncoder
 {
 public:
@@ -52,12 +54,12 @@ public:
 
         m_format = format;
 
+        m_totalSamplesNumber = totalSamplesNumber;
+
         if (!openDestination(path)) {
             return false;
         }
 
-        prepareOutputBuffer(totalSamplesNumber);
-
         return true;
     }
 
@@ -66,16 +68,13 @@ public:
         return m_format;
     }
 
+    //! NOTE The input is interleaved, it holds samplesPerChannel * audioChannelsNumber samples.
+    //! Returns the number of consumed samples per channel (not the interleaved samples), 0 on failure
     virtual size_t encode(samples_t samplesPerChannel, const float* input) = 0;
     virtual size_t flush() = 0;
 
-    framework::Progress progress()
-    {
-        return m_progress;
-    }
-
 protected:
-    virtual size_t requiredOutputBufferSize(samples_t totalSamplesNumber) const = 0;
+    virtual size_t requiredOutputBufferSize(samples_t samplesPerChannel) const = 0;
 
     virtual void prepareWriting()
     {
@@ -106,9 +105,14 @@ protected:
         return true;
     }
 
-    virtual void prepareOutputBuffer(const samples_t totalSamplesNumber)
+    //! NOTE The buffer only grows up to the size required by the biggest chunk
+    void prepareOutputBuffer(const samples_t samplesPerChannel)
     {
-        m_outputBuffer.resize(requiredOutputBufferSize(totalSamplesNumber));
+        size_t requiredSize = requiredOutputBufferSize(samplesPerChannel);
+
+        if (m_outputBuffer.size() < requiredSize) {
+            m_outputBuffer.resize(requiredSize);
+        }
     }
 
     virtual void closeDestination()
@@ -124,7 +128,7 @@ protected:
     std::vector<unsigned char> m_outputBuffer;
 
     SoundTrackFormat m_format;
-    framework::Progress m_progress;
+    samples_t m_totalSamplesNumber = 0;
 
     std::string m_locale;
 };
@@ -32,28 +32,7 @@
 using namespace mu::audio;
 using namespace mu::audio::encode;
 
-struct FlacHandler : public FLAC::Encoder::File
-{
-    using ProgressCallBack = std::function<void (int64_t /*current*/, int64_t /*total*/)>;
-
-    FlacHandler(const ProgressCallBack& progressCallBack)
-        : FLAC::Encoder::File(), m_callBack(progressCallBack) {}
-
-    void progress_callback(FLAC__uint64 bytes_written,
-                           FLAC__uint64 samples_written,
-                           uint32_t frames_written,
-                           uint32_t total_frames_estimate) override
-    {
-        LOGI() << "wrote " << bytes_written << " bytes, "
-               << samples_written << " samples, "
-               << frames_written << " frames\n"
-               << "TOTAL FRAMES: " << total_frames_estimate;
-
-        m_callBack(frames_written * 4, total_frames_estimate);
-    }
-
-    ProgressCallBack m_callBack;
-};
+struct FlacHandler : public FLAC::Encoder::File {};
 
 bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, const samples_t totalSamplesNumber)
 {
@@ -63,9 +42,7 @@ bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, c
 
     m_format = format;
 
-    m_flac = new FlacHandler([this](int64_t current, int64_t total){
-        m_progress.progressChanged.send(current, total, "");
-    });
+    m_flac = new FlacHandler();
 
     if (!m_flac->set_verify(true)
         || !m_flac->set_compression_level(0)
@@ -88,12 +65,12 @@ bool FlacEncoder::init(const io::path_t& path, const SoundTrackFormat& format, c
     metadata[1]->length = 1234; /* set the padding length */
     m_flac->set_metadata(metadata, 2);
 
+    m_totalSamplesNumber = totalSamplesNumber;
+
     if (!openDestination(path)) {
         return false;
     }
 
-    prepareOutputBuffer(totalSamplesNumber);
-
     return true;
 }
 
@@ -103,30 +80,21 @@ size_t FlacEncoder::encode(samples_t samplesPerChannel, const float* input)
         return 0;
     }
 
-    size_t result = 0;
-    size_t totalSamplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
-    uint32_t frameSize = 1024;
-    size_t stepSize = frameSize * m_format.audioChannelsNumber;
+    size_t samplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
 
-    std::vector<FLAC__int32> buff(samplesPerChannel * sizeof(float));
-
-    for (size_t i = 0; i < buff.size(); ++i) {
-        buff[i] = static_cast<FLAC__int32>(dsp::convertFloatSamples<FLAC__int16>(input[i]));
+    if (m_convertedBuffer.size() < samplesNumber) {
+        m_convertedBuffer.resize(samplesNumber);
     }
 
-    std::vector<FLAC__int32> intermBuff(stepSize);
-
-    for (size_t i = 0; i < totalSamplesNumber; i += stepSize) {
-        std::copy(buff.data() + i, buff.data() + i + stepSize, intermBuff.data());
+    for (size_t i = 0; i < samplesNumber; ++i) {
+        m_convertedBuffer[i] = static_cast<FLAC__int32>(dsp::convertFloatSamples<FLAC__int16>(input[i]));
+    }
 
-        if (m_flac->process_interleaved(intermBuff.data(), frameSize)) {
-            result += stepSize;
-        } else {
-            break;
-        }
+    if (!m_flac->process_interleaved(m_convertedBuffer.data(), static_cast<uint32_t>(samplesPerChannel))) {
+        return 0;
     }
 
-    return result;
+    return samplesPerChannel;
 }
 
 size_t FlacEncoder::flush()
@@ -135,9 +103,9 @@ size_t FlacEncoder::flush()
     return 0;
 }
 
-size_t FlacEncoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t FlacEncoder::requiredOutputBufferSize(samples_t) const
 {
-    return totalSamplesNumber;
+    return 0;
 }
 
 bool FlacEncoder::openDestination(const io::path_t& path)
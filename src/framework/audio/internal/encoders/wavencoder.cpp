@@ -22,10 +22,6 @@
 
 #include "wavencoder.h"
 
-#include <map>
-
-#include "async/async.h"
-
 using namespace mu::audio;
 using namespace mu::audio::encode;
 
@@ -89,48 +85,50 @@ size_t WavEncoder::encode(samples_t samplesPerChannel, const float* input)
         return 0;
     }
 
-    WavHeader header;
-    header.chunkSize = 18; // 18 is 2 bytes more to include cbsize field / extension size
-    header.bitsPerSample = 32;
-    header.code = 3; // IEEE_FLOAT = 3, PCM = 1
-    header.audioChannelsNumber = m_format.audioChannelsNumber;
-    header.sampleRate = m_format.sampleRate;
-    header.samplesPerChannel = samplesPerChannel;
-
-    header.write(m_fileStream);
+    //! NOTE The samples are already interleaved 32-bit floats, exactly as they are stored in the file
+    size_t samplesNumber = samplesPerChannel * m_format.audioChannelsNumber;
+    m_fileStream.write(reinterpret_cast<const char*>(input), samplesNumber * sizeof(float));
 
-    int total = header.samplesPerChannel;
-    int progressStep = (total * 5) / 100; // every 5%
-    QVector<samples_t> progressValues;
-    for (samples_t sampleIdx = 0; sampleIdx < header.samplesPerChannel;) {
-        progressValues << sampleIdx;
-        sampleIdx += progressStep;
+    if (!m_fileStream.good()) {
+        return 0;
     }
 
-    for (samples_t sampleIdx = 0; sampleIdx < header.samplesPerChannel; ++sampleIdx) {
-        for (audioch_t audioChNum = 0; audioChNum < m_format.audioChannelsNumber; ++audioChNum) {
-            int idx = sampleIdx * m_format.audioChannelsNumber + audioChNum;
-            m_fileStream.write(reinterpret_cast<const char*>(input + idx), 4);
-        }
+    m_writtenSamplesPerChannel += samplesPerChannel;
 
-        if (progressValues.contains(sampleIdx)) {
-            m_progress.progressChanged.send(sampleIdx, total, "");
-        }
+    return samplesPerChannel;
+}
+
+size_t WavEncoder::flush()
+{
+    if (!m_fileStream.is_open()) {
+        return 0;
     }
 
-    return samplesPerChannel * m_format.audioChannelsNumber;
+    //! NOTE The real length is only known at the end, rewrite the header written on opening
+    m_fileStream.seekp(0, std::ios_base::beg);
+    writeHeader(m_writtenSamplesPerChannel);
+    m_fileStream.seekp(0, std::ios_base::end);
+    m_fileStream.flush();
+
+    return m_writtenSamplesPerChannel;
 }
 
-size_t WavEncoder::flush()
+void WavEncoder::writeHeader(samples_t samplesPerChannel)
 {
-    NOT_SUPPORTED;
+    WavHeader header;
+    header.chunkSize = 18; // 18 is 2 bytes more to include cbsize field / extension size
+    header.bitsPerSample = 32;
+    header.code = 3; // IEEE_FLOAT = 3, PCM = 1
+    header.audioChannelsNumber = m_format.audioChannelsNumber;
+    header.sampleRate = m_format.sampleRate;
+    header.samplesPerChannel = samplesPerChannel;
 
-    return 0;
+    header.write(m_fileStream);
 }
 
-size_t WavEncoder::requiredOutputBufferSize(samples_t totalSamplesNumber) const
+size_t WavEncoder::requiredOutputBufferSize(samples_t) const
 {
-    return totalSamplesNumber;
+    return 0;
 }
 
 bool WavEncoder::openDestination(const io::path_t& path)
@@ -138,7 +136,14 @@ bool WavEncoder::openDestination(const io::path_t& path)
     prepareWriting();
     m_fileStream.open(path.toStdString(), std::ios_base::binary);
 
-    return m_fileStream.is_open();
+    if (!m_fileStream.is_open()) {
+        return false;
+    }
+
+    m_writtenSamplesPerChannel = 0;
+    writeHeader(m_totalSamplesNumber);
+
+    return true;
 }
 
 void WavEncoder::closeDestination()
@@ -22,6 +22,10 @@
 
 #include "soundtrackwriter.h"
 
+#include <algorithm>
+
+#include "concurrency/taskscheduler.h"
+
 #include "internal/worker/audioengine.h"
 #include "internal/encoders/mp3encoder.h"
 #include "internal/encoders/oggencoder.h"
@@ -36,73 +40,86 @@ using namespace mu;
 using namespace mu::audio;
 using namespace mu::audio::soundtrack;
 
-static constexpr int PREPARE_STEP = 0;
-static constexpr int ENCODE_STEP = 1;
-
 SoundTrackWriter::SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format, const msecs_t totalDuration,
-                                   IAudioSourcePtr source)
-    : m_source(std::move(source))
+                                   MixerPtr mixer)
+    : SoundTrackWriter(SoundTrackTargetList { SoundTrackTarget { destination, format, MASTER_MIX_TRACK_ID } }, totalDuration,
+                       std::move(mixer))
+{
+}
+
+SoundTrackWriter::SoundTrackWriter(const SoundTrackTargetList& targets, const msecs_t totalDuration, MixerPtr mixer)
+    : m_mixer(std::move(mixer))
 {
-    if (!m_source) {
+    if (!m_mixer) {
+        m_initRet = make_ret(Err::InvalidAudioSource);
         return;
     }
 
-    samples_t totalSamplesNumber = (totalDuration / 1000000.f) * sizeof(float) * format.sampleRate;
-    m_inputBuffer.resize(totalSamplesNumber);
-    m_intermBuffer.resize(config()->renderStep() * config()->audioChannelsCount());
+    m_initRet = validateTargets(targets);
+    if (!m_initRet) {
+        return;
+    }
 
-    m_encoderPtr = createEncoder(format.type);
+    const SoundTrackFormat& format = targets.front().format;
+    m_totalSamplesPerChannel = (totalDuration / 1000000.f) * format.sampleRate;
 
-    if (!m_encoderPtr) {
-        return;
+    size_t renderBufferSize = config()->renderStep() * config()->audioChannelsCount();
+    for (std::vector<float>& buffer : m_renderBuffers) {
+        buffer.resize(renderBufferSize);
     }
 
-    m_encoderPtr->init(destination, format, totalSamplesNumber);
-    m_encoderPtr->progress().progressChanged.onReceive(this, [this](int64_t current, int64_t total, std::string) {
-        sendStepProgress(ENCODE_STEP, current, total);
-    });
+    m_encoderSlots.reserve(targets.size());
+
+    for (const SoundTrackTarget& target : targets) {
+        EncoderSlot slot;
+        slot.encoder = createEncoder(target.format.type);
+        slot.trackId = target.trackId;
+
+        if (!slot.encoder) {
+            m_initRet = make_ret(Err::ErrorEncode);
+            return;
+        }
+
+        if (!slot.encoder->init(target.destination, target.format, m_totalSamplesPerChannel)) {
+            m_initRet = make_ret(Err::InvalidAudioFilePath);
+            return;
+        }
+
+        if (target.isStem()) {
+            for (std::vector<float>& buffer : slot.stemBuffers) {
+                buffer.resize(renderBufferSize);
+            }
+        }
+
+        m_encoderSlots.push_back(std::move(slot));
+    }
 }
 
 Ret SoundTrackWriter::write()
 {
     TRACEFUNC;
 
-    if (!m_source || !m_encoderPtr) {
-        return false;
+    if (!m_initRet) {
+        return m_initRet;
     }
 
     AudioEngine::instance()->setMode(RenderMode::OfflineMode);
 
-    m_source->setSampleRate(m_encoderPtr->format().sampleRate);
-    m_source->setIsActive(true);
+    m_mixer->setSampleRate(m_encoderSlots.front().encoder->format().sampleRate);
+    m_mixer->setIsActive(true);
 
     DEFER {
-        m_encoderPtr->flush();
+        flushEncoders();
 
         AudioEngine::instance()->setMode(RenderMode::RealTimeMode);
 
-        m_source->setSampleRate(AudioEngine::instance()->sampleRate());
-        m_source->setIsActive(false);
+        m_mixer->setSampleRate(AudioEngine::instance()->sampleRate());
+        m_mixer->setIsActive(false);
 
         m_isAborted = false;
     };
 
-    Ret ret = prepareInputBuffer();
-    if (!ret) {
-        return ret;
-    }
-
-    size_t bytes = m_encoderPtr->encode(m_inputBuffer.size() / sizeof(float), m_inputBuffer.data());
-
-    if (m_isAborted) {
-        return make_ret(Ret::Code::Cancel);
-    }
-
-    if (bytes == 0) {
-        return make_ret(Err::ErrorEncode);
-    }
-
-    return make_ok();
+    return renderAndEncode();
 }
 
 void SoundTrackWriter::abort()
@@ -126,33 +143,69 @@ encode::AbstractAudioEncoderPtr SoundTrackWriter::createEncoder(const SoundTrack
     }
 }
 
-Ret SoundTrackWriter::prepareInputBuffer()
+Ret SoundTrackWriter::validateTargets(const SoundTrackTargetList& targets) const
 {
-    size_t inputBufferOffset = 0;
-    size_t inputBufferMaxOffset = m_inputBuffer.size();
+    if (targets.empty()) {
+        return make_ret(Err::NoAudioToExport);
+    }
+
+    //! NOTE The mix is rendered once, so every target has to accept the same samples
+    const SoundTrackFormat& format = targets.front().format;
 
-    sendStepProgress(PREPARE_STEP, inputBufferOffset, inputBufferMaxOffset);
+    for (const SoundTrackTarget& target : targets) {
+        if (target.format.sampleRate != format.sampleRate
+            || target.format.audioChannelsNumber != format.audioChannelsNumber) {
+            return make_ret(Err::IncompatibleSoundTrackFormats);
+        }
 
+        if (target.isStem() && !m_mixer->trackChannelBuffer(target.trackId)) {
+            return make_ret(Err::InvalidTrackId);
+        }
+    }
+
+    return make_ok();
+}
+
+Ret SoundTrackWriter::renderAndEncode()
+{
+    samples_t renderedSamplesPerChannel = 0;
     samples_t renderStep = config()->renderStep();
+    size_t bufferIdx = 0;
+
+    m_lastSentProgress = -1;
+    m_isEncodeFailed = false;
+    m_bufferEncodersCount.fill(0);
+    m_encodedSamplesPerChannel = 0;
+    sendProgress(0);
+
+    TaskGroup encodeTasks;
 
-    while (inputBufferOffset < inputBufferMaxOffset && !m_isAborted) {
-        m_source->process(m_intermBuffer.data(), renderStep);
+    while (renderedSamplesPerChannel < m_totalSamplesPerChannel && !m_isAborted && !m_isEncodeFailed) {
+        waitForBuffer(bufferIdx);
 
-        size_t samplesToCopy = std::min(m_intermBuffer.size(), inputBufferMaxOffset - inputBufferOffset);
+        renderBlock(bufferIdx, renderStep);
 
-        std::copy(m_intermBuffer.begin(),
-                  m_intermBuffer.begin() + samplesToCopy,
-                  m_inputBuffer.begin() + inputBufferOffset);
+        samples_t samplesToEncode = std::min(renderStep, m_totalSamplesPerChannel - renderedSamplesPerChannel);
+        renderedSamplesPerChannel += samplesToEncode;
 
-        inputBufferOffset += samplesToCopy;
-        sendStepProgress(PREPARE_STEP, inputBufferOffset, inputBufferMaxOffset);
+        queueEncoding(encodeTasks, bufferIdx, samplesToEncode);
+
+        bufferIdx = (bufferIdx + 1) % BUFFERS_COUNT;
+    }
+
+    encodeTasks.wait();
+
+    if (m_isEncodeFailed) {
+        return make_ret(Err::ErrorEncode);
     }
 
+    sendProgress(m_encodedSamplesPerChannel);
+
     if (m_isAborted) {
         return make_ret(Ret::Code::Cancel);
     }
 
-    if (inputBufferOffset == 0) {
+    if (m_encodedSamplesPerChannel == 0) {
         LOGI() << "No audio to export";
         return make_ret(Err::NoAudioToExport);
     }
@@ -160,10 +213,130 @@ Ret SoundTrackWriter::prepareInputBuffer()
     return make_ok();
 }
 
-void SoundTrackWriter::sendStepProgress(int step, int64_t current, int64_t total)
+void SoundTrackWriter::waitForBuffer(size_t bufferIdx)
 {
-    int stepRange = step == PREPARE_STEP ? 80 : 20;
-    int stepProgressStart = step == PREPARE_STEP ? 0 : 80;
-    int stepCurrentProgress = stepProgressStart + ((current * 100 / total) * stepRange) / 100;
-    m_progress.progressChanged.send(stepCurrentProgress, 100, "");
+    samples_t encodedSamplesPerChannel = 0;
+
+    {
+        std::unique_lock lock(m_encodeMutex);
+        m_bufferReleasedCv.wait(lock, [this, bufferIdx]() {
+            return m_bufferEncodersCount[bufferIdx] == 0;
+        });
+
+        encodedSamplesPerChannel = m_encodedSamplesPerChannel;
+    }
+
+    sendProgress(encodedSamplesPerChannel);
+}
+
+void SoundTrackWriter::queueEncoding(TaskGroup& encodeTasks, size_t bufferIdx, samples_t samplesPerChannel)
+{
+    std::lock_guard lock(m_encodeMutex);
+
+    m_bufferEncodersCount[bufferIdx] = m_encoderSlots.size();
+
+    for (EncoderSlot& slot : m_encoderSlots) {
+        slot.pendingJobs.push_back(EncodeJob { encoderInput(slot, bufferIdx), samplesPerChannel, bufferIdx });
+
+        if (slot.isEncoding) {
+            continue;
+        }
+
+        slot.isEncoding = true;
+        encodeTasks.run([this, &slot]() {
+            encodePendingJobs(slot);
+        });
+    }
+}
+
+void SoundTrackWriter::encodePendingJobs(EncoderSlot& slot)
+{
+    while (true) {
+        EncodeJob job;
+
+        {
+            std::lock_guard lock(m_encodeMutex);
+            if (slot.pendingJobs.empty()) {
+                slot.isEncoding = false;
+                return;
+            }
+
+            job = slot.pendingJobs.front();
+            slot.pendingJobs.pop_front();
+        }
+
+        if (!m_isEncodeFailed && slot.encoder->encode(job.samplesPerChannel, job.input) == 0) {
+            m_isEncodeFailed = true;
+        }
+
+        {
+            std::lock_guard lock(m_encodeMutex);
+
+            //! NOTE Every encoder takes the blocks in order, so the blocks are also released in order
+            if (--m_bufferEncodersCount[job.bufferIdx] == 0) {
+                m_encodedSamplesPerChannel += job.samplesPerChannel;
+            }
+        }
+
+        m_bufferReleasedCv.notify_one();
+    }
+}
+
+void SoundTrackWriter::renderBlock(size_t bufferIdx, samples_t renderStep)
+{
+    std::vector<float>& renderBuffer = m_renderBuffers[bufferIdx];
+    m_mixer->process(renderBuffer.data(), renderStep);
+
+    for (EncoderSlot& slot : m_encoderSlots) {
+        if (slot.trackId == MASTER_MIX_TRACK_ID) {
+            continue;
+        }
+
+        std::vector<float>& stemBuffer = slot.stemBuffers[bufferIdx];
+        const float* trackBuffer = m_mixer->trackChannelBuffer(slot.trackId);
+
+        if (trackBuffer) {
+            std::copy(trackBuffer, trackBuffer + stemBuffer.size(), stemBuffer.begin());
+        } else {
+            std::fill(stemBuffer.begin(), stemBuffer.end(), 0.f);
+        }
+    }
+}
+
+const float* SoundTrackWriter::encoderInput(const EncoderSlot& slot, size_t bufferIdx) const
+{
+    if (slot.trackId == MASTER_MIX_TRACK_ID) {
+        return m_renderBuffers[bufferIdx].data();
+    }
+
+    return slot.stemBuffers[bufferIdx].data();
+}
+
+void SoundTrackWriter::flushEncoders()
+{
+    TaskGroup flushTasks;
+
+    for (EncoderSlot& slot : m_encoderSlots) {
+        flushTasks.run([&slot]() {
+            slot.encoder->flush();
+        });
+    }
+
+    flushTasks.wait();
+}
+
+void SoundTrackWriter::sendProgress(samples_t encodedSamplesPerChannel)
+{
+    if (m_totalSamplesPerChannel == 0) {
+        return;
+    }
+
+    //! NOTE Chunks are small, only notify when the percentage actually changes
+    int progress = static_cast<int>((encodedSamplesPerChannel * 100) / m_totalSamplesPerChannel);
+    if (progress == m_lastSentProgress) {
+        return;
+    }
+
+    m_lastSentProgress = progress;
+    m_progress.progressChanged.send(progress, 100, "");
 }
@@ -24,22 +24,33 @@
 #define MU_AUDIO_SOUNDTRACKWRITER_H
 
 #include <vector>
+#include <deque>
+#include <array>
 #include <cstdio>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 #include "async/asyncable.h"
 #include "modularity/ioc.h"
 
 #include "audio/iaudioconfiguration.h"
+#include "concurrency/taskscheduler.h"
+
 #include "audiotypes.h"
-#include "iaudiosource.h"
+#include "internal/worker/mixer.h"
 #include "internal/encoders/abstractaudioencoder.h"
 
 namespace mu::audio::soundtrack {
+//! NOTE Renders the mix once and feeds every target with it: the master mix targets share the mixer output,
+//! the stem targets take the output of their track channel. Encoders run on the TaskScheduler,
+//! while the next blocks are being rendered on the audio worker thread
 class SoundTrackWriter : public async::Asyncable
 {
     INJECT_STATIC(IAudioConfiguration, config)
 public:
-    SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format, const msecs_t totalDuration, IAudioSourcePtr source);
+    SoundTrackWriter(const io::path_t& destination, const SoundTrackFormat& format, const msecs_t totalDuration, MixerPtr mixer);
+    SoundTrackWriter(const SoundTrackTargetList& targets, const msecs_t totalDuration, MixerPtr mixer);
 
     Ret write();
     void abort();
@@ -47,17 +58,57 @@ public:
     framework::Progress progress();
 
 private:
+    //! NOTE The audio worker thread renders up to BUFFERS_COUNT blocks ahead of the slowest encoder,
+    //! it only waits for the encoders when all of the buffers are still in use
+    static constexpr size_t BUFFERS_COUNT = 4;
+
+    struct EncodeJob {
+        const float* input = nullptr;
+        samples_t samplesPerChannel = 0;
+        size_t bufferIdx = 0;
+    };
+
+    struct EncoderSlot {
+        encode::AbstractAudioEncoderPtr encoder = nullptr;
+        TrackId trackId = MASTER_MIX_TRACK_ID;
+        std::vector<float> stemBuffers[BUFFERS_COUNT];
+
+        //! NOTE Every encoder has to receive the blocks in order, so they are queued
+        //! and encoded one after another by a single task at a time
+        std::deque<EncodeJob> pendingJobs;
+        bool isEncoding = false;
+    };
+
     encode::AbstractAudioEncoderPtr createEncoder(const SoundTrackType& type) const;
-    Ret prepareInputBuffer();
+    Ret validateTargets(const SoundTrackTargetList& targets) const;
+
+    Ret renderAndEncode();
+    void renderBlock(size_t bufferIdx, samples_t renderStep);
+    const float* encoderInput(const EncoderSlot& slot, size_t bufferIdx) const;
+    void waitForBuffer(size_t bufferIdx);
+    void queueEncoding(TaskGroup& encodeTasks, size_t bufferIdx, samples_t samplesPerChannel);
+    void encodePendingJobs(EncoderSlot& slot);
+    void flushEncoders();
+
+    void sendProgress(samples_t encodedSamplesPerChannel);
 
-    void sendStepProgress(int step, int64_t current, int64_t total);
+    MixerPtr m_mixer = nullptr;
+    Ret m_initRet;
 
-    IAudioSourcePtr m_source = nullptr;
+    //! NOTE Each buffer holds a single render step, each step is encoded right away,
+    //! so the memory usage doesn't depend on the score duration
+    std::vector<float> m_renderBuffers[BUFFERS_COUNT];
+    samples_t m_totalSamplesPerChannel = 0;
+    int m_lastSentProgress = -1;
 
-    std::vector<float> m_inputBuffer;
-    std::vector<float> m_intermBuffer;
+    std::vector<EncoderSlot> m_encoderSlots;
+    std::atomic<bool> m_isEncodeFailed = false;
 
-    encode::AbstractAudioEncoderPtr m_encoderPtr = nullptr;
+    //! NOTE Guards the pending jobs of the encoders and the buffer counters
+    std::mutex m_encodeMutex;
+    std::condition_variable m_bufferReleasedCv;
+    std::array<size_t, BUFFERS_COUNT> m_bufferEncodersCount = {};
+    samples_t m_encodedSamplesPerChannel = 0;
 
     framework::Progress m_progress;
     std::atomic<bool> m_isAborted = false;
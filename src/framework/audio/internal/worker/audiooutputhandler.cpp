@@ -22,6 +22,8 @@
 
 #include "audiooutputhandler.h"
 
+#include <set>
+
 #include "async/async.h"
 #include "containers.h"
 
@@ -149,9 +151,9 @@ Promise<AudioResourceMetaList> AudioOutputHandler::availableOutputResources() co
     }, AudioThread::ID);
 }
 
-Promise<AudioSignalChanges> AudioOutputHandler::signalChanges(const TrackSequenceId sequenceId, const TrackId trackId) const
+Promise<AudioSignalMeterPtr> AudioOutputHandler::signalMeter(const TrackSequenceId sequenceId, const TrackId trackId) const
 {
-    return Promise<AudioSignalChanges>([this, sequenceId, trackId](auto resolve, auto reject) {
+    return Promise<AudioSignalMeterPtr>([this, sequenceId, trackId](auto resolve, auto reject) {
         ONLY_AUDIO_WORKER_THREAD;
 
         ITrackSequencePtr s = sequence(sequenceId);
@@ -164,27 +166,45 @@ Promise<AudioSignalChanges> AudioOutputHandler::signalChanges(const TrackSequenc
             return reject(static_cast<int>(Err::InvalidTrackId), "no track");
         }
 
-        return resolve(s->audioIO()->audioSignalChanges(trackId));
+        return resolve(s->audioIO()->signalMeter(trackId));
     }, AudioThread::ID);
 }
 
-Promise<AudioSignalChanges> AudioOutputHandler::masterSignalChanges() const
+Promise<AudioSignalMeterPtr> AudioOutputHandler::masterSignalMeter() const
 {
-    return Promise<AudioSignalChanges>([this](auto resolve, auto reject) {
+    return Promise<AudioSignalMeterPtr>([this](auto resolve, auto reject) {
         ONLY_AUDIO_WORKER_THREAD;
 
         IF_ASSERT_FAILED(mixer()) {
             return reject(static_cast<int>(Err::Undefined), "undefined reference to a mixer");
         }
 
-        return resolve(mixer()->masterAudioSignalChanges());
+        return resolve(mixer()->masterSignalMeter());
+    }, AudioThread::ID);
+}
+
+Promise<uint64_t> AudioOutputHandler::overrunsCount() const
+{
+    return Promise<uint64_t>([this](auto resolve, auto reject) {
+        ONLY_AUDIO_WORKER_THREAD;
+
+        IF_ASSERT_FAILED(mixer()) {
+            return reject(static_cast<int>(Err::Undefined), "undefined reference to a mixer");
+        }
+
+        return resolve(mixer()->overrunsCount());
     }, AudioThread::ID);
 }
 
 Promise<bool> AudioOutputHandler::saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                                  const SoundTrackFormat& format)
 {
-    return Promise<bool>([this, sequenceId, destination, format](auto resolve, auto reject) {
+    return saveSoundTracks(sequenceId, { SoundTrackTarget { destination, format, MASTER_MIX_TRACK_ID } });
+}
+
+Promise<bool> AudioOutputHandler::saveSoundTracks(const TrackSequenceId sequenceId, const SoundTrackTargetList& targets)
+{
+    return Promise<bool>([this, sequenceId, targets](auto resolve, auto reject) {
         ONLY_AUDIO_WORKER_THREAD;
 
         IF_ASSERT_FAILED(mixer()) {
@@ -201,7 +221,7 @@ Promise<bool> AudioOutputHandler::saveSoundTrack(const TrackSequenceId sequenceI
         s->player()->seek(0);
         msecs_t totalDuration = s->player()->duration();
 
-        SoundTrackWriterPtr writer = std::make_shared<SoundTrackWriter>(destination, format, totalDuration, mixer());
+        SoundTrackWriterPtr writer = std::make_shared<SoundTrackWriter>(expandStemsTargets(s, targets), totalDuration, mixer());
         m_saveSoundTracksWritersMap[sequenceId] = writer;
 
         framework::Progress progress = saveSoundTrackProgress(sequenceId);
@@ -267,6 +287,37 @@ ITrackSequencePtr AudioOutputHandler::sequence(const TrackSequenceId id) const
     return s;
 }
 
+SoundTrackTargetList AudioOutputHandler::expandStemsTargets(const ITrackSequencePtr s, const SoundTrackTargetList& targets) const
+{
+    SoundTrackTargetList result;
+    std::set<String> usedNames;
+
+    for (const SoundTrackTarget& target : targets) {
+        if (target.trackId != ALL_TRACKS_STEMS_ID) {
+            result.push_back(target);
+            continue;
+        }
+
+        for (const TrackId trackId : s->trackIdList()) {
+            //! NOTE Aux channels have no stems
+            if (!mixer()->trackChannelBuffer(trackId)) {
+                continue;
+            }
+
+            String name = io::escapeFileName(s->trackName(trackId)).toString();
+            if (name.empty() || !usedNames.insert(name).second) {
+                name += u"-" + String::number(trackId);
+            }
+
+            io::path_t destination = target.destination + name + target.stemsSuffix;
+
+            result.push_back(SoundTrackTarget { destination, target.format, trackId });
+        }
+    }
+
+    return result;
+}
+
 void AudioOutputHandler::ensureSeqSubscriptions(const ITrackSequencePtr s) const
 {
     ONLY_AUDIO_WORKER_THREAD;
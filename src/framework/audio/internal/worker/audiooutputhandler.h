@@ -56,11 +56,14 @@ public:
 
     async::Promise<AudioResourceMetaList> availableOutputResources() const override;
 
-    async::Promise<AudioSignalChanges> signalChanges(const TrackSequenceId sequenceId, const TrackId trackId) const override;
-    async::Promise<AudioSignalChanges> masterSignalChanges() const override;
+    async::Promise<AudioSignalMeterPtr> signalMeter(const TrackSequenceId sequenceId, const TrackId trackId) const override;
+    async::Promise<AudioSignalMeterPtr> masterSignalMeter() const override;
+
+    async::Promise<uint64_t> overrunsCount() const override;
 
     async::Promise<bool> saveSoundTrack(const TrackSequenceId sequenceId, const io::path_t& destination,
                                         const SoundTrackFormat& format) override;
+    async::Promise<bool> saveSoundTracks(const TrackSequenceId sequenceId, const SoundTrackTargetList& targets) override;
     void abortSavingAllSoundTracks() override;
 
     framework::Progress saveSoundTrackProgress(const TrackSequenceId sequenceId) override;
@@ -70,6 +73,7 @@ public:
 private:
     std::shared_ptr<Mixer> mixer() const;
     ITrackSequencePtr sequence(const TrackSequenceId id) const;
+    SoundTrackTargetList expandStemsTargets(const ITrackSequencePtr s, const SoundTrackTargetList& targets) const;
     void ensureSeqSubscriptions(const ITrackSequencePtr s) const;
     void ensureMixerSubscriptions() const;
 
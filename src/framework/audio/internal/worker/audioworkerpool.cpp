@@ -0,0 +1,142 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "audioworkerpool.h"
+
+#include "runtime.h"
+
+#include "internal/audiosanitizer.h"
+
+using namespace mu::audio;
+
+static constexpr uint64_t NEXT_JOB_MASK = 0xFFFFFFFF;
+static constexpr int JOBS_COUNT_SHIFT = 32;
+
+AudioWorkerPool::AudioWorkerPool(size_t workersCount)
+{
+    m_isActive = true;
+
+    m_workers.reserve(workersCount);
+    for (size_t i = 0; i < workersCount; ++i) {
+        m_workers.emplace_back(&AudioWorkerPool::th_workerLoop, this);
+    }
+}
+
+AudioWorkerPool::~AudioWorkerPool()
+{
+    {
+        std::lock_guard lock(m_sleepMutex);
+        m_isActive = false;
+        m_generation.fetch_add(1);
+    }
+    m_wakeUpCv.notify_all();
+
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+size_t AudioWorkerPool::defaultWorkersCount()
+{
+    //! NOTE The calling thread takes part in every job as well,
+    //! so keep one core for it and leave the rest of the machine to the UI and synths
+    size_t cores = std::thread::hardware_concurrency();
+    if (cores <= 2) {
+        return 0;
+    }
+
+    return cores / 2 - 1;
+}
+
+size_t AudioWorkerPool::workersCount() const
+{
+    return m_workers.size();
+}
+
+void AudioWorkerPool::dispatch(size_t count)
+{
+    m_finishedJobsCount.store(0, std::memory_order_relaxed);
+    m_jobState.store(static_cast<uint64_t>(count) << JOBS_COUNT_SHIFT, std::memory_order_release);
+
+    m_generation.fetch_add(1);
+
+    //! NOTE The mutex is only taken when some worker sleeps. A worker announces itself under the mutex
+    //! before checking the generation, so either it sees the new one or it is seen here and gets notified
+    if (m_sleepingWorkersCount.load() > 0) {
+        {
+            std::lock_guard lock(m_sleepMutex);
+        }
+        m_wakeUpCv.notify_all();
+    }
+
+    while (runNextJob()) {
+    }
+
+    while (m_finishedJobsCount.load(std::memory_order_acquire) < count) {
+        std::this_thread::yield();
+    }
+}
+
+bool AudioWorkerPool::runNextJob()
+{
+    uint64_t state = m_jobState.load(std::memory_order_acquire);
+
+    while (true) {
+        uint64_t count = state >> JOBS_COUNT_SHIFT;
+        uint64_t next = state & NEXT_JOB_MASK;
+
+        if (next >= count) {
+            return false;
+        }
+
+        if (m_jobState.compare_exchange_weak(state, state + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            m_jobInvoker(m_jobContext, static_cast<size_t>(next));
+            m_finishedJobsCount.fetch_add(1, std::memory_order_release);
+            return true;
+        }
+    }
+}
+
+void AudioWorkerPool::th_workerLoop()
+{
+    mu::runtime::setThreadName("audio_pool_worker");
+    AudioSanitizer::setupWorkerPoolThread();
+
+    uint64_t seenGeneration = m_generation.load();
+
+    while (true) {
+        while (runNextJob()) {
+        }
+
+        std::unique_lock lock(m_sleepMutex);
+        m_sleepingWorkersCount.fetch_add(1);
+        m_wakeUpCv.wait(lock, [this, seenGeneration]() {
+            return m_generation.load() != seenGeneration || !m_isActive;
+        });
+        m_sleepingWorkersCount.fetch_sub(1);
+
+        if (!m_isActive) {
+            return;
+        }
+
+        seenGeneration = m_generation.load();
+    }
+}
@@ -0,0 +1,98 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_AUDIOWORKERPOOL_H
+#define MU_AUDIO_AUDIOWORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mu::audio {
+//! NOTE A small fork/join pool dedicated to the audio worker.
+//! The calling thread takes part in the work, jobs are claimed through a single atomic,
+//! so parallelFor neither allocates nor takes any lock on the calling side
+class AudioWorkerPool
+{
+public:
+    explicit AudioWorkerPool(size_t workersCount = defaultWorkersCount());
+    ~AudioWorkerPool();
+
+    AudioWorkerPool(const AudioWorkerPool&) = delete;
+    AudioWorkerPool& operator=(const AudioWorkerPool&) = delete;
+
+    static size_t defaultWorkersCount();
+
+    size_t workersCount() const;
+
+    //! NOTE Calls func(idx) for each idx in [0, count) and returns when all of them are done.
+    //! func must stay alive until then and must not call parallelFor itself
+    template<typename Func>
+    void parallelFor(size_t count, Func& func)
+    {
+        if (count == 0) {
+            return;
+        }
+
+        if (m_workers.empty() || count == 1) {
+            for (size_t idx = 0; idx < count; ++idx) {
+                func(idx);
+            }
+            return;
+        }
+
+        m_jobContext = &func;
+        m_jobInvoker = [](void* context, size_t idx) {
+            (*static_cast<Func*>(context))(idx);
+        };
+
+        dispatch(count);
+    }
+
+private:
+    using JobInvoker = void (*)(void* context, size_t idx);
+
+    void dispatch(size_t count);
+    bool runNextJob();
+
+    void th_workerLoop();
+
+    std::vector<std::thread> m_workers;
+
+    void* m_jobContext = nullptr;
+    JobInvoker m_jobInvoker = nullptr;
+
+    //! NOTE High 32 bits: jobs count, low 32 bits: index of the next job to claim
+    std::atomic<uint64_t> m_jobState = 0;
+    std::atomic<size_t> m_finishedJobsCount = 0;
+    std::atomic<uint64_t> m_generation = 0;
+    std::atomic<size_t> m_sleepingWorkersCount = 0;
+    std::atomic<bool> m_isActive = false;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeUpCv;
+};
+}
+
+#endif // MU_AUDIO_AUDIOWORKERPOOL_H
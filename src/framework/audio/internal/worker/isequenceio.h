@@ -28,6 +28,7 @@
 #include "types/retval.h"
 
 #include "audiotypes.h"
+#include "audiosignalmeter.h"
 
 namespace mu::audio {
 class ISequenceIO
@@ -46,7 +47,7 @@ public:
     virtual async::Channel<TrackId, AudioInputParams> inputParamsChanged() const = 0;
     virtual async::Channel<TrackId, AudioOutputParams> outputParamsChanged() const = 0;
 
-    virtual async::Channel<audioch_t, AudioSignalVal> audioSignalChanges(const TrackId id) const = 0;
+    virtual AudioSignalMeterPtr signalMeter(const TrackId id) const = 0;
 };
 
 using ISequenceIOPtr = std::shared_ptr<ISequenceIO>;
@@ -24,10 +24,9 @@
 #include "async/async.h"
 #include "log.h"
 
+#include <chrono>
 #include <limits>
 
-#include "concurrency/taskscheduler.h"
-
 #include "internal/audiosanitizer.h"
 #include "internal/audiothread.h"
 #include "internal/dsp/audiomathutils.h"
@@ -68,6 +67,7 @@ RetVal<MixerChannelPtr> Mixer::addChannel(const TrackId trackId, IAudioSourcePtr
     }
 
     m_trackChannels.emplace(trackId, std::make_shared<MixerChannel>(trackId, std::move(source), m_sampleRate));
+    updateTrackChannelSlots();
 
     result.val = m_trackChannels[trackId];
     result.ret = make_ret(Ret::Code::Ok);
@@ -81,7 +81,7 @@ RetVal<MixerChannelPtr> Mixer::addAuxChannel(const TrackId trackId)
 
     MixerChannelPtr channel = std::make_shared<MixerChannel>(trackId, m_sampleRate, configuration()->audioChannelsCount());
     m_auxChannels.push_back(channel);
-    m_auxBuffers.emplace_back(std::vector<float>(DEFAULT_AUX_BUFFER_SIZE, 0.f));
+    m_auxBuffers.emplace_back(std::vector<float>(std::max(DEFAULT_AUX_BUFFER_SIZE, m_preallocatedBufferSize), 0.f));
 
     RetVal<MixerChannelPtr> result;
     result.val = channel;
@@ -98,6 +98,7 @@ Ret Mixer::removeChannel(const TrackId trackId)
 
     if (search != m_trackChannels.end() && search->second) {
         m_trackChannels.erase(trackId);
+        updateTrackChannelSlots();
         return make_ret(Ret::Code::Ok);
     }
 
@@ -117,6 +118,8 @@ void Mixer::setAudioChannelsCount(const audioch_t count)
     ONLY_AUDIO_WORKER_THREAD;
 
     m_audioChannelsCount = count;
+
+    preallocateBuffers(configuration()->renderStep() * count);
 }
 
 void Mixer::setSampleRate(unsigned int sampleRate)
@@ -130,6 +133,8 @@ void Mixer::setSampleRate(unsigned int sampleRate)
     for (auto& channel : m_trackChannels) {
         channel.second->setSampleRate(sampleRate);
     }
+
+    preallocateBuffers(configuration()->renderStep() * m_audioChannelsCount);
 }
 
 unsigned int Mixer::audioChannelsCount() const
@@ -143,6 +148,8 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
+    const auto blockStartTime = std::chrono::steady_clock::now();
+
     for (IClockPtr clock : m_clocks) {
         clock->forward((samplesPerChannel * 1000000) / m_sampleRate);
     }
@@ -150,49 +157,34 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
     size_t outBufferSize = samplesPerChannel * m_audioChannelsCount;
     std::fill(outBuffer, outBuffer + outBufferSize, 0.f);
 
-    if (m_writeCacheBuff.size() != outBufferSize) {
-        m_writeCacheBuff.resize(outBufferSize, 0.f);
-    }
+    //! NOTE Does nothing unless the render step has grown since setSampleRate
+    preallocateBuffers(outBufferSize);
 
-    samples_t masterChannelSampleCount = 0;
-
-    std::map < TrackId, std::future<std::vector<float> > > futures;
-
-    for (const auto& pair : m_trackChannels) {
-        MixerChannelPtr channel = pair.second;
-        std::future<std::vector<float> > future = TaskScheduler::instance()->submit([outBufferSize, samplesPerChannel,
-                                                                                     channel]() -> std::vector<float> {
-            thread_local std::vector<float> buffer(outBufferSize, 0.f);
-            thread_local std::vector<float> silent_buffer(outBufferSize, 0.f);
-
-            buffer = silent_buffer;
-
-            if (channel) {
-                channel->process(buffer.data(), samplesPerChannel);
-            }
-
-            return buffer;
-        });
+    auto processTrack = [this, samplesPerChannel](size_t slotIdx) {
+        processTrackChannel(slotIdx, samplesPerChannel);
+    };
 
-        futures.emplace(pair.first, std::move(future));
-    }
+    m_workerPool.parallelFor(m_trackChannelSlots.size(), processTrack);
 
     prepareAuxBuffers(outBufferSize);
 
-    for (auto& pair : futures) {
-        const std::vector<float>& trackBuffer = pair.second.get();
+    samples_t masterChannelSampleCount = 0;
 
-        mixOutputFromChannel(outBuffer, trackBuffer.data(), samplesPerChannel);
+    for (const TrackChannelSlot& slot : m_trackChannelSlots) {
+        mixOutputFromChannel(outBuffer, slot.buffer.data(), samplesPerChannel);
         masterChannelSampleCount = std::max(samplesPerChannel, masterChannelSampleCount);
 
-        const AuxSendsParams& auxSends = m_trackChannels.at(pair.first)->outputParams().auxSends;
-        writeTrackToAuxBuffers(auxSends, trackBuffer.data(), samplesPerChannel);
+        if (slot.channel) {
+            writeTrackToAuxBuffers(slot.channel->outputParams().auxSends, slot.buffer.data(), samplesPerChannel);
+        }
     }
 
     if (m_masterParams.muted || masterChannelSampleCount == 0) {
         for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
-            notifyAboutAudioSignalChanges(audioChNum, 0);
+            m_signalMeter->write(audioChNum, 0.f, 0.f, samplesPerChannel);
         }
+
+        countOverrun(blockStartTime, samplesPerChannel);
         return 0;
     }
 
@@ -205,6 +197,8 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
         }
     }
 
+    countOverrun(blockStartTime, samplesPerChannel);
+
     return masterChannelSampleCount;
 }
 
@@ -298,9 +292,85 @@ Channel<AudioOutputParams> Mixer::masterOutputParamsChanged() const
     return m_masterOutputParamsChanged;
 }
 
-async::Channel<audioch_t, AudioSignalVal> Mixer::masterAudioSignalChanges() const
+AudioSignalMeterPtr Mixer::masterSignalMeter() const
 {
-    return m_audioSignalNotifier.audioSignalChanges;
+    return m_signalMeter;
+}
+
+uint64_t Mixer::overrunsCount() const
+{
+    return m_overrunsCount.load(std::memory_order_relaxed);
+}
+
+const float* Mixer::trackChannelBuffer(const TrackId trackId) const
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    for (const TrackChannelSlot& slot : m_trackChannelSlots) {
+        if (slot.channel && slot.channel->trackId() == trackId) {
+            return slot.buffer.data();
+        }
+    }
+
+    return nullptr;
+}
+
+void Mixer::updateTrackChannelSlots()
+{
+    m_trackChannelSlots.clear();
+    m_trackChannelSlots.reserve(m_trackChannels.size());
+
+    for (const auto& pair : m_trackChannels) {
+        TrackChannelSlot slot;
+        slot.channel = pair.second;
+        slot.buffer.resize(m_preallocatedBufferSize, 0.f);
+
+        m_trackChannelSlots.push_back(std::move(slot));
+    }
+}
+
+void Mixer::preallocateBuffers(size_t outBufferSize)
+{
+    if (outBufferSize <= m_preallocatedBufferSize) {
+        return;
+    }
+
+    m_preallocatedBufferSize = outBufferSize;
+
+    for (TrackChannelSlot& slot : m_trackChannelSlots) {
+        slot.buffer.resize(outBufferSize, 0.f);
+    }
+
+    for (std::vector<float>& auxBuffer : m_auxBuffers) {
+        if (auxBuffer.size() < outBufferSize) {
+            auxBuffer.resize(outBufferSize, 0.f);
+        }
+    }
+}
+
+void Mixer::processTrackChannel(size_t slotIdx, samples_t samplesPerChannel)
+{
+    TrackChannelSlot& slot = m_trackChannelSlots[slotIdx];
+
+    float* buffer = slot.buffer.data();
+    std::fill(buffer, buffer + samplesPerChannel * m_audioChannelsCount, 0.f);
+
+    if (slot.channel) {
+        slot.channel->process(buffer, samplesPerChannel);
+    }
+}
+
+void Mixer::countOverrun(const std::chrono::steady_clock::time_point& blockStartTime, samples_t samplesPerChannel)
+{
+    if (m_sampleRate == 0) {
+        return;
+    }
+
+    const std::chrono::microseconds blockDuration((samplesPerChannel * 1000000) / m_sampleRate);
+
+    if (std::chrono::steady_clock::now() - blockStartTime > blockDuration) {
+        m_overrunsCount.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
 void Mixer::mixOutputFromChannel(float* outBuffer, const float* inBuffer, unsigned int samplesCount, gain_t signalAmount)
@@ -408,6 +478,7 @@ void Mixer::completeOutput(float* buffer, samples_t samplesPerChannel)
 
     for (audioch_t audioChNum = 0; audioChNum < m_audioChannelsCount; ++audioChNum) {
         float singleChannelSquaredSum = 0.f;
+        float singleChannelPeak = 0.f;
 
         gain_t totalGain = dsp::balanceGain(m_masterParams.balance, audioChNum) * volume;
 
@@ -420,10 +491,10 @@ void Mixer::completeOutput(float* buffer, samples_t samplesPerChannel)
             float squaredSample = resultSample * resultSample;
             totalSquaredSum += squaredSample;
             singleChannelSquaredSum += squaredSample;
+            singleChannelPeak = std::max(singleChannelPeak, std::abs(resultSample));
         }
 
-        float rms = dsp::samplesRootMeanSquare(singleChannelSquaredSum, samplesPerChannel);
-        notifyAboutAudioSignalChanges(audioChNum, rms);
+        m_signalMeter->write(audioChNum, singleChannelPeak, singleChannelSquaredSum, samplesPerChannel);
     }
 
     if (!m_limiter->isActive()) {
@@ -433,8 +504,3 @@ void Mixer::completeOutput(float* buffer, samples_t samplesPerChannel)
     float totalRms = dsp::samplesRootMeanSquare(totalSquaredSum, samplesPerChannel * m_audioChannelsCount);
     m_limiter->process(totalRms, buffer, m_audioChannelsCount, samplesPerChannel);
 }
-
-void Mixer::notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const
-{
-    m_audioSignalNotifier.updateSignalValues(audioChannelNumber, linearRms, dsp::dbFromSample(linearRms));
-}
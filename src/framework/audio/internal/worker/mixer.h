@@ -22,6 +22,8 @@
 #ifndef MU_AUDIO_MIXER_H
 #define MU_AUDIO_MIXER_H
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <map>
 
@@ -31,6 +33,7 @@
 
 #include "abstractaudiosource.h"
 #include "mixerchannel.h"
+#include "audioworkerpool.h"
 #include "internal/dsp/limiter.h"
 #include "ifxresolver.h"
 #include "iaudioconfiguration.h"
@@ -61,7 +64,14 @@ public:
     void clearMasterOutputParams();
     async::Channel<AudioOutputParams> masterOutputParamsChanged() const;
 
-    async::Channel<audioch_t, AudioSignalVal> masterAudioSignalChanges() const;
+    AudioSignalMeterPtr masterSignalMeter() const;
+
+    //! NOTE Number of blocks which took longer to mix than their own duration, readable from any thread
+    uint64_t overrunsCount() const;
+
+    //! NOTE Output of the given track channel from the last process() call, before the master stage.
+    //! Stays valid until the next process() call, nullptr if there is no such track
+    const float* trackChannelBuffer(const TrackId trackId) const;
 
     // IAudioSource
     void setSampleRate(unsigned int sampleRate) override;
@@ -70,15 +80,28 @@ public:
     void setIsActive(bool arg) override;
 
 private:
+    struct TrackChannelSlot {
+        MixerChannelPtr channel = nullptr;
+        std::vector<float> buffer;
+    };
+
+    void updateTrackChannelSlots();
+    void preallocateBuffers(size_t outBufferSize);
+    void processTrackChannel(size_t slotIdx, samples_t samplesPerChannel);
+    void countOverrun(const std::chrono::steady_clock::time_point& blockStartTime, samples_t samplesPerChannel);
+
     void mixOutputFromChannel(float* outBuffer, const float* inBuffer, unsigned int samplesCount, gain_t signalAmount = 1.f);
     void prepareAuxBuffers(size_t outBufferSize);
     void writeTrackToAuxBuffers(const AuxSendsParams& auxSends, const float* trackBuffer, samples_t samplesPerChannel);
     void processAuxChannels(float* buffer, samples_t samplesPerChannel);
     void completeOutput(float* buffer, samples_t samplesPerChannel);
-    void notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const;
 
-    std::vector<float> m_writeCacheBuff;
+    std::vector<TrackChannelSlot> m_trackChannelSlots;
     std::vector<std::vector<float> > m_auxBuffers;
+    size_t m_preallocatedBufferSize = 0;
+
+    AudioWorkerPool m_workerPool;
+    std::atomic<uint64_t> m_overrunsCount = 0;
 
     AudioOutputParams m_masterParams;
     async::Channel<AudioOutputParams> m_masterOutputParamsChanged;
@@ -92,7 +115,7 @@ private:
     std::set<IClockPtr> m_clocks;
     audioch_t m_audioChannelsCount = 0;
 
-    mutable AudioSignalsNotifier m_audioSignalNotifier;
+    AudioSignalMeterPtr m_signalMeter = std::make_shared<AudioSignalMeter>();
 };
 
 using MixerPtr = std::shared_ptr<Mixer>;
@@ -36,7 +36,8 @@ MixerChannel::MixerChannel(const TrackId trackId, IAudioSourcePtr source, const
     : m_trackId(trackId),
     m_sampleRate(sampleRate),
     m_audioSource(std::move(source)),
-    m_compressor(std::make_unique<dsp::Compressor>(sampleRate))
+    m_compressor(std::make_unique<dsp::Compressor>(sampleRate)),
+    m_signalMeter(std::make_shared<AudioSignalMeter>())
 {
     ONLY_AUDIO_WORKER_THREAD;
 
@@ -115,9 +116,9 @@ async::Channel<AudioOutputParams> MixerChannel::outputParamsChanged() const
     return m_paramsChanges;
 }
 
-async::Channel<audioch_t, AudioSignalVal> MixerChannel::audioSignalChanges() const
+AudioSignalMeterPtr MixerChannel::signalMeter() const
 {
-    return m_audioSignalNotifier.audioSignalChanges;
+    return m_signalMeter;
 }
 
 bool MixerChannel::isActive() const
@@ -178,7 +179,7 @@ samples_t MixerChannel::process(float* buffer, samples_t samplesPerChannel)
         std::fill(buffer, buffer + samplesPerChannel * channelsCount, 0.f);
 
         for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
-            notifyAboutAudioSignalChanges(audioChNum, 0.f);
+            m_signalMeter->write(audioChNum, 0.f, 0.f, samplesPerChannel);
         }
 
         return processedSamplesCount;
@@ -204,6 +205,7 @@ void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount) cons
 
     for (audioch_t audioChNum = 0; audioChNum < channelsCount; ++audioChNum) {
         float singleChannelSquaredSum = 0.f;
+        float singleChannelPeak = 0.f;
 
         gain_t totalGain = dsp::balanceGain(m_params.balance, audioChNum) * volume;
 
@@ -216,11 +218,10 @@ void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount) cons
             float squaredSample = resultSample * resultSample;
             singleChannelSquaredSum += squaredSample;
             totalSquaredSum += squaredSample;
+            singleChannelPeak = std::max(singleChannelPeak, std::abs(resultSample));
         }
 
-        float rms = dsp::samplesRootMeanSquare(singleChannelSquaredSum, samplesCount);
-
-        notifyAboutAudioSignalChanges(audioChNum, rms);
+        m_signalMeter->write(audioChNum, singleChannelPeak, singleChannelSquaredSum, samplesCount);
     }
 
     if (!m_compressor->isActive()) {
@@ -230,8 +231,3 @@ void MixerChannel::completeOutput(float* buffer, unsigned int samplesCount) cons
     float totalRms = dsp::samplesRootMeanSquare(totalSquaredSum, samplesCount * channelsCount);
     m_compressor->process(totalRms, buffer, channelsCount, samplesCount);
 }
-
-void MixerChannel::notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const
-{
-    m_audioSignalNotifier.updateSignalValues(audioChannelNumber, linearRms, dsp::dbFromSample(linearRms));
-}
@@ -46,7 +46,7 @@ public:
     void applyOutputParams(const AudioOutputParams& requiredParams) override;
     async::Channel<AudioOutputParams> outputParamsChanged() const override;
 
-    async::Channel<audioch_t, AudioSignalVal> audioSignalChanges() const override;
+    AudioSignalMeterPtr signalMeter() const override;
 
     bool isActive() const override;
     void setIsActive(bool arg) override;
@@ -58,7 +58,6 @@ public:
 
 private:
     void completeOutput(float* buffer, unsigned int samplesCount) const;
-    void notifyAboutAudioSignalChanges(const audioch_t audioChannelNumber, const float linearRms) const;
 
     TrackId m_trackId = -1;
 
@@ -72,7 +71,7 @@ private:
     dsp::CompressorPtr m_compressor = nullptr;
 
     mutable async::Channel<AudioOutputParams> m_paramsChanges;
-    mutable AudioSignalsNotifier m_audioSignalNotifier;
+    AudioSignalMeterPtr m_signalMeter = nullptr;
 };
 
 using MixerChannelPtr = std::shared_ptr<MixerChannel>;
@@ -32,6 +32,7 @@
 
 #include "iaudiosource.h"
 #include "audiotypes.h"
+#include "audiosignalmeter.h"
 
 namespace mu::audio {
 enum TrackType {
@@ -60,7 +61,7 @@ public:
     virtual void applyOutputParams(const AudioOutputParams& requiredParams) = 0;
     virtual async::Channel<AudioOutputParams> outputParamsChanged() const = 0;
 
-    virtual async::Channel<audioch_t, AudioSignalVal> audioSignalChanges() const = 0;
+    virtual AudioSignalMeterPtr signalMeter() const = 0;
 };
 
 using ITrackAudioInputPtr = std::shared_ptr<ITrackAudioInput>;
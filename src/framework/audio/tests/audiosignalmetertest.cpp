@@ -0,0 +1,130 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "audio/audiosignalmeter.h"
+
+using namespace mu::audio;
+
+namespace mu::audio {
+class Audio_AudioSignalMeterTest : public ::testing::Test
+{
+};
+
+TEST_F(Audio_AudioSignalMeterTest, Read_NothingWritten)
+{
+    //! [GIVEN] Empty meter
+    AudioSignalMeter meter;
+
+    //! [WHEN] Read
+    uint64_t position = 0;
+    AudioSignalMeter::Frame frame;
+
+    //! [THEN] Nothing to read
+    EXPECT_FALSE(meter.read(0, position, frame));
+    EXPECT_EQ(position, 0);
+}
+
+TEST_F(Audio_AudioSignalMeterTest, Read_LoudestFrameSinceLastRead)
+{
+    //! [GIVEN] Meter with two blocks written, a loud one and a quiet one
+    AudioSignalMeter meter;
+    meter.write(0, 0.5f, 0.25f * 4, 4);
+    meter.write(0, 0.1f, 0.01f * 4, 4);
+
+    //! [WHEN] Read
+    uint64_t position = 0;
+    AudioSignalMeter::Frame frame;
+    EXPECT_TRUE(meter.read(0, position, frame));
+
+    //! [THEN] The loudest one is read
+    EXPECT_EQ(position, 2);
+    EXPECT_FLOAT_EQ(frame.peak, 0.5f);
+    EXPECT_FLOAT_EQ(frame.rms, 0.5f);
+
+    //! [THEN] Nothing new to read
+    EXPECT_FALSE(meter.read(0, position, frame));
+
+    //! [THEN] The other channel is untouched
+    uint64_t otherPosition = 0;
+    EXPECT_FALSE(meter.read(1, otherPosition, frame));
+}
+
+TEST_F(Audio_AudioSignalMeterTest, Write_Decimation)
+{
+    //! [GIVEN] Meter which summarizes every 3 blocks into one frame
+    AudioSignalMeter meter(3);
+
+    //! [WHEN] Write 2 blocks
+    meter.write(0, 1.f, 1.f * 10, 10);
+    meter.write(0, 0.f, 0.f, 10);
+
+    //! [THEN] No frame yet
+    uint64_t position = 0;
+    AudioSignalMeter::Frame frame;
+    EXPECT_FALSE(meter.read(0, position, frame));
+
+    //! [WHEN] Write the 3rd block
+    meter.write(0, 0.f, 0.f, 10);
+
+    //! [THEN] One frame covering all 3 blocks
+    EXPECT_TRUE(meter.read(0, position, frame));
+    EXPECT_EQ(position, 1);
+    EXPECT_FLOAT_EQ(frame.peak, 1.f);
+    EXPECT_FLOAT_EQ(frame.rms, std::sqrt(10.f / 30.f));
+}
+
+TEST_F(Audio_AudioSignalMeterTest, Read_LateReaderSkipsOverwrittenFrames)
+{
+    //! [GIVEN] Meter with a loud frame, which is then overwritten by quiet ones
+    AudioSignalMeter meter;
+    meter.write(0, 1.f, 1.f, 1);
+    for (size_t i = 0; i < AudioSignalMeter::FRAMES_COUNT; ++i) {
+        meter.write(0, 0.f, 0.f, 1);
+    }
+
+    //! [WHEN] Read
+    uint64_t position = 0;
+    AudioSignalMeter::Frame frame;
+    EXPECT_TRUE(meter.read(0, position, frame));
+
+    //! [THEN] Only the frames in the ring are read
+    EXPECT_EQ(position, AudioSignalMeter::FRAMES_COUNT + 1);
+    EXPECT_FLOAT_EQ(frame.peak, 0.f);
+}
+
+TEST_F(Audio_AudioSignalMeterTest, SignalVal_Pressure)
+{
+    AudioSignalMeter::Frame frame;
+
+    //! [THEN] Full scale is 0 dBFS
+    frame.rms = 1.f;
+    EXPECT_NEAR(AudioSignalMeter::signalVal(frame).pressure, 0.f, 0.001f);
+
+    //! [THEN] Silence is the minimum level
+    frame.rms = 0.f;
+    EXPECT_FLOAT_EQ(AudioSignalMeter::signalVal(frame).pressure, AudioSignalMeter::MINIMUM_OPERABLE_DBFS_LEVEL);
+}
+}
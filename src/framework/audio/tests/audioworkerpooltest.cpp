@@ -0,0 +1,111 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "audio/internal/worker/audioworkerpool.h"
+
+using namespace mu::audio;
+
+namespace mu::audio {
+class Audio_AudioWorkerPoolTest : public ::testing::Test
+{
+};
+
+TEST_F(Audio_AudioWorkerPoolTest, ParallelFor_EveryJobRunsOnce)
+{
+    //! [GIVEN] Pool with a few workers
+    AudioWorkerPool pool(3);
+    EXPECT_EQ(pool.workersCount(), 3);
+
+    //! [WHEN] Dispatch many blocks of jobs, like the mixer does every block
+    constexpr size_t JOBS_COUNT = 64;
+    std::vector<std::atomic<int> > calls(JOBS_COUNT);
+
+    auto job = [&calls](size_t idx) {
+        calls[idx]++;
+    };
+
+    constexpr int BLOCKS_COUNT = 1000;
+    for (int i = 0; i < BLOCKS_COUNT; ++i) {
+        pool.parallelFor(JOBS_COUNT, job);
+    }
+
+    //! [THEN] Every job has run exactly once per block
+    for (size_t idx = 0; idx < JOBS_COUNT; ++idx) {
+        EXPECT_EQ(calls[idx], BLOCKS_COUNT);
+    }
+}
+
+TEST_F(Audio_AudioWorkerPoolTest, ParallelFor_WorkersTakePart)
+{
+    //! [GIVEN] Pool with a few workers which have gone to sleep
+    AudioWorkerPool pool(3);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    //! [WHEN] Dispatch jobs that can only finish when several threads run them at once
+    constexpr size_t JOBS_COUNT = 2;
+    std::atomic<size_t> startedJobsCount = 0;
+    std::atomic<bool> allStartedTogether = true;
+
+    auto job = [&](size_t) {
+        startedJobsCount++;
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (startedJobsCount < JOBS_COUNT) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                allStartedTogether = false;
+                return;
+            }
+            std::this_thread::yield();
+        }
+    };
+
+    pool.parallelFor(JOBS_COUNT, job);
+
+    //! [THEN] A sleeping worker has been woken up to run the second job
+    EXPECT_TRUE(allStartedTogether);
+    EXPECT_EQ(startedJobsCount, JOBS_COUNT);
+}
+
+TEST_F(Audio_AudioWorkerPoolTest, ParallelFor_WithoutWorkers)
+{
+    //! [GIVEN] Pool without workers
+    AudioWorkerPool pool(0);
+
+    //! [WHEN] Dispatch jobs
+    std::vector<size_t> order;
+    auto job = [&order](size_t idx) {
+        order.push_back(idx);
+    };
+
+    pool.parallelFor(4, job);
+
+    //! [THEN] They run on the calling thread, in order
+    EXPECT_EQ(order, std::vector<size_t>({ 0, 1, 2, 3 }));
+}
+}
@@ -0,0 +1,147 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "audio/internal/worker/mixer.h"
+#include "audio/internal/audiosanitizer.h"
+#include "audio/tests/mocks/audioconfigurationmock.h"
+
+using ::testing::NiceMock;
+using ::testing::Return;
+
+using namespace mu::audio;
+
+namespace mu::audio {
+class Audio_MixerTest : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        AudioSanitizer::setupWorkerThread();
+
+        m_configuration = std::make_shared<NiceMock<AudioConfigurationMock> >();
+        ON_CALL(*m_configuration, renderStep()).WillByDefault(Return(BLOCK_SIZE));
+        ON_CALL(*m_configuration, audioChannelsCount()).WillByDefault(Return(CHANNELS_COUNT));
+
+        modularity::ioc()->registerExport<IAudioConfiguration>("utests", m_configuration);
+
+        m_mixer = std::make_shared<Mixer>();
+        m_mixer->setAudioChannelsCount(CHANNELS_COUNT);
+        m_mixer->setSampleRate(SAMPLE_RATE);
+        m_mixer->setIsActive(true);
+    }
+
+    void TearDown() override
+    {
+        m_mixer.reset();
+        modularity::ioc()->unregister<IAudioConfiguration>("utests");
+    }
+
+protected:
+    static constexpr samples_t BLOCK_SIZE = 48;
+    static constexpr audioch_t CHANNELS_COUNT = 2;
+    static constexpr unsigned int SAMPLE_RATE = 48000; // so a block lasts 1ms
+
+    //! NOTE Produces a constant signal, taking the given time for every block
+    class SourceStub : public AbstractAudioSource
+    {
+    public:
+        explicit SourceStub(std::chrono::microseconds processingTime)
+            : m_processingTime(processingTime) {}
+
+        unsigned int audioChannelsCount() const override
+        {
+            return CHANNELS_COUNT;
+        }
+
+        samples_t process(float* buffer, samples_t samplesPerChannel) override
+        {
+            std::this_thread::sleep_for(m_processingTime);
+            std::fill(buffer, buffer + samplesPerChannel * CHANNELS_COUNT, 0.25f);
+            return samplesPerChannel;
+        }
+
+    private:
+        std::chrono::microseconds m_processingTime;
+    };
+
+    void processBlocks(int count)
+    {
+        std::vector<float> buffer(BLOCK_SIZE * CHANNELS_COUNT);
+        for (int i = 0; i < count; ++i) {
+            m_mixer->process(buffer.data(), BLOCK_SIZE);
+        }
+    }
+
+    std::shared_ptr<NiceMock<AudioConfigurationMock> > m_configuration;
+    std::shared_ptr<Mixer> m_mixer;
+};
+
+TEST_F(Audio_MixerTest, OverrunsCount_FastBlocks)
+{
+    //! [GIVEN] Mixer with a track that is rendered much faster than real time
+    m_mixer->addChannel(1, std::make_shared<SourceStub>(std::chrono::microseconds(0)));
+
+    //! [WHEN] Process some blocks
+    processBlocks(10);
+
+    //! [THEN] No overrun is counted
+    EXPECT_EQ(m_mixer->overrunsCount(), 0);
+}
+
+TEST_F(Audio_MixerTest, OverrunsCount_SlowBlocks)
+{
+    //! [GIVEN] Mixer with a track that takes longer to render than the block lasts
+    m_mixer->addChannel(1, std::make_shared<SourceStub>(std::chrono::milliseconds(3)));
+
+    //! [WHEN] Process some blocks
+    processBlocks(5);
+
+    //! [THEN] Every block is counted as an overrun
+    EXPECT_EQ(m_mixer->overrunsCount(), 5);
+}
+
+TEST_F(Audio_MixerTest, Process_MixesAllTracks)
+{
+    //! [GIVEN] Mixer with more tracks than the worker pool has threads
+    constexpr TrackId TRACKS_COUNT = 16;
+    for (TrackId trackId = 0; trackId < TRACKS_COUNT; ++trackId) {
+        m_mixer->addChannel(trackId, std::make_shared<SourceStub>(std::chrono::microseconds(0)));
+    }
+
+    //! [WHEN] Process a block
+    processBlocks(1);
+
+    //! [THEN] The output of every track is available
+    for (TrackId trackId = 0; trackId < TRACKS_COUNT; ++trackId) {
+        const float* trackBuffer = m_mixer->trackChannelBuffer(trackId);
+        ASSERT_TRUE(trackBuffer);
+        EXPECT_GT(trackBuffer[0], 0.f);
+        EXPECT_GT(trackBuffer[BLOCK_SIZE * CHANNELS_COUNT - 1], 0.f);
+    }
+}
+}
@@ -0,0 +1,193 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include <QTemporaryDir>
+#include <QFile>
+
+#include "audio/internal/soundtracks/soundtrackwriter.h"
+#include "audio/internal/worker/audioengine.h"
+#include "audio/internal/audiobuffer.h"
+#include "audio/internal/audiosanitizer.h"
+#include "audio/audioerrors.h"
+#include "audio/tests/mocks/audioconfigurationmock.h"
+
+using ::testing::NiceMock;
+using ::testing::Return;
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::soundtrack;
+
+namespace mu::audio {
+class Audio_SoundTrackWriterTest : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        AudioSanitizer::setupWorkerThread();
+
+        m_configuration = std::make_shared<NiceMock<AudioConfigurationMock> >();
+        ON_CALL(*m_configuration, renderStep()).WillByDefault(Return(BLOCK_SIZE));
+        ON_CALL(*m_configuration, audioChannelsCount()).WillByDefault(Return(CHANNELS_COUNT));
+
+        modularity::ioc()->registerExport<IAudioConfiguration>("utests", m_configuration);
+
+        AudioEngine::instance()->init(std::make_shared<AudioBuffer>());
+
+        m_mixer = std::make_shared<Mixer>();
+        m_mixer->setAudioChannelsCount(CHANNELS_COUNT);
+        m_mixer->setSampleRate(SAMPLE_RATE);
+    }
+
+    void TearDown() override
+    {
+        m_mixer.reset();
+        AudioEngine::instance()->deinit();
+        modularity::ioc()->unregister<IAudioConfiguration>("utests");
+    }
+
+protected:
+    static constexpr samples_t BLOCK_SIZE = 48;
+    static constexpr audioch_t CHANNELS_COUNT = 2;
+    static constexpr unsigned int SAMPLE_RATE = 48000; // so a block lasts 1ms
+
+    //! NOTE Produces a constant signal
+    class SourceStub : public AbstractAudioSource
+    {
+    public:
+        explicit SourceStub(float value)
+            : m_value(value) {}
+
+        unsigned int audioChannelsCount() const override
+        {
+            return CHANNELS_COUNT;
+        }
+
+        samples_t process(float* buffer, samples_t samplesPerChannel) override
+        {
+            std::fill(buffer, buffer + samplesPerChannel * CHANNELS_COUNT, m_value);
+            return samplesPerChannel;
+        }
+
+    private:
+        float m_value = 0.f;
+    };
+
+    SoundTrackTarget wavTarget(const QString& path, TrackId trackId) const
+    {
+        SoundTrackFormat format;
+        format.type = SoundTrackType::WAV;
+        format.sampleRate = SAMPLE_RATE;
+        format.audioChannelsNumber = CHANNELS_COUNT;
+
+        return SoundTrackTarget { path, format, trackId };
+    }
+
+    //! NOTE The samples of a 32-bit float WAV file, written after the 46 bytes of the header
+    std::vector<float> readWavSamples(const QString& path) const
+    {
+        static constexpr qint64 HEADER_SIZE = 46;
+
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly) || file.size() < HEADER_SIZE) {
+            return {};
+        }
+
+        QByteArray data = file.readAll().mid(HEADER_SIZE);
+        std::vector<float> samples(data.size() / sizeof(float));
+        std::memcpy(samples.data(), data.constData(), samples.size() * sizeof(float));
+
+        return samples;
+    }
+
+    std::shared_ptr<NiceMock<AudioConfigurationMock> > m_configuration;
+    std::shared_ptr<Mixer> m_mixer;
+};
+
+TEST_F(Audio_SoundTrackWriterTest, Write_MasterMixAndStems)
+{
+    //! [GIVEN] Mixer with a quiet and a loud track
+    m_mixer->addChannel(1, std::make_shared<SourceStub>(0.1f));
+    m_mixer->addChannel(2, std::make_shared<SourceStub>(0.4f));
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    const QString masterPath = dir.filePath("master.wav");
+    const QString stem1Path = dir.filePath("track1.wav");
+    const QString stem2Path = dir.filePath("track2.wav");
+
+    //! [GIVEN] The master mix and a stem of every track are written at once
+    constexpr int BLOCKS_COUNT = 10;
+    constexpr msecs_t DURATION = BLOCKS_COUNT * 1000; // microseconds
+
+    SoundTrackWriter writer({ wavTarget(masterPath, MASTER_MIX_TRACK_ID), wavTarget(stem1Path, 1), wavTarget(stem2Path, 2) },
+                            DURATION, m_mixer);
+
+    //! [WHEN] Write the sound tracks
+    Ret ret = writer.write();
+
+    //! [THEN] The files are written
+    ASSERT_TRUE(ret) << ret.toString();
+
+    std::vector<float> master = readWavSamples(masterPath);
+    std::vector<float> stem1 = readWavSamples(stem1Path);
+    std::vector<float> stem2 = readWavSamples(stem2Path);
+
+    //! [THEN] Every file holds the whole duration
+    constexpr size_t SAMPLES_COUNT = BLOCKS_COUNT * BLOCK_SIZE * CHANNELS_COUNT;
+    EXPECT_EQ(master.size(), SAMPLES_COUNT);
+    ASSERT_EQ(stem1.size(), SAMPLES_COUNT);
+    ASSERT_EQ(stem2.size(), SAMPLES_COUNT);
+
+    //! [THEN] Every stem only holds the signal of its own track
+    for (size_t i = 0; i < SAMPLES_COUNT; ++i) {
+        EXPECT_GT(stem1[i], 0.f);
+        EXPECT_FLOAT_EQ(stem1[i], stem1[0]);
+        EXPECT_FLOAT_EQ(stem2[i], stem2[0]);
+    }
+
+    EXPECT_GT(stem2[0], stem1[0]);
+}
+
+TEST_F(Audio_SoundTrackWriterTest, Write_UnknownStemTrack)
+{
+    //! [GIVEN] Mixer with one track
+    m_mixer->addChannel(1, std::make_shared<SourceStub>(0.1f));
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    //! [GIVEN] A stem of a track the mixer doesn't have
+    SoundTrackWriter writer({ wavTarget(dir.filePath("track2.wav"), 2) }, 1000, m_mixer);
+
+    //! [WHEN] Write the sound tracks
+    Ret ret = writer.write();
+
+    //! [THEN] Nothing is written
+    EXPECT_EQ(ret.code(), static_cast<int>(Err::InvalidTrackId));
+}
+}
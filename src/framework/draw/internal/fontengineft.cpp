@@ -21,9 +21,15 @@
  */
 #include "fontengineft.h"
 
-#include <QHash>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <unordered_map>
 
 #include "io/file.h"
+#include "io/dir.h"
 
 #include "ft2build.h"
 #include FT_FREETYPE_H
@@ -34,9 +40,13 @@
 
 static FT_Library ftlib = nullptr;
 
+using namespace mu;
 using namespace mu::io;
 using namespace mu::draw;
 
+static constexpr char METRICS_CACHE_MAGIC[8] = { 'M', 'U', 'F', 'T', 'M', 'E', 'T', 'R' };
+static constexpr uint32_t METRICS_CACHE_VERSION = 1;
+
 static bool _init_ft()
 {
     int error = 0;
@@ -49,17 +59,38 @@ static bool _init_ft()
     return error == 0;
 }
 
+static uint64_t fontDataHash(const ByteArray& data)
+{
+    //! NOTE FNV-1a, the hash must be the same on every run
+    uint64_t hash = 14695981039346656037ull;
+    const uint8_t* bytes = data.constData();
+    for (size_t i = 0; i < data.size(); ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
 struct mu::draw::FTGlyphMetrics
 {
     FT_BBox bb;
     double linearHoriAdvance = 0.0;
+    bool exists = false;
 };
 
 struct mu::draw::FTData
 {
     ByteArray fontData;
     FT_Face face = nullptr;
-    QHash<char32_t, FTGlyphMetrics> metrics;
+
+    //! NOTE The face is not thread safe, so loading glyphs and the loaded metrics are guarded
+    std::mutex mutex;
+    std::unordered_map<char32_t, FTGlyphMetrics> metrics;
+
+    //! NOTE Mapped metrics cache, sorted by ucs4, it is read only and is read without locking
+    ByteArray metricsCacheData;
+    const FTCachedGlyphMetrics* cachedMetrics = nullptr;
+    size_t cachedMetricsCount = 0;
 };
 
 FontEngineFT::FontEngineFT()
@@ -69,23 +100,25 @@ FontEngineFT::FontEngineFT()
 
 FontEngineFT::~FontEngineFT()
 {
+    if (m_data->face) {
+        FT_Done_Face(m_data->face);
+    }
+
     delete m_data;
 }
 
-bool FontEngineFT::load(const io::path_t& path)
+bool FontEngineFT::load(const io::path_t& path, const io::path_t& metricsCacheDir)
 {
     if (!_init_ft()) {
         return false;
     }
 
-    File f(path);
-    if (!f.open(IODevice::ReadOnly)) {
-        LOGE() << "failed open font: " << path;
+    Ret ret = File::mapFile(path, m_data->fontData);
+    if (!ret) {
+        LOGE() << "failed open font: " << path << ", err: " << ret.toString();
         return false;
     }
 
-    m_data->fontData = f.readAll();
-
     int rval = FT_New_Memory_Face(ftlib, (FT_Byte*)m_data->fontData.constData(), (FT_Long)m_data->fontData.size(), 0, &m_data->face);
     if (rval) {
         LOGE() << "freetype: cannot create face: " << path << ", rval: " << rval;
@@ -96,17 +129,136 @@ bool FontEngineFT::load(const io::path_t& path)
     double pixelSize = 200.0;
     FT_Set_Pixel_Sizes(m_data->face, 0, int(pixelSize + .5));
 
+    if (metricsCacheDir.empty()) {
+        return true;
+    }
+
+    uint64_t fontHash = fontDataHash(m_data->fontData);
+    io::path_t cachePath = metricsCacheDir + "/" + io::path_t(std::to_string(fontHash)) + ".ftmetrics";
+
+    if (readMetricsCache(cachePath, fontHash)) {
+        return true;
+    }
+
+    preloadGlyphMetrics();
+
+    ret = Dir::mkpath(metricsCacheDir);
+    if (!ret) {
+        LOGE() << "failed create dir: " << metricsCacheDir << ", err: " << ret.toString();
+        return true;
+    }
+
+    writeMetricsCache(cachePath, fontHash);
+
     return true;
 }
 
+bool FontEngineFT::readMetricsCache(const io::path_t& cachePath, uint64_t fontHash)
+{
+    if (!File::exists(cachePath)) {
+        return false;
+    }
+
+    ByteArray data;
+    Ret ret = File::mapFile(cachePath, data);
+    if (!ret) {
+        LOGE() << "failed open font metrics cache: " << cachePath << ", err: " << ret.toString();
+        return false;
+    }
+
+    if (data.size() < sizeof(FTMetricsCacheHeader)) {
+        LOGW() << "broken font metrics cache: " << cachePath;
+        return false;
+    }
+
+    FTMetricsCacheHeader header;
+    std::memcpy(&header, data.constData(), sizeof(header));
+
+    bool valid = std::memcmp(header.magic, METRICS_CACHE_MAGIC, sizeof(header.magic)) == 0
+                 && header.version == METRICS_CACHE_VERSION
+                 && header.fontHash == fontHash
+                 && header.fontSize == m_data->fontData.size()
+                 && data.size() == sizeof(FTMetricsCacheHeader) + header.count * sizeof(FTCachedGlyphMetrics);
+
+    if (!valid) {
+        LOGW() << "outdated font metrics cache: " << cachePath;
+        return false;
+    }
+
+    m_data->metricsCacheData = data;
+    const uint8_t* glyphsData = m_data->metricsCacheData.constData() + sizeof(FTMetricsCacheHeader);
+    m_data->cachedMetrics = reinterpret_cast<const FTCachedGlyphMetrics*>(glyphsData);
+    m_data->cachedMetricsCount = header.count;
+
+    return true;
+}
+
+void FontEngineFT::preloadGlyphMetrics()
+{
+    TRACEFUNC;
+
+    FT_UInt index = 0;
+    FT_ULong ucs4 = FT_Get_First_Char(m_data->face, &index);
+    while (index != 0) {
+        FTGlyphMetrics gm;
+        loadGlyphMetrics(static_cast<char32_t>(ucs4), gm);
+        ucs4 = FT_Get_Next_Char(m_data->face, ucs4, &index);
+    }
+}
+
+void FontEngineFT::writeMetricsCache(const io::path_t& cachePath, uint64_t fontHash) const
+{
+    std::vector<FTCachedGlyphMetrics> glyphs;
+
+    {
+        std::lock_guard<std::mutex> lock(m_data->mutex);
+        glyphs.reserve(m_data->metrics.size());
+        for (const auto& p : m_data->metrics) {
+            if (!p.second.exists) {
+                continue;
+            }
+
+            FTCachedGlyphMetrics g;
+            g.ucs4 = static_cast<uint32_t>(p.first);
+            g.xMin = p.second.bb.xMin;
+            g.yMin = p.second.bb.yMin;
+            g.xMax = p.second.bb.xMax;
+            g.yMax = p.second.bb.yMax;
+            g.linearHoriAdvance = static_cast<int64_t>(p.second.linearHoriAdvance);
+            glyphs.push_back(g);
+        }
+    }
+
+    std::sort(glyphs.begin(), glyphs.end(), [](const FTCachedGlyphMetrics& g1, const FTCachedGlyphMetrics& g2) {
+        return g1.ucs4 < g2.ucs4;
+    });
+
+    FTMetricsCacheHeader header;
+    std::memcpy(header.magic, METRICS_CACHE_MAGIC, sizeof(header.magic));
+    header.version = METRICS_CACHE_VERSION;
+    header.count = static_cast<uint32_t>(glyphs.size());
+    header.fontHash = fontHash;
+    header.fontSize = m_data->fontData.size();
+
+    ByteArray data;
+    data.reserve(sizeof(header) + glyphs.size() * sizeof(FTCachedGlyphMetrics));
+    data.push_back(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+    data.push_back(reinterpret_cast<const uint8_t*>(glyphs.data()), glyphs.size() * sizeof(FTCachedGlyphMetrics));
+
+    Ret ret = File::writeFile(cachePath, data);
+    if (!ret) {
+        LOGE() << "failed write font metrics cache: " << cachePath << ", err: " << ret.toString();
+    }
+}
+
 QRectF FontEngineFT::bbox(char32_t ucs4, double dpi_f) const
 {
-    FTGlyphMetrics* gm = glyphMetrics(ucs4);
-    if (!gm) {
+    FTGlyphMetrics gm;
+    if (!glyphMetrics(ucs4, gm)) {
         return QRectF();
     }
 
-    const FT_BBox& bb = gm->bb;
+    const FT_BBox& bb = gm.bb;
     //! NOTE Moved form sym.cpp ScoreFont::computeMetrics as is
     double m = 640.0 / dpi_f;
     QRectF bbox;
@@ -116,38 +268,72 @@ QRectF FontEngineFT::bbox(char32_t ucs4, double dpi_f) const
 
 double FontEngineFT::advance(char32_t ucs4, double dpi_f) const
 {
-    FTGlyphMetrics* gm = glyphMetrics(ucs4);
-    if (!gm) {
+    FTGlyphMetrics gm;
+    if (!glyphMetrics(ucs4, gm)) {
         return 0.0;
     }
 
     //! NOTE Moved form sym.cpp ScoreFont::computeMetrics as is
-    return gm->linearHoriAdvance * dpi_f / 655360.0;
+    return gm.linearHoriAdvance * dpi_f / 655360.0;
 }
 
-FTGlyphMetrics* FontEngineFT::glyphMetrics(char32_t ucs4) const
+bool FontEngineFT::glyphMetrics(char32_t ucs4, FTGlyphMetrics& out) const
 {
-    if (m_data->metrics.contains(ucs4)) {
-        return &m_data->metrics[ucs4];
+    if (m_data->cachedMetrics) {
+        //! NOTE The cache holds all the glyphs of the font, so a glyph that is not there does not exist
+        const FTCachedGlyphMetrics* begin = m_data->cachedMetrics;
+        const FTCachedGlyphMetrics* end = m_data->cachedMetrics + m_data->cachedMetricsCount;
+        const FTCachedGlyphMetrics* it = std::lower_bound(begin, end, ucs4, [](const FTCachedGlyphMetrics& g, char32_t c) {
+            return g.ucs4 < static_cast<uint32_t>(c);
+        });
+
+        if (it == end || it->ucs4 != static_cast<uint32_t>(ucs4)) {
+            return false;
+        }
+
+        out.bb.xMin = static_cast<FT_Pos>(it->xMin);
+        out.bb.yMin = static_cast<FT_Pos>(it->yMin);
+        out.bb.xMax = static_cast<FT_Pos>(it->xMax);
+        out.bb.yMax = static_cast<FT_Pos>(it->yMax);
+        out.linearHoriAdvance = static_cast<double>(it->linearHoriAdvance);
+        out.exists = true;
+        return true;
     }
 
+    return loadGlyphMetrics(ucs4, out);
+}
+
+bool FontEngineFT::loadGlyphMetrics(char32_t ucs4, FTGlyphMetrics& out) const
+{
+    std::lock_guard<std::mutex> lock(m_data->mutex);
+
+    auto it = m_data->metrics.find(ucs4);
+    if (it != m_data->metrics.end()) {
+        out = it->second;
+        return out.exists;
+    }
+
+    //! NOTE Missing glyphs are remembered too, they are asked for again and again
+    FTGlyphMetrics& gm = m_data->metrics[ucs4];
+
     FT_UInt index = FT_Get_Char_Index(m_data->face, ucs4);
     if (index == 0) {
-        return nullptr;
+        return false;
     }
 
     if (FT_Load_Glyph(m_data->face, index, FT_LOAD_DEFAULT) != 0) {
-        return nullptr;
+        return false;
     }
 
     FT_BBox bb;
     if (FT_Outline_Get_BBox(&m_data->face->glyph->outline, &bb) != 0) {
-        return nullptr;
+        return false;
     }
 
-    FTGlyphMetrics& gm = m_data->metrics[ucs4];
     gm.bb = bb;
     gm.linearHoriAdvance = m_data->face->glyph->linearHoriAdvance;
+    gm.exists = true;
 
-    return &gm;
+    out = gm;
+    return true;
 }
@@ -22,26 +22,58 @@
 #ifndef MU_DRAW_FONTENGINEFT_H
 #define MU_DRAW_FONTENGINEFT_H
 
+#include <cstdint>
+
 #include <QRectF>
 #include "io/path.h"
 
 namespace mu::draw {
 struct FTData;
 struct FTGlyphMetrics;
+
+//! NOTE The layout of the metrics cache file: the header, then the glyphs sorted by ucs4.
+//! It is only read on the machine that wrote it
+struct FTMetricsCacheHeader
+{
+    char magic[8];
+    uint32_t version = 0;
+    uint32_t count = 0;
+    uint64_t fontHash = 0;
+    uint64_t fontSize = 0;
+};
+
+struct FTCachedGlyphMetrics
+{
+    uint32_t ucs4 = 0;
+    uint32_t reserved = 0;
+    int64_t xMin = 0;
+    int64_t yMin = 0;
+    int64_t xMax = 0;
+    int64_t yMax = 0;
+    int64_t linearHoriAdvance = 0;
+};
+
 class FontEngineFT
 {
 public:
     FontEngineFT();
     ~FontEngineFT();
 
-    bool load(const io::path_t& path);
+    //! NOTE If the metrics cache dir is set, the metrics of all the glyphs of the font are stored there
+    //! on the first load and are read from there on the next loads
+    bool load(const io::path_t& path, const io::path_t& metricsCacheDir = io::path_t());
 
     QRectF bbox(char32_t ucs4, double DPI_F) const;
     double advance(char32_t ucs4, double DPI_F) const;
 
 private:
 
-    FTGlyphMetrics* glyphMetrics(char32_t ucs4) const;
+    bool glyphMetrics(char32_t ucs4, FTGlyphMetrics& out) const;
+    bool loadGlyphMetrics(char32_t ucs4, FTGlyphMetrics& out) const;
+
+    bool readMetricsCache(const io::path_t& cachePath, uint64_t fontHash);
+    void preloadGlyphMetrics();
+    void writeMetricsCache(const io::path_t& cachePath, uint64_t fontHash) const;
 
     FTData* m_data = nullptr;
 };
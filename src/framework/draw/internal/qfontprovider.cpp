@@ -56,43 +56,64 @@ static FontPaintDevice device;
 
 int QFontProvider::addSymbolFont(const String& family, const io::path_t& path)
 {
-    m_symbolsFonts[family] = path;
+    {
+        std::lock_guard<std::mutex> lock(m_symEnginesMutex);
+        m_symbolsFonts[family] = path;
+    }
+    m_textMetricsCache.clear();
     return QFontDatabase::addApplicationFont(path.toQString());
 }
 
 int QFontProvider::addTextFont(const io::path_t& path)
 {
+    m_textMetricsCache.clear();
     return QFontDatabase::addApplicationFont(path.toQString());
 }
 
 void QFontProvider::insertSubstitution(const String& familyName, const String& substituteName)
 {
     QFont::insertSubstitution(familyName, substituteName);
+    m_textMetricsCache.clear();
+}
+
+TextMetricsCache::FontValues QFontProvider::fontValues(const Font& f) const
+{
+    return m_textMetricsCache.fontValues(f, [&f]() {
+        QFontMetricsF fm(f.toQFont(), &device);
+
+        TextMetricsCache::FontValues values;
+        values.lineSpacing = fm.lineSpacing();
+        values.xHeight = fm.xHeight();
+        values.height = fm.height();
+        values.ascent = fm.ascent();
+        values.descent = fm.descent();
+        return values;
+    });
 }
 
 double QFontProvider::lineSpacing(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).lineSpacing();
+    return fontValues(f).lineSpacing;
 }
 
 double QFontProvider::xHeight(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).xHeight();
+    return fontValues(f).xHeight;
 }
 
 double QFontProvider::height(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).height();
+    return fontValues(f).height;
 }
 
 double QFontProvider::ascent(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).ascent();
+    return fontValues(f).ascent;
 }
 
 double QFontProvider::descent(const Font& f) const
 {
-    return QFontMetricsF(f.toQFont(), &device).descent();
+    return fontValues(f).descent;
 }
 
 bool QFontProvider::inFont(const Font& f, Char ch) const
@@ -114,7 +135,9 @@ bool QFontProvider::inFontUcs4(const Font& f, char32_t ucs4) const
 
 double QFontProvider::horizontalAdvance(const Font& f, const String& string) const
 {
-    return QFontMetricsF(f.toQFont(), &device).horizontalAdvance(string);
+    return m_textMetricsCache.horizontalAdvance(f, string, [&f, &string]() {
+        return QFontMetricsF(f.toQFont(), &device).horizontalAdvance(string);
+    });
 }
 
 double QFontProvider::horizontalAdvance(const Font& f, const Char& ch) const
@@ -124,7 +147,9 @@ double QFontProvider::horizontalAdvance(const Font& f, const Char& ch) const
 
 RectF QFontProvider::boundingRect(const Font& f, const String& string) const
 {
-    return RectF::fromQRectF(QFontMetricsF(f.toQFont(), &device).boundingRect(string));
+    return m_textMetricsCache.boundingRect(f, string, [&f, &string]() {
+        return RectF::fromQRectF(QFontMetricsF(f.toQFont(), &device).boundingRect(string));
+    });
 }
 
 RectF QFontProvider::boundingRect(const Font& f, const Char& ch) const
@@ -139,7 +164,9 @@ RectF QFontProvider::boundingRect(const Font& f, const RectF& r, int flags, cons
 
 RectF QFontProvider::tightBoundingRect(const Font& f, const String& string) const
 {
-    return RectF::fromQRectF(QFontMetricsF(f.toQFont(), &device).tightBoundingRect(string));
+    return m_textMetricsCache.tightBoundingRect(f, string, [&f, &string]() {
+        return RectF::fromQRectF(QFontMetricsF(f.toQFont(), &device).tightBoundingRect(string));
+    });
 }
 
 // Score symbols
@@ -197,8 +224,26 @@ double QFontProvider::symAdvance(const Font& f, char32_t ucs4, double dpi_f) con
     return symAdvance;
 }
 
+TextMetricsCache::Statistics QFontProvider::textMetricsCacheStatistics() const
+{
+    return m_textMetricsCache.statistics();
+}
+
+io::path_t QFontProvider::symMetricsCacheDir() const
+{
+    //! NOTE Not available in the tests and the tools that don't register the configuration
+    if (!globalConfiguration()) {
+        return io::path_t();
+    }
+
+    return globalConfiguration()->userAppDataPath() + "/fontmetrics";
+}
+
 FontEngineFT* QFontProvider::symEngine(const Font& f) const
 {
+    //! NOTE Symbols are measured from several layout threads
+    std::lock_guard<std::mutex> lock(m_symEnginesMutex);
+
     QString path = m_symbolsFonts.value(f.family()).toQString();
     if (path.isEmpty()) {
         return nullptr;
@@ -207,7 +252,7 @@ FontEngineFT* QFontProvider::symEngine(const Font& f) const
     FontEngineFT* engine = m_symEngines.value(path, nullptr);
     if (!engine) {
         engine = new FontEngineFT();
-        if (!engine->load(path)) {
+        if (!engine->load(path, symMetricsCacheDir())) {
             delete engine;
             return nullptr;
         }
@@ -22,13 +22,21 @@
 #ifndef MU_DRAW_QFONTPROVIDER_H
 #define MU_DRAW_QFONTPROVIDER_H
 
+#include <mutex>
 #include <QHash>
+
+#include "modularity/ioc.h"
+#include "iglobalconfiguration.h"
+
 #include "../ifontprovider.h"
+#include "textmetricscache.h"
 
 namespace mu::draw {
 class FontEngineFT;
 class QFontProvider : public IFontProvider
 {
+    INJECT(framework::IGlobalConfiguration, globalConfiguration)
+
 public:
     QFontProvider() = default;
 
@@ -58,12 +66,20 @@ public:
     RectF symBBox(const Font& f, char32_t ucs4, double DPI_F) const override;
     double symAdvance(const Font& f, char32_t ucs4, double DPI_F) const override;
 
+    TextMetricsCache::Statistics textMetricsCacheStatistics() const;
+
 private:
 
+    TextMetricsCache::FontValues fontValues(const Font& f) const;
+
     FontEngineFT* symEngine(const Font& f) const;
+    io::path_t symMetricsCacheDir() const;
 
     QHash<QString /*family*/, io::path_t> m_symbolsFonts;
     mutable QHash<QString /*path*/, FontEngineFT*> m_symEngines;
+    mutable std::mutex m_symEnginesMutex;
+
+    mutable TextMetricsCache m_textMetricsCache;
 };
 }
 
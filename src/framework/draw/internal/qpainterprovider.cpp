@@ -21,6 +21,7 @@
  */
 #include "qpainterprovider.h"
 
+#include <QCoreApplication>
 #include <QPainter>
 #include <QRawFont>
 #include <QTextLayout>
@@ -29,6 +30,7 @@
 #include <QPixmapCache>
 #include <QStaticText>
 #include <QPainterPath>
+#include <QThread>
 
 #include "draw/utils/drawlogger.h"
 #include "types/transform.h"
@@ -38,6 +40,13 @@
 
 using namespace mu::draw;
 
+//! NOTE QPixmap and QPixmapCache can be used only in the GUI thread,
+//! in other threads (ex. export of pages in parallel) images are drawn instead
+static bool isGuiThread()
+{
+    return QCoreApplication::instance() && QThread::currentThread() == QCoreApplication::instance()->thread();
+}
+
 QPainterProvider::QPainterProvider(QPainter* painter, bool ownsPainter)
     : m_painter(painter), m_ownsPainter(ownsPainter), m_drawObjectsLogger(new DrawObjectsLogger())
 {
@@ -313,6 +322,11 @@ void QPainterProvider::drawSymbol(const PointF& point, char32_t ucs4Code)
 
 void QPainterProvider::drawPixmap(const PointF& point, const Pixmap& pm)
 {
+    if (!isGuiThread()) {
+        m_painter->drawImage(QPointF(point.x(), point.y()), QImage::fromData(pm.data().toQByteArrayNoCopy()));
+        return;
+    }
+
     QString key = QString::number(pm.key());
     QPixmap pixmap;
     if (!QPixmapCache::find(key, &pixmap)) {
@@ -325,6 +339,13 @@ void QPainterProvider::drawPixmap(const PointF& point, const Pixmap& pm)
 
 void QPainterProvider::drawTiledPixmap(const RectF& rect, const Pixmap& pm, const PointF& offset)
 {
+    if (!isGuiThread()) {
+        QBrush brush(QImage::fromData(pm.data().toQByteArrayNoCopy()));
+        brush.setTransform(QTransform::fromTranslate(rect.x() - offset.x(), rect.y() - offset.y()));
+        m_painter->fillRect(rect.toQRectF(), brush);
+        return;
+    }
+
     QString key = QString::number(pm.key());
     QPixmap pixmap;
     if (!QPixmapCache::find(key, &pixmap)) {
@@ -0,0 +1,164 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "textmetricscache.h"
+
+using namespace mu;
+using namespace mu::draw;
+
+template<typename T>
+static void hashCombine(size_t& seed, const T& value)
+{
+    seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+bool TextMetricsCache::FontKey::operator==(const FontKey& other) const
+{
+    //! NOTE Font::operator== does not compare the pixel size
+    return font == other.font && font.pixelSize() == other.font.pixelSize();
+}
+
+size_t TextMetricsCache::FontKeyHash::operator()(const FontKey& k) const
+{
+    size_t seed = k.font.family().hash();
+    hashCombine(seed, k.font.pointSizeF());
+    hashCombine(seed, k.font.pixelSize());
+    hashCombine(seed, static_cast<int>(k.font.weight()));
+    hashCombine(seed, k.font.bold());
+    hashCombine(seed, k.font.italic());
+    hashCombine(seed, k.font.underline());
+    hashCombine(seed, k.font.strike());
+    hashCombine(seed, k.font.noFontMerging());
+    hashCombine(seed, static_cast<int>(k.font.hinting()));
+    return seed;
+}
+
+bool TextMetricsCache::TextKey::operator==(const TextKey& other) const
+{
+    return metric == other.metric && string == other.string && font == other.font;
+}
+
+size_t TextMetricsCache::TextKeyHash::operator()(const TextKey& k) const
+{
+    size_t seed = FontKeyHash()(k.font);
+    hashCombine(seed, k.string.hash());
+    hashCombine(seed, static_cast<int>(k.metric));
+    return seed;
+}
+
+TextMetricsCache::TextMetricsCache(size_t maxTextEntries)
+    : m_maxTextEntries(maxTextEntries)
+{
+}
+
+TextMetricsCache::FontValues TextMetricsCache::fontValues(const Font& f, const std::function<FontValues()>& measure)
+{
+    FontKey key { f };
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_fontValues.find(key);
+        if (it != m_fontValues.end()) {
+            ++m_hits;
+            return it->second;
+        }
+    }
+
+    ++m_misses;
+    FontValues values = measure();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_fontValues.emplace(std::move(key), values);
+
+    return values;
+}
+
+double TextMetricsCache::horizontalAdvance(const Font& f, const String& string, const std::function<double()>& measure)
+{
+    return textValue(Metric::HorizontalAdvance, f, string, [&measure]() {
+        return RectF(0.0, 0.0, measure(), 0.0);
+    }).width();
+}
+
+RectF TextMetricsCache::boundingRect(const Font& f, const String& string, const std::function<RectF()>& measure)
+{
+    return textValue(Metric::BoundingRect, f, string, measure);
+}
+
+RectF TextMetricsCache::tightBoundingRect(const Font& f, const String& string, const std::function<RectF()>& measure)
+{
+    return textValue(Metric::TightBoundingRect, f, string, measure);
+}
+
+RectF TextMetricsCache::textValue(Metric metric, const Font& f, const String& string, const std::function<RectF()>& measure)
+{
+    TextKey key { FontKey { f }, string, metric };
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_textValues.find(key);
+        if (it != m_textValues.end()) {
+            ++m_hits;
+            return it->second;
+        }
+    }
+
+    ++m_misses;
+    RectF value = measure();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    //! NOTE Arbitrary text is typed in, so the cache must not grow forever
+    if (m_textValues.size() >= m_maxTextEntries) {
+        m_textValues.clear();
+    }
+
+    m_textValues.emplace(std::move(key), value);
+
+    return value;
+}
+
+void TextMetricsCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_fontValues.clear();
+    m_textValues.clear();
+}
+
+size_t TextMetricsCache::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_fontValues.size() + m_textValues.size();
+}
+
+TextMetricsCache::Statistics TextMetricsCache::statistics() const
+{
+    Statistics statistics;
+    statistics.hits = m_hits;
+    statistics.misses = m_misses;
+    return statistics;
+}
+
+void TextMetricsCache::resetStatistics()
+{
+    m_hits = 0;
+    m_misses = 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_DRAW_TEXTMETRICSCACHE_H
+#define MU_DRAW_TEXTMETRICSCACHE_H
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+#include "types/string.h"
+#include "../types/font.h"
+#include "../types/geometry.h"
+
+namespace mu::draw {
+//! NOTE Text layout asks for the metrics of the same few strings over and over
+//! (measure numbers, lyrics, chord symbols, dynamics), and every request shapes the text again.
+//! The cache is shared by all threads, the values are measured outside of the lock
+class TextMetricsCache
+{
+public:
+    struct FontValues {
+        double lineSpacing = 0.0;
+        double xHeight = 0.0;
+        double height = 0.0;
+        double ascent = 0.0;
+        double descent = 0.0;
+    };
+
+    struct Statistics {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+
+        double hitRate() const { return (hits + misses) > 0 ? double(hits) / double(hits + misses) : 0.0; }
+    };
+
+    TextMetricsCache(size_t maxTextEntries = 1 << 16);
+
+    FontValues fontValues(const Font& f, const std::function<FontValues()>& measure);
+
+    double horizontalAdvance(const Font& f, const String& string, const std::function<double()>& measure);
+    RectF boundingRect(const Font& f, const String& string, const std::function<RectF()>& measure);
+    RectF tightBoundingRect(const Font& f, const String& string, const std::function<RectF()>& measure);
+
+    void clear();
+
+    size_t size() const;
+    Statistics statistics() const;
+    void resetStatistics();
+
+private:
+    enum class Metric {
+        HorizontalAdvance,
+        BoundingRect,
+        TightBoundingRect
+    };
+
+    struct FontKey {
+        Font font;
+
+        bool operator==(const FontKey& other) const;
+    };
+
+    struct FontKeyHash {
+        size_t operator()(const FontKey& k) const;
+    };
+
+    struct TextKey {
+        FontKey font;
+        String string;
+        Metric metric = Metric::HorizontalAdvance;
+
+        bool operator==(const TextKey& other) const;
+    };
+
+    struct TextKeyHash {
+        size_t operator()(const TextKey& k) const;
+    };
+
+    RectF textValue(Metric metric, const Font& f, const String& string, const std::function<RectF()>& measure);
+
+    size_t m_maxTextEntries = 0;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<FontKey, FontValues, FontKeyHash> m_fontValues;
+    std::unordered_map<TextKey, RectF, TextKeyHash> m_textValues;
+
+    std::atomic<uint64_t> m_hits = 0;
+    std::atomic<uint64_t> m_misses = 0;
+};
+}
+
+#endif // MU_DRAW_TEXTMETRICSCACHE_H
@@ -0,0 +1,289 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "draw/internal/fontengineft.h"
+
+using namespace mu;
+using namespace mu::draw;
+
+static const io::path_t FONT_PATH = io::path_t(draw_tests_DATA_ROOT) + "/leland/Leland.otf";
+
+static constexpr char32_t NOTEHEAD_BLACK = 0xE0A4;
+static constexpr char32_t MISSING_GLYPH = 0x10FFFD;
+
+static constexpr double DPI_F = 5.0;
+
+class Draw_FontEngineFTTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_cacheDir.isValid());
+    }
+
+    io::path_t cacheDir() const
+    {
+        return io::path_t(m_cacheDir.path());
+    }
+
+    //! NOTE There is one cache file per font
+    QString cacheFilePath() const
+    {
+        QStringList files = QDir(m_cacheDir.path()).entryList({ "*.ftmetrics" }, QDir::Files);
+        return files.size() == 1 ? m_cacheDir.filePath(files.first()) : QString();
+    }
+
+    QByteArray readCache() const
+    {
+        QFile file(cacheFilePath());
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    }
+
+    void writeCache(const QByteArray& data) const
+    {
+        QFile file(cacheFilePath());
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        ASSERT_EQ(file.write(data), data.size());
+    }
+
+    static FTMetricsCacheHeader header(const QByteArray& data)
+    {
+        FTMetricsCacheHeader h;
+        std::memcpy(&h, data.constData(), sizeof(h));
+        return h;
+    }
+
+    static void setHeader(QByteArray& data, const FTMetricsCacheHeader& h)
+    {
+        std::memcpy(data.data(), &h, sizeof(h));
+    }
+
+    static FTCachedGlyphMetrics* cachedGlyph(QByteArray& data, char32_t ucs4)
+    {
+        FTMetricsCacheHeader h = header(data);
+        char* glyphsData = data.data() + sizeof(FTMetricsCacheHeader);
+        FTCachedGlyphMetrics* glyphs = reinterpret_cast<FTCachedGlyphMetrics*>(glyphsData);
+        for (uint32_t i = 0; i < h.count; ++i) {
+            if (glyphs[i].ucs4 == static_cast<uint32_t>(ucs4)) {
+                return &glyphs[i];
+            }
+        }
+        return nullptr;
+    }
+
+    //! NOTE Puts a value into the cache, which FreeType would never give,
+    //! so it is seen whether the metrics are taken from the cache
+    void markCachedAdvance()
+    {
+        QByteArray data = readCache();
+        FTCachedGlyphMetrics* glyph = cachedGlyph(data, NOTEHEAD_BLACK);
+        ASSERT_TRUE(glyph);
+        glyph->linearHoriAdvance = MARKED_ADVANCE;
+        writeCache(data);
+    }
+
+    static double markedAdvance()
+    {
+        return MARKED_ADVANCE * DPI_F / 655360.0;
+    }
+
+private:
+    static constexpr int64_t MARKED_ADVANCE = 12345LL * 65536;
+
+    QTemporaryDir m_cacheDir;
+};
+
+TEST_F(Draw_FontEngineFTTests, MetricsCache_WrittenAndMapped)
+{
+    //! GIVEN The metrics loaded without a cache
+    FontEngineFT reference;
+    ASSERT_TRUE(reference.load(FONT_PATH));
+
+    QRectF bbox = reference.bbox(NOTEHEAD_BLACK, DPI_F);
+    double advance = reference.advance(NOTEHEAD_BLACK, DPI_F);
+    EXPECT_FALSE(bbox.isEmpty());
+    EXPECT_GT(advance, 0.0);
+
+    //! DO Load the font with a cache dir
+    {
+        FontEngineFT engine;
+        ASSERT_TRUE(engine.load(FONT_PATH, cacheDir()));
+
+        //! CHECK The cache is written, the metrics are the same
+        EXPECT_FALSE(cacheFilePath().isEmpty());
+        EXPECT_EQ(engine.bbox(NOTEHEAD_BLACK, DPI_F), bbox);
+        EXPECT_DOUBLE_EQ(engine.advance(NOTEHEAD_BLACK, DPI_F), advance);
+    }
+
+    //! CHECK The cache is valid and sorted
+    QByteArray data = readCache();
+    ASSERT_GE(static_cast<size_t>(data.size()), sizeof(FTMetricsCacheHeader));
+    FTMetricsCacheHeader h = header(data);
+    EXPECT_GT(h.count, 0u);
+    EXPECT_EQ(static_cast<size_t>(data.size()), sizeof(FTMetricsCacheHeader) + h.count * sizeof(FTCachedGlyphMetrics));
+
+    const char* glyphsData = data.constData() + sizeof(FTMetricsCacheHeader);
+    const FTCachedGlyphMetrics* glyphs = reinterpret_cast<const FTCachedGlyphMetrics*>(glyphsData);
+    for (uint32_t i = 1; i < h.count; ++i) {
+        EXPECT_LT(glyphs[i - 1].ucs4, glyphs[i].ucs4);
+    }
+
+    //! DO Load the font again
+    {
+        FontEngineFT engine;
+        ASSERT_TRUE(engine.load(FONT_PATH, cacheDir()));
+
+        //! CHECK The metrics are the same
+        EXPECT_EQ(engine.bbox(NOTEHEAD_BLACK, DPI_F), bbox);
+        EXPECT_DOUBLE_EQ(engine.advance(NOTEHEAD_BLACK, DPI_F), advance);
+    }
+
+    //! DO Change the cached metrics and load the font again
+    markCachedAdvance();
+
+    FontEngineFT marked;
+    ASSERT_TRUE(marked.load(FONT_PATH, cacheDir()));
+
+    //! CHECK The metrics are read from the cache, the font isn't asked
+    EXPECT_DOUBLE_EQ(marked.advance(NOTEHEAD_BLACK, DPI_F), markedAdvance());
+    EXPECT_EQ(marked.bbox(NOTEHEAD_BLACK, DPI_F), bbox);
+}
+
+TEST_F(Draw_FontEngineFTTests, MetricsCache_Rejected)
+{
+    //! GIVEN A cache written by the first load
+    double advance = 0.0;
+    {
+        FontEngineFT engine;
+        ASSERT_TRUE(engine.load(FONT_PATH, cacheDir()));
+        advance = engine.advance(NOTEHEAD_BLACK, DPI_F);
+    }
+
+    markCachedAdvance();
+    const QByteArray valid = readCache();
+
+    auto check = [this, advance](const QByteArray& broken) {
+        writeCache(broken);
+
+        //! DO Load the font with the broken cache
+        FontEngineFT engine;
+        ASSERT_TRUE(engine.load(FONT_PATH, cacheDir()));
+
+        //! CHECK The cache isn't used, the metrics are loaded from the font
+        EXPECT_DOUBLE_EQ(engine.advance(NOTEHEAD_BLACK, DPI_F), advance);
+
+        //! CHECK The cache is written again
+        QByteArray rewritten = readCache();
+        ASSERT_EQ(rewritten.size(), valid.size());
+        EXPECT_EQ(header(rewritten).count, header(valid).count);
+
+        FontEngineFT reloaded;
+        ASSERT_TRUE(reloaded.load(FONT_PATH, cacheDir()));
+        EXPECT_DOUBLE_EQ(reloaded.advance(NOTEHEAD_BLACK, DPI_F), advance);
+    };
+
+    //! GIVEN Bad magic
+    {
+        QByteArray data = valid;
+        FTMetricsCacheHeader h = header(data);
+        h.magic[0] = 'X';
+        setHeader(data, h);
+        check(data);
+    }
+
+    //! GIVEN Other version
+    {
+        QByteArray data = valid;
+        FTMetricsCacheHeader h = header(data);
+        h.version += 1;
+        setHeader(data, h);
+        check(data);
+    }
+
+    //! GIVEN Other font hash
+    {
+        QByteArray data = valid;
+        FTMetricsCacheHeader h = header(data);
+        h.fontHash += 1;
+        setHeader(data, h);
+        check(data);
+    }
+
+    //! GIVEN Other font size
+    {
+        QByteArray data = valid;
+        FTMetricsCacheHeader h = header(data);
+        h.fontSize += 1;
+        setHeader(data, h);
+        check(data);
+    }
+
+    //! GIVEN Truncated glyphs
+    {
+        QByteArray data = valid;
+        data.chop(sizeof(FTCachedGlyphMetrics) / 2);
+        check(data);
+    }
+
+    //! GIVEN Truncated header
+    {
+        check(valid.left(sizeof(FTMetricsCacheHeader) / 2));
+    }
+
+    //! GIVEN Empty file
+    {
+        check(QByteArray());
+    }
+}
+
+TEST_F(Draw_FontEngineFTTests, MissingGlyph)
+{
+    //! GIVEN The font loaded without and with the metrics cache
+    FontEngineFT noCache;
+    ASSERT_TRUE(noCache.load(FONT_PATH));
+
+    {
+        FontEngineFT writer;
+        ASSERT_TRUE(writer.load(FONT_PATH, cacheDir()));
+    }
+
+    FontEngineFT cached;
+    ASSERT_TRUE(cached.load(FONT_PATH, cacheDir()));
+
+    for (const FontEngineFT* engine : { &noCache, &cached }) {
+        //! CHECK A glyph, which isn't in the font, has no metrics, also when asked again
+        for (int i = 0; i < 2; ++i) {
+            EXPECT_TRUE(engine->bbox(MISSING_GLYPH, DPI_F).isNull());
+            EXPECT_DOUBLE_EQ(engine->advance(MISSING_GLYPH, DPI_F), 0.0);
+        }
+
+        //! CHECK The existing glyph still has metrics
+        EXPECT_GT(engine->advance(NOTEHEAD_BLACK, DPI_F), 0.0);
+    }
+}
@@ -0,0 +1,155 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include "draw/internal/textmetricscache.h"
+
+using namespace mu;
+using namespace mu::draw;
+
+class Draw_TextMetricsCacheTests : public ::testing::Test
+{
+public:
+};
+
+TEST_F(Draw_TextMetricsCacheTests, TextValues_MeasuredOnce)
+{
+    //! GIVEN Empty cache
+    TextMetricsCache cache;
+
+    Font font(u"Edwin", Font::Type::Text);
+    font.setPointSizeF(10.0);
+
+    int measured = 0;
+    auto measure = [&measured]() {
+        ++measured;
+        return 42.0;
+    };
+
+    //! DO Ask for the same string twice
+    double first = cache.horizontalAdvance(font, u"Allegro", measure);
+    double second = cache.horizontalAdvance(font, u"Allegro", measure);
+
+    //! CHECK Measured only once
+    EXPECT_DOUBLE_EQ(first, 42.0);
+    EXPECT_DOUBLE_EQ(second, 42.0);
+    EXPECT_EQ(measured, 1);
+    EXPECT_EQ(cache.statistics().hits, 1);
+    EXPECT_EQ(cache.statistics().misses, 1);
+    EXPECT_DOUBLE_EQ(cache.statistics().hitRate(), 0.5);
+}
+
+TEST_F(Draw_TextMetricsCacheTests, TextValues_KeyedByFontStringAndMetric)
+{
+    //! GIVEN Cache with a measured string
+    TextMetricsCache cache;
+
+    Font font(u"Edwin", Font::Type::Text);
+    font.setPointSizeF(10.0);
+
+    int measured = 0;
+    auto measureRect = [&measured]() {
+        ++measured;
+        return RectF(0.0, -8.0, 30.0, 10.0);
+    };
+
+    cache.boundingRect(font, u"mf", measureRect);
+
+    //! DO Change the string, the metric, the size, the style and the pixel size
+    cache.boundingRect(font, u"mp", measureRect);
+    cache.tightBoundingRect(font, u"mf", measureRect);
+
+    Font bigger = font;
+    bigger.setPointSizeF(12.0);
+    cache.boundingRect(bigger, u"mf", measureRect);
+
+    Font italic = font;
+    italic.setItalic(true);
+    cache.boundingRect(italic, u"mf", measureRect);
+
+    Font pixels = font;
+    pixels.setPixelSize(20);
+    cache.boundingRect(pixels, u"mf", measureRect);
+
+    //! CHECK Each of them is measured
+    EXPECT_EQ(measured, 6);
+    EXPECT_EQ(cache.statistics().hits, 0);
+
+    //! DO Ask again for the first one
+    RectF rect = cache.boundingRect(font, u"mf", measureRect);
+
+    //! CHECK Taken from the cache
+    EXPECT_EQ(measured, 6);
+    EXPECT_EQ(rect, RectF(0.0, -8.0, 30.0, 10.0));
+}
+
+TEST_F(Draw_TextMetricsCacheTests, FontValues_MeasuredOnce)
+{
+    //! GIVEN Empty cache
+    TextMetricsCache cache;
+
+    Font font(u"Edwin", Font::Type::Text);
+    font.setPointSizeF(10.0);
+
+    int measured = 0;
+    auto measure = [&measured]() {
+        ++measured;
+        TextMetricsCache::FontValues values;
+        values.ascent = 8.0;
+        values.descent = 2.0;
+        return values;
+    };
+
+    //! DO Ask for the font values twice
+    cache.fontValues(font, measure);
+    TextMetricsCache::FontValues values = cache.fontValues(font, measure);
+
+    //! CHECK Measured only once
+    EXPECT_EQ(measured, 1);
+    EXPECT_DOUBLE_EQ(values.ascent, 8.0);
+    EXPECT_DOUBLE_EQ(values.descent, 2.0);
+}
+
+TEST_F(Draw_TextMetricsCacheTests, TextValues_Bounded)
+{
+    //! GIVEN Cache limited to two strings
+    TextMetricsCache cache(2);
+
+    Font font(u"Edwin", Font::Type::Text);
+    font.setPointSizeF(10.0);
+
+    auto measure = []() { return 1.0; };
+
+    //! DO Measure three strings
+    cache.horizontalAdvance(font, u"1", measure);
+    cache.horizontalAdvance(font, u"2", measure);
+    cache.horizontalAdvance(font, u"3", measure);
+
+    //! CHECK The cache did not grow beyond the limit
+    EXPECT_LE(cache.size(), 2);
+
+    //! DO Clear
+    cache.clear();
+
+    //! CHECK
+    EXPECT_EQ(cache.size(), 0);
+}
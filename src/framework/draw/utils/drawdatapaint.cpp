@@ -27,7 +27,7 @@ using namespace mu;
 using namespace mu::draw;
 
 static void drawItem(IPaintProviderPtr& provider, const DrawData::Item& item, const std::map<int, DrawData::State>& states,
-                     const Color& overlay)
+                     const Color& overlay, const Transform* baseTransform = nullptr, double fontScale = 1.0)
 {
     // first draw obj itself
     for (const DrawData::Data& d : item.datas) {
@@ -37,6 +37,14 @@ static void drawItem(IPaintProviderPtr& provider, const DrawData::Item& item, co
             st.brush.setColor(overlay);
         }
 
+        if (baseTransform) {
+            st.transform = st.transform * (*baseTransform);
+        }
+
+        if (fontScale != 1.0 && st.font.pointSizeF() > 0) {
+            st.font.setPointSizeF(st.font.pointSizeF() * fontScale);
+        }
+
         provider->setPen(st.pen);
         provider->setBrush(st.brush);
         provider->setFont(st.font);
@@ -76,7 +84,7 @@ static void drawItem(IPaintProviderPtr& provider, const DrawData::Item& item, co
 
     // second draw chilren
     for (const DrawData::Item& ch : item.chilren) {
-        drawItem(provider, ch, states, overlay);
+        drawItem(provider, ch, states, overlay, baseTransform, fontScale);
     }
 }
 
@@ -85,3 +93,19 @@ void DrawDataPaint::paint(Painter* painter, const DrawDataPtr& data, const Color
     IPaintProviderPtr provider = painter->provider();
     drawItem(provider, data->item, data->states, overlay);
 }
+
+void DrawDataPaint::replay(Painter* painter, const DrawDataPtr& data, double fontScale)
+{
+    IF_ASSERT_FAILED(data) {
+        return;
+    }
+
+    //! NOTE The provider state is changed directly, the painter restores it after
+    painter->save();
+
+    IPaintProviderPtr provider = painter->provider();
+    Transform baseTransform = provider->transform();
+    drawItem(provider, data->item, data->states, Color(), &baseTransform, fontScale);
+
+    painter->restore();
+}
@@ -32,6 +32,11 @@ public:
     DrawDataPaint() = default;
 
     static void paint(Painter* painter, const DrawDataPtr& data, const Color& overlay = Color());
+
+    //! NOTE Draws the data on top of the current transformation of the painter.
+    //! fontScale is for data recorded for a device with another DPI,
+    //! the font sizes depend on the device DPI (see MScore::pixelRatio)
+    static void replay(Painter* painter, const DrawDataPtr& data, double fontScale = 1.0);
 };
 }
 
@@ -0,0 +1,215 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "taskscheduler.h"
+
+using namespace mu;
+
+static thread_local const TaskScheduler* s_currentScheduler = nullptr;
+static thread_local size_t s_currentWorkerIdx = 0;
+
+TaskScheduler::TaskScheduler(const thread_pool_size_t desiredThreadCount)
+    : m_threadPoolSize(vaildateThreadPoolCapacity(desiredThreadCount))
+{
+    m_workerQueues = std::make_unique<TaskQueue[]>(m_threadPoolSize);
+    m_threadPool = std::make_unique<std::thread[]>(m_threadPoolSize);
+
+    setupThreads();
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    waitForAllTasksComplete();
+    terminateThreads();
+}
+
+void TaskScheduler::setupThreads()
+{
+    m_isActive = true;
+    for (thread_pool_size_t i = 0; i < m_threadPoolSize; ++i) {
+        m_threadPool[i] = std::thread(&TaskScheduler::th_workerLoop, this, static_cast<size_t>(i));
+        m_threadIdSet.insert(m_threadPool[i].get_id());
+    }
+}
+
+void TaskScheduler::terminateThreads()
+{
+    {
+        std::lock_guard lock(m_sleepMutex);
+        m_isActive = false;
+    }
+    m_newTaskAvailableCv.notify_all();
+
+    for (thread_pool_size_t i = 0; i < m_threadPoolSize; ++i) {
+        m_threadPool[i].join();
+    }
+}
+
+thread_pool_size_t TaskScheduler::vaildateThreadPoolCapacity(const thread_pool_size_t desiredThreadCount)
+{
+    thread_pool_size_t maxCapacity = std::thread::hardware_concurrency();
+
+    if (maxCapacity <= 1) {
+        return 1;
+    }
+
+    thread_pool_size_t optimalCapacity = maxCapacity / 2;
+
+    if (desiredThreadCount <= 0) {
+        return optimalCapacity;
+    }
+
+    return desiredThreadCount;
+}
+
+size_t TaskScheduler::currentWorkerIdx() const
+{
+    return s_currentScheduler == this ? s_currentWorkerIdx : NO_WORKER;
+}
+
+void TaskScheduler::pushTask(Task&& task, TaskPriority priority)
+{
+    IF_ASSERT_FAILED(task) {
+        return;
+    }
+
+    size_t lane = static_cast<size_t>(priority);
+    size_t workerIdx = currentWorkerIdx();
+
+    m_unfinishedTasksCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (workerIdx != NO_WORKER) {
+        TaskQueue& queue = m_workerQueues[workerIdx];
+        std::lock_guard lock(queue.mutex);
+        queue.lanes[lane].push_back(std::move(task));
+    } else {
+        std::lock_guard lock(m_sharedQueue.mutex);
+        m_sharedQueue.lanes[lane].push_back(std::move(task));
+    }
+
+    {
+        //! NOTE Taking the mutex guarantees that a worker going to sleep can't miss this task
+        std::lock_guard lock(m_sleepMutex);
+        m_queuedTasksCount.fetch_add(1, std::memory_order_release);
+    }
+    m_newTaskAvailableCv.notify_one();
+}
+
+Task TaskScheduler::takeTask(size_t workerIdx)
+{
+    if (m_queuedTasksCount.load(std::memory_order_acquire) <= 0) {
+        return Task();
+    }
+
+    auto tryTake = [this](TaskQueue& queue, size_t lane, bool fromBack) -> Task {
+        std::lock_guard lock(queue.mutex);
+        std::deque<Task>& tasks = queue.lanes[lane];
+        if (tasks.empty()) {
+            return Task();
+        }
+
+        Task task;
+        if (fromBack) {
+            task = std::move(tasks.back());
+            tasks.pop_back();
+        } else {
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        m_queuedTasksCount.fetch_sub(1, std::memory_order_acq_rel);
+        return task;
+    };
+
+    for (size_t lane = 0; lane < LANES_COUNT; ++lane) {
+        //! NOTE Own tasks first, the most recent one is the most likely to be hot in the cache
+        if (workerIdx != NO_WORKER) {
+            if (Task task = tryTake(m_workerQueues[workerIdx], lane, true)) {
+                return task;
+            }
+        }
+
+        if (Task task = tryTake(m_sharedQueue, lane, false)) {
+            return task;
+        }
+
+        size_t firstVictimIdx = workerIdx != NO_WORKER ? workerIdx + 1 : 0;
+        for (size_t i = 0; i < m_threadPoolSize; ++i) {
+            size_t victimIdx = (firstVictimIdx + i) % m_threadPoolSize;
+            if (victimIdx == workerIdx) {
+                continue;
+            }
+
+            if (Task task = tryTake(m_workerQueues[victimIdx], lane, false)) {
+                return task;
+            }
+        }
+    }
+
+    return Task();
+}
+
+void TaskScheduler::runTask(Task& task)
+{
+    try {
+        task();
+    } catch (...) {
+        LOGE() << "Unhandled exception in a scheduled task";
+    }
+
+    if (m_unfinishedTasksCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard lock(m_sleepMutex);
+        m_taskFinishedCv.notify_all();
+    }
+}
+
+void TaskScheduler::waitForAllTasksComplete()
+{
+    //! NOTE Would wait for itself, use TaskGroup inside of tasks
+    IF_ASSERT_FAILED(currentWorkerIdx() == NO_WORKER) {
+        return;
+    }
+
+    std::unique_lock lock(m_sleepMutex);
+    m_taskFinishedCv.wait(lock, [this] { return m_unfinishedTasksCount.load(std::memory_order_acquire) == 0; });
+}
+
+void TaskScheduler::th_workerLoop(size_t workerIdx)
+{
+    s_currentScheduler = this;
+    s_currentWorkerIdx = workerIdx;
+
+    while (true) {
+        if (Task task = takeTask(workerIdx)) {
+            runTask(task);
+            continue;
+        }
+
+        std::unique_lock lock(m_sleepMutex);
+        m_newTaskAvailableCv.wait(lock, [this] {
+            return m_queuedTasksCount.load(std::memory_order_acquire) > 0 || !m_isActive;
+        });
+
+        if (!m_isActive) {
+            return;
+        }
+    }
+}
@@ -23,13 +23,18 @@
 #ifndef MU_GLOBAL_TASKCHEDULER_H
 #define MU_GLOBAL_TASKCHEDULER_H
 
+#include <algorithm>
+#include <array>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
 #include <atomic>
-#include <queue>
+#include <set>
 #include <thread>
 #include <type_traits>
 #include <utility>
@@ -39,6 +44,67 @@
 namespace mu {
 typedef std::invoke_result_t<decltype(std::thread::hardware_concurrency)> thread_pool_size_t;
 
+enum class TaskPriority {
+    RealTime = 0, // latency-sensitive work, e.g. audio rendering
+    Normal,
+    Background,   // bulk work, e.g. exports
+
+    Count
+};
+
+//! NOTE Move-only type-erased callable, so that tasks are never copied on their way through the queues
+class Task
+{
+public:
+    Task() = default;
+
+    template<typename FuncT, typename = std::enable_if_t<!std::is_same_v<std::decay_t<FuncT>, Task> > >
+    Task(FuncT&& func)
+        : m_callable(std::make_unique<Callable<std::decay_t<FuncT> > >(std::forward<FuncT>(func))) {}
+
+    Task(Task&&) = default;
+    Task& operator=(Task&&) = default;
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    explicit operator bool() const
+    {
+        return m_callable != nullptr;
+    }
+
+    void operator()()
+    {
+        m_callable->call();
+    }
+
+private:
+    struct ICallable {
+        virtual ~ICallable() = default;
+        virtual void call() = 0;
+    };
+
+    template<typename FuncT>
+    struct Callable : ICallable {
+        template<typename F>
+        explicit Callable(F&& f)
+            : func(std::forward<F>(f)) {}
+
+        void call() override
+        {
+            std::invoke(func);
+        }
+
+        FuncT func;
+    };
+
+    std::unique_ptr<ICallable> m_callable;
+};
+
+//! NOTE Work-stealing scheduler.
+//! Every worker owns a deque per priority lane: it pushes and pops its own tasks at the back,
+//! idle workers steal from the front of the others. Tasks pushed from outside of the pool
+//! go to the shared queue. Higher priority lanes are always drained first.
 class TaskScheduler
 {
 public:
@@ -50,18 +116,11 @@ public:
         return &s;
     }
 
-    explicit TaskScheduler(const thread_pool_size_t desiredThreadCount = 0)
-        : m_threadPoolSize(vaildateThreadPoolCapacity(desiredThreadCount)),
-        m_threadPool(std::make_unique<std::thread[]>(vaildateThreadPoolCapacity(desiredThreadCount)))
-    {
-        setupThreads();
-    }
+    explicit TaskScheduler(const thread_pool_size_t desiredThreadCount = 0);
+    ~TaskScheduler();
 
-    ~TaskScheduler()
-    {
-        waitForAllTasksComplete();
-        terminateThreads();
-    }
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
 
     thread_pool_size_t threadPoolSize() const
     {
@@ -71,141 +130,231 @@ public:
     template<typename FuncT, typename ... ArgsT>
     void push(FuncT&& task, ArgsT&&... args)
     {
-        std::function<void()> taskFunctor = std::bind(std::forward<FuncT>(task), std::forward<ArgsT>(args)...);
-        {
-            const std::lock_guard lock(m_mutex);
-            m_taskQueue.push(taskFunctor);
+        pushWithPriority(TaskPriority::Normal, std::forward<FuncT>(task), std::forward<ArgsT>(args)...);
+    }
+
+    template<typename FuncT, typename ... ArgsT>
+    void pushWithPriority(TaskPriority priority, FuncT&& task, ArgsT&&... args)
+    {
+        if constexpr (sizeof...(ArgsT) == 0) {
+            pushTask(Task(std::forward<FuncT>(task)), priority);
+        } else {
+            pushTask(Task(std::bind(std::forward<FuncT>(task), std::forward<ArgsT>(args)...)), priority);
         }
-        m_newTaskAvailableCv.notify_one();
     }
 
     template<typename FuncT, typename ... ArgsT, typename ReturnT = std::invoke_result_t<std::decay_t<FuncT>, std::decay_t<ArgsT>...> >
     std::future<ReturnT> submit(FuncT&& task, ArgsT&&... args)
     {
-        std::function<ReturnT()> taskFunctor = std::bind(std::forward<FuncT>(task), std::forward<ArgsT>(args)...);
-        std::shared_ptr<std::promise<ReturnT> > promise = std::make_shared<std::promise<ReturnT> >();
-        push([taskFunctor, promise] {
-            try {
-                if constexpr (std::is_void_v<ReturnT>) {
-                    std::invoke(taskFunctor);
-                    promise->set_value();
-                } else {
-                    promise->set_value(std::invoke(taskFunctor));
-                }
-            } catch (...) {
-                try {
-                    promise->set_exception(std::current_exception());
-                } catch (...) {
-                    LOGE() << "Unable to schedule a task";
-                }
-            }
-        });
-
-        return promise->get_future();
+        return submitWithPriority(TaskPriority::Normal, std::forward<FuncT>(task), std::forward<ArgsT>(args)...);
     }
 
-    void waitForAllTasksComplete()
+    template<typename FuncT, typename ... ArgsT, typename ReturnT = std::invoke_result_t<std::decay_t<FuncT>, std::decay_t<ArgsT>...> >
+    std::future<ReturnT> submitWithPriority(TaskPriority priority, FuncT&& task, ArgsT&&... args)
     {
-        m_isWaitingForAllTasksDone = true;
-        std::unique_lock<std::mutex> tasks_lock(m_mutex);
-        m_taskFinishedCv.wait(tasks_lock, [this] { return m_taskQueue.empty(); });
-        m_isWaitingForAllTasksDone = false;
+        std::packaged_task<ReturnT()> packagedTask(std::bind(std::forward<FuncT>(task), std::forward<ArgsT>(args)...));
+        std::future<ReturnT> future = packagedTask.get_future();
+
+        pushTask(Task(std::move(packagedTask)), priority);
+
+        return future;
     }
 
+    void waitForAllTasksComplete();
+
     const std::set<std::thread::id>& threadIdSet() const
     {
-        static std::set<std::thread::id> result;
-
-        if (result.empty()) {
-            for (thread_pool_size_t i = 0; i < m_threadPoolSize; ++i) {
-                result.insert(m_threadPool[i].get_id());
-            }
-        }
-
-        return result;
+        return m_threadIdSet;
     }
 
     bool containsThread(const std::thread::id& id) const
     {
-        const auto& idSet = threadIdSet();
-        return idSet.find(id) != idSet.cend();
+        return m_threadIdSet.find(id) != m_threadIdSet.cend();
     }
 
 private:
-    void setupThreads()
+    static constexpr size_t LANES_COUNT = static_cast<size_t>(TaskPriority::Count);
+    static constexpr size_t NO_WORKER = static_cast<size_t>(-1);
+
+    struct TaskQueue {
+        std::mutex mutex;
+        std::array<std::deque<Task>, LANES_COUNT> lanes;
+    };
+
+    void setupThreads();
+    void terminateThreads();
+
+    thread_pool_size_t vaildateThreadPoolCapacity(const thread_pool_size_t desiredThreadCount);
+
+    void pushTask(Task&& task, TaskPriority priority);
+    Task takeTask(size_t workerIdx);
+    void runTask(Task& task);
+
+    size_t currentWorkerIdx() const;
+
+    void th_workerLoop(size_t workerIdx);
+
+    std::atomic<bool> m_isActive = false;
+
+    //! NOTE Signed, since a task may be taken before the counter is increased by its producer
+    std::atomic<int64_t> m_queuedTasksCount = 0;
+    std::atomic<size_t> m_unfinishedTasksCount = 0;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_newTaskAvailableCv;
+    std::condition_variable m_taskFinishedCv;
+
+    TaskQueue m_sharedQueue;
+    std::unique_ptr<TaskQueue[]> m_workerQueues = nullptr;
+
+    thread_pool_size_t m_threadPoolSize = 0;
+    std::unique_ptr<std::thread[]> m_threadPool = nullptr;
+    std::set<std::thread::id> m_threadIdSet;
+};
+
+//! NOTE A set of tasks that can be waited for together.
+//! The tasks of the group are kept in its own queue, the scheduler only gets a ticket per task
+//! that runs the next one of them. So wait() helps executing the tasks of this group only,
+//! never unrelated (maybe long) tasks of others, and it is safe to call it from a worker thread
+class TaskGroup
+{
+public:
+    explicit TaskGroup(TaskScheduler* scheduler = TaskScheduler::instance(), TaskPriority priority = TaskPriority::Normal)
+        : m_scheduler(scheduler), m_priority(priority), m_state(std::make_shared<State>()) {}
+
+    ~TaskGroup()
     {
-        m_isActive = true;
-        for (thread_pool_size_t i = 0; i < m_threadPoolSize; ++i) {
-            m_threadPool[i] = std::thread(&TaskScheduler::th_workerLoop, this);
+        waitForTasks();
+    }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    template<typename FuncT>
+    void run(FuncT&& func)
+    {
+        {
+            std::lock_guard lock(m_state->mutex);
+            m_state->tasks.emplace_back(std::forward<FuncT>(func));
+            m_state->pendingTasksCount++;
         }
+
+        //! NOTE The ticket shares the state, since it may outlive the group when wait() has already run its task
+        m_scheduler->pushWithPriority(m_priority, [state = m_state]() {
+            runNextTask(*state);
+        });
     }
 
-    void terminateThreads()
+    //! NOTE Rethrows the first exception thrown by a task of the group
+    void wait()
     {
-        m_isActive = false;
-        m_newTaskAvailableCv.notify_all();
-        for (thread_pool_size_t i = 0; i < m_threadPoolSize; ++i) {
-            m_threadPool[i].join();
+        waitForTasks();
+
+        if (m_state->exception) {
+            std::exception_ptr exception = std::move(m_state->exception);
+            m_state->exception = nullptr;
+            std::rethrow_exception(exception);
         }
     }
 
-    thread_pool_size_t vaildateThreadPoolCapacity(const thread_pool_size_t desiredThreadCount)
+private:
+    struct State {
+        std::mutex mutex;
+        std::condition_variable finishedCv;
+        std::deque<Task> tasks;
+        size_t pendingTasksCount = 0;
+        std::exception_ptr exception;
+    };
+
+    static bool runNextTask(State& state)
     {
-        thread_pool_size_t maxCapacity = std::thread::hardware_concurrency();
+        Task task;
+        {
+            std::lock_guard lock(state.mutex);
+            if (state.tasks.empty()) {
+                return false;
+            }
+
+            task = std::move(state.tasks.front());
+            state.tasks.pop_front();
+        }
 
-        if (maxCapacity <= 1) {
-            return 1;
+        std::exception_ptr exception;
+        try {
+            task();
+        } catch (...) {
+            exception = std::current_exception();
         }
 
-        thread_pool_size_t optimalCapacity = maxCapacity / 2;
+        {
+            std::lock_guard lock(state.mutex);
+            if (exception && !state.exception) {
+                state.exception = std::move(exception);
+            }
 
-        if (desiredThreadCount <= 0) {
-            return optimalCapacity;
+            if (--state.pendingTasksCount == 0) {
+                state.finishedCv.notify_all();
+            }
         }
 
-        return desiredThreadCount;
+        return true;
     }
 
-    void th_workerLoop()
+    void waitForTasks()
     {
-        while (m_isActive) {
-            std::unique_lock<std::mutex> lock(m_mutex);
-            m_newTaskAvailableCv.wait(lock, [this] { return !m_taskQueue.empty() || !m_isActive; });
+        while (runNextTask(*m_state)) {
+        }
 
-            if (!m_isActive) {
-                return;
-            }
+        //! NOTE The rest of the tasks has already been started by other threads
+        std::unique_lock lock(m_state->mutex);
+        m_state->finishedCv.wait(lock, [this] { return m_state->pendingTasksCount == 0; });
+    }
 
-            std::function<void()> task = m_taskQueue.front();
-            m_taskQueue.pop();
+    TaskScheduler* m_scheduler = nullptr;
+    TaskPriority m_priority = TaskPriority::Normal;
 
-            bool isQueueEmpty = m_taskQueue.empty();
+    std::shared_ptr<State> m_state;
+};
 
-            lock.unlock();
+//! NOTE Calls func(idx) for each idx in [begin, end), split into chunks of at least grainSize indexes.
+//! Blocks until everything is done, the calling thread takes part in the work
+template<typename IndexT, typename FuncT>
+void parallelFor(IndexT begin, IndexT end, FuncT&& func, IndexT grainSize = 1,
+                 TaskPriority priority = TaskPriority::Normal, TaskScheduler* scheduler = TaskScheduler::instance())
+{
+    if (end <= begin) {
+        return;
+    }
 
-            task();
+    const IndexT count = end - begin;
+    grainSize = std::max(grainSize, IndexT(1));
 
-            if (m_isWaitingForAllTasksDone) {
-                m_taskFinishedCv.notify_one();
-            }
+    const IndexT maxChunksCount = static_cast<IndexT>(scheduler->threadPoolSize()) * 4;
+    const IndexT chunksCount = std::max(IndexT(1), std::min(maxChunksCount, (count + grainSize - 1) / grainSize));
 
-            if (isQueueEmpty) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
-            }
+    if (chunksCount == 1) {
+        for (IndexT idx = begin; idx < end; ++idx) {
+            func(idx);
         }
+        return;
     }
 
-    std::atomic<bool> m_isActive = false;
-    std::atomic<bool> m_isWaitingForAllTasksDone = false;
+    const IndexT chunkSize = (count + chunksCount - 1) / chunksCount;
 
-    mutable std::mutex m_mutex;
-    std::condition_variable m_newTaskAvailableCv;
-    std::condition_variable m_taskFinishedCv;
-    std::queue<std::function<void()> > m_taskQueue;
+    TaskGroup group(scheduler, priority);
 
-    thread_pool_size_t m_threadPoolSize = 0;
-    std::unique_ptr<std::thread[]> m_threadPool = nullptr;
-};
+    for (IndexT chunkBegin = begin; chunkBegin < end; chunkBegin += chunkSize) {
+        IndexT chunkEnd = std::min(end, chunkBegin + chunkSize);
+
+        group.run([&func, chunkBegin, chunkEnd]() {
+            for (IndexT idx = chunkBegin; idx < chunkEnd; ++idx) {
+                func(idx);
+            }
+        });
+    }
+
+    group.wait();
+}
 }
 
 #endif // MU_GLOBAL_TASKCHEDULER_H
@@ -68,6 +68,17 @@ mu::Ret File::readFile(const io::path_t& filePath, ByteArray& out)
     return make_ret(ok ? Err::NoError : Err::FSReadError);
 }
 
+mu::Ret File::mapFile(const io::path_t& filePath, ByteArray& out)
+{
+    RetVal<ByteArray> rv = fileSystem()->mapFile(filePath);
+    if (!rv.ret) {
+        return rv.ret;
+    }
+
+    out = rv.val;
+    return rv.ret;
+}
+
 mu::Ret File::writeFile(const io::path_t& filePath, const ByteArray& data)
 {
     return fileSystem()->writeFile(filePath, data);
@@ -61,8 +61,13 @@ public:
 
     virtual RetVal<ByteArray> readFile(const io::path_t& filePath) const = 0;
     virtual bool readFile(const io::path_t& filePath, ByteArray& data) const = 0;
+    //! NOTE The file is replaced as a whole, the readers see either the old or the new data
     virtual Ret writeFile(const io::path_t& filePath, const ByteArray& data) const = 0;
 
+    //! NOTE Maps the file into memory read-only, so that pages are loaded only when they are touched.
+    //! The mapping is released when the last copy of the returned data is destroyed.
+    virtual RetVal<ByteArray> mapFile(const io::path_t& filePath) const = 0;
+
     //! NOTE File info
     virtual io::path_t canonicalFilePath(const io::path_t& filePath) const = 0;
     virtual io::path_t absolutePath(const io::path_t& filePath) const = 0;
@@ -24,6 +24,7 @@
 #include <QFileInfo>
 #include <QDir>
 #include <QDirIterator>
+#include <QSaveFile>
 
 #ifdef Q_OS_WIN
 #include <windows.h>
@@ -192,15 +193,50 @@ bool FileSystem::readFile(const io::path_t& filePath, ByteArray& data) const
 
 Ret FileSystem::writeFile(const io::path_t& filePath, const ByteArray& data) const
 {
-    QFile file(filePath.toQString());
+    //! NOTE The data is written to a temporary file, which then replaces the file.
+    //! So the file is never seen half written, and the data mapped from the old file (see mapFile) stays valid
+    QSaveFile file(filePath.toQString());
+    //! NOTE If a temporary file can't be created next to the file (no rights for the dir), the file is written in place
+    file.setDirectWriteFallback(true);
+
     if (!file.open(QIODevice::WriteOnly)) {
         return make_ret(Err::FSWriteError);
     }
 
-    file.write(reinterpret_cast<const char*>(data.constData()), static_cast<qint64>(data.size()));
-    file.close();
+    qint64 size = static_cast<qint64>(data.size());
+    if (file.write(reinterpret_cast<const char*>(data.constData()), size) != size) {
+        file.cancelWriting();
+        return make_ret(Err::FSWriteError);
+    }
+
+    if (!file.commit()) {
+        return make_ret(Err::FSWriteError);
+    }
+
+    return make_ret(Err::NoError);
+}
 
-    return true;
+RetVal<ByteArray> FileSystem::mapFile(const io::path_t& filePath) const
+{
+    RetVal<ByteArray> result;
+
+    std::shared_ptr<QFile> file = std::make_shared<QFile>(filePath.toQString());
+    if (!file->open(QIODevice::ReadOnly)) {
+        result.ret = make_ret(Err::FSReadError);
+        return result;
+    }
+
+    qint64 size = file->size();
+    const uchar* data = size > 0 ? file->map(0, size) : nullptr;
+    if (!data) {
+        //! NOTE Empty files can't be mapped, as well as files on some file systems
+        return readFile(filePath);
+    }
+
+    //! NOTE The file owns the mapping, it is unmapped when the file is destroyed
+    result.val = ByteArray::fromRawData(data, static_cast<size_t>(size), file);
+    result.ret = make_ret(Err::NoError);
+    return result;
 }
 
 Ret FileSystem::makePath(const io::path_t& path) const
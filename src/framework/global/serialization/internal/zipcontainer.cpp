@@ -23,6 +23,7 @@
 
 #include <ctime>
 #include <cstring>
+#include <unordered_map>
 #include <zlib.h>
 
 #include "io/dir.h"
@@ -374,6 +375,7 @@ struct ZipContainer::Impl {
 
     bool dirtyFileTree = true;
     std::vector<FileHeader> fileHeaders;
+    std::unordered_map<std::string, size_t> fileHeaderIndexes;
     ByteArray comment;
     uint start_of_directory = 0;
     ZipContainer::Status status = ZipContainer::NoError;
@@ -390,6 +392,7 @@ struct ZipContainer::Impl {
         : device(d) {}
 
     void scanFiles();
+    const FileHeader* findFileHeader(const std::string& fileName) const;
     ZipContainer::FileInfo fillFileInfo(int index) const;
 };
 
@@ -480,14 +483,25 @@ void ZipContainer::Impl::scanFiles()
         }
 
         ZDEBUG("found file '%s'", header.file_name.data());
-        fileHeaders.push_back(header);
+        fileHeaderIndexes.emplace(std::string(header.file_name.constChar(), header.file_name.size()), fileHeaders.size());
+        fileHeaders.push_back(std::move(header));
     }
 }
 
+const FileHeader* ZipContainer::Impl::findFileHeader(const std::string& fileName) const
+{
+    auto it = fileHeaderIndexes.find(fileName);
+    if (it == fileHeaderIndexes.end()) {
+        return nullptr;
+    }
+
+    return &fileHeaders.at(it->second);
+}
+
 ZipContainer::FileInfo ZipContainer::Impl::fillFileInfo(int index) const
 {
     ZipContainer::FileInfo fileInfo;
-    FileHeader header = fileHeaders.at(index);
+    const FileHeader& header = fileHeaders.at(index);
     uint32_t mode = readUInt(header.h.external_file_attributes);
     const HostOS hostOS = HostOS(readUShort(header.h.version_made) >> 8);
     switch (hostOS) {
@@ -647,6 +661,7 @@ void ZipContainer::Impl::addEntry(EntryType type, const std::string& fileName, c
     writeUInt(header.h.external_file_attributes, mode << 16);
     writeUInt(header.h.offset_local_header, start_of_directory);
 
+    fileHeaderIndexes.emplace(std::string(header.file_name.constChar(), header.file_name.size()), fileHeaders.size());
     fileHeaders.push_back(header);
 
     LocalFileHeader h = header.h.toLocalHeader();
@@ -690,74 +705,66 @@ int ZipContainer::count() const
 bool ZipContainer::fileExists(const std::string& fileName) const
 {
     p->scanFiles();
-    ByteArray fileNameBa = ByteArray::fromRawData(fileName.c_str(), fileName.size());
-    for (size_t i = 0; i < p->fileHeaders.size(); ++i) {
-        if (p->fileHeaders.at(i).file_name == fileNameBa) {
-            return true;
-        }
-    }
-    return false;
+    return p->findFileHeader(fileName) != nullptr;
 }
 
 ByteArray ZipContainer::fileData(const std::string& fileName) const
 {
     p->scanFiles();
 
-    ByteArray fileNameBa = ByteArray::fromRawData(fileName.c_str(), fileName.size());
-
-    size_t i;
-    for (i = 0; i < p->fileHeaders.size(); ++i) {
-        if (p->fileHeaders.at(i).file_name == fileNameBa) {
-            break;
-        }
-    }
-
-    if (i == p->fileHeaders.size()) {
+    const FileHeader* header = p->findFileHeader(fileName);
+    if (!header) {
         return ByteArray();
     }
 
-    FileHeader header = p->fileHeaders.at(i);
-
-    ushort version_needed = readUShort(header.h.version_needed);
+    ushort version_needed = readUShort(header->h.version_needed);
     if (version_needed > ZIP_VERSION) {
         LOGW("Zip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
         return ByteArray();
     }
 
-    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
-    int compressed_size = readUInt(header.h.compressed_size);
-    int uncompressed_size = readUInt(header.h.uncompressed_size);
-    int start = readUInt(header.h.offset_local_header);
-
-    p->device->seek(start);
-    LocalFileHeader lh;
-    p->device->read((uint8_t*)&lh, sizeof(LocalFileHeader));
-    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    p->device->seek(p->device->pos() + skip);
-
-    int compression_method = readUShort(lh.compression_method);
+    ushort general_purpose_bits = readUShort(header->h.general_purpose_bits);
+    size_t compressed_size = readUInt(header->h.compressed_size);
+    size_t uncompressed_size = readUInt(header->h.uncompressed_size);
+    size_t start = readUInt(header->h.offset_local_header);
 
     if ((general_purpose_bits & Encrypted) != 0) {
         LOGW("Zip: Unsupported encryption method is needed to extract the data.");
         return ByteArray();
     }
 
-    ByteArray compressed = p->device->read(compressed_size);
+    //! NOTE The device holds the whole archive (usually a mapped file),
+    //! so the entry is decompressed straight from it, without copying the compressed data
+    const size_t deviceSize = p->device->size();
+    if (start + sizeof(LocalFileHeader) > deviceSize) {
+        LOGW("Zip: Local file header is out of range.");
+        return ByteArray();
+    }
+
+    const uint8_t* archiveData = p->device->readData();
+    LocalFileHeader lh;
+    std::memcpy(&lh, archiveData + start, sizeof(LocalFileHeader));
+    size_t dataStart = start + sizeof(LocalFileHeader) + readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
+    if (dataStart > deviceSize) {
+        LOGW("Zip: File data is out of range.");
+        return ByteArray();
+    }
+
+    compressed_size = std::min(compressed_size, deviceSize - dataStart);
+    const uint8_t* compressed = archiveData + dataStart;
+
+    int compression_method = readUShort(lh.compression_method);
     if (compression_method == CompressionMethodStored) {
         // no compression
-        compressed.truncate(uncompressed_size);
-        return compressed;
+        return ByteArray(compressed, std::min(compressed_size, uncompressed_size));
     } else if (compression_method == CompressionMethodDeflated) {
         // Deflate
-        //qDebug("compressed=%d", compressed.size());
-        compressed.truncate(compressed_size);
         ByteArray baunzip;
-        ulong len = std::max(uncompressed_size,  1);
+        ulong len = std::max(uncompressed_size, size_t(1));
         int res;
         do {
             baunzip.resize(len);
-            res = inflate((uint8_t*)baunzip.data(), &len,
-                          (const uint8_t*)compressed.constData(), compressed_size);
+            res = inflate((uint8_t*)baunzip.data(), &len, compressed, (ulong)compressed_size);
 
             switch (res) {
             case Z_OK:
@@ -23,19 +23,485 @@
 
 #include <cstring>
 
-#include "thirdparty/tinyxml/tinyxml2.h"
-
 #include "log.h"
 
 using namespace mu;
 using namespace mu::io;
-using namespace tinyxml2;
+
+//! NOTE The document is parsed incrementally, one token per readNext(), without building a DOM.
+//! The parser works in place on the data: names and values are decoded and null-terminated
+//! right in the buffer, so the tokens are views into it, which stay valid as long as the data
+//! of the reader isn't replaced. The data is copied only if it is shared with someone else,
+//! see setData().
+//! Errors are found when the parser gets to them, not when the data is set
+
+static inline bool isWhiteSpace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static inline bool isNameStartChar(unsigned char c)
+{
+    //! NOTE Any non-ASCII character is allowed, instead of checking the Unicode categories
+    return c >= 128 || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == ':' || c == '_';
+}
+
+static inline bool isNameChar(unsigned char c)
+{
+    return isNameStartChar(c) || (c >= '0' && c <= '9') || c == '.' || c == '-';
+}
+
+static inline bool startsWith(const char* str, const char* prefix)
+{
+    return std::strncmp(str, prefix, std::strlen(prefix)) == 0;
+}
+
+static char* readName(char* p)
+{
+    if (!isNameStartChar(static_cast<unsigned char>(*p))) {
+        return p;
+    }
+
+    while (isNameChar(static_cast<unsigned char>(*p))) {
+        ++p;
+    }
+
+    return p;
+}
+
+static size_t writeUtf8(uint32_t code, char* out)
+{
+    if (code < 0x80) {
+        out[0] = static_cast<char>(code);
+        return 1;
+    } else if (code < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (code >> 6));
+        out[1] = static_cast<char>(0x80 | (code & 0x3F));
+        return 2;
+    } else if (code < 0x10000) {
+        out[0] = static_cast<char>(0xE0 | (code >> 12));
+        out[1] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (code & 0x3F));
+        return 3;
+    }
+
+    out[0] = static_cast<char>(0xF0 | (code >> 18));
+    out[1] = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (code & 0x3F));
+    return 4;
+}
+
+//! NOTE Decodes the entity at p (pointing to '&') to out. Returns the position after the entity,
+//! or nullptr, if it isn't a predefined entity or a character reference. The decoded entity
+//! is never longer than the encoded one
+static const char* decodeEntity(const char* p, const char* end, char*& out)
+{
+    struct Entity {
+        const char* pattern;
+        size_t length;
+        char value;
+    };
+
+    static const Entity ENTITIES[] = {
+        { "quot;", 5, '\"' },
+        { "amp;", 4, '&' },
+        { "apos;", 5, '\'' },
+        { "lt;", 3, '<' },
+        { "gt;", 3, '>' }
+    };
+
+    const char* p1 = p + 1;
+
+    if (p1 < end && *p1 == '#') {
+        bool isHex = p1 + 1 < end && (p1[1] == 'x' || p1[1] == 'X');
+        const char* digit = p1 + (isHex ? 2 : 1);
+        uint32_t code = 0;
+        size_t digitsCount = 0;
+
+        for (; digit < end && *digit != ';'; ++digit, ++digitsCount) {
+            unsigned char c = static_cast<unsigned char>(*digit);
+            uint32_t value = 0;
+
+            if (c >= '0' && c <= '9') {
+                value = c - '0';
+            } else if (isHex && c >= 'a' && c <= 'f') {
+                value = c - 'a' + 10;
+            } else if (isHex && c >= 'A' && c <= 'F') {
+                value = c - 'A' + 10;
+            } else {
+                return nullptr;
+            }
+
+            code = code * (isHex ? 16 : 10) + value;
+
+            if (code > 0x10FFFF) {
+                return nullptr;
+            }
+        }
+
+        if (digit == end || digitsCount == 0) {
+            return nullptr;
+        }
+
+        out += writeUtf8(code, out);
+        return digit + 1;
+    }
+
+    for (const Entity& entity : ENTITIES) {
+        if (static_cast<size_t>(end - p1) >= entity.length && std::strncmp(p1, entity.pattern, entity.length) == 0) {
+            *out++ = entity.value;
+            return p1 + entity.length;
+        }
+    }
+
+    return nullptr;
+}
+
+//! NOTE Normalizes the line breaks and, if needed, decodes the entities of [begin, end) in place.
+//! The result is null-terminated, the terminator is written at end at most. Returns the size of the result
+static size_t decode(char* begin, char* end, bool processEntities)
+{
+    char* p = begin;
+
+    //! NOTE Usually there is nothing to decode
+    while (p < end && *p != '\r' && !(processEntities && *p == '&') && !(*p == '\n' && p + 1 < end && p[1] == '\r')) {
+        ++p;
+    }
+
+    char* q = p;
+
+    while (p < end) {
+        if (*p == '\r' || *p == '\n') {
+            char pair = *p == '\r' ? '\n' : '\r';
+            p += (p + 1 < end && p[1] == pair) ? 2 : 1;
+            *q++ = '\n';
+        } else if (processEntities && *p == '&') {
+            const char* next = decodeEntity(p, end, q);
+            if (next) {
+                p = const_cast<char*>(next);
+            } else {
+                *q++ = *p++;
+            }
+        } else {
+            *q++ = *p++;
+        }
+    }
+
+    *q = 0;
+
+    return static_cast<size_t>(q - begin);
+}
 
 struct XmlStreamReader::Xml {
-    XMLDocument doc;
-    XMLNode* node = nullptr;
-    XMLError err;
+    struct AttributeData {
+        AsciiStringView name;
+        AsciiStringView value;
+    };
+
+    ByteArray buffer;
+    char* pos = nullptr;
+
+    //! NOTE The text before a tag is terminated at the '<' of the tag
+    bool isAtTag = false;
+
+    //! NOTE Something besides the XML declarations has been read
+    bool isDocumentStarted = false;
+
+    AsciiStringView name;
+    AsciiStringView value;
+    std::vector<AttributeData> attributes;
+    bool isEmptyElement = false;
+    std::vector<AsciiStringView> openElements;
+
+    int64_t line = 1;
+    const char* lineStart = nullptr;
+    int64_t tokenLine = 0;
+    int64_t tokenColumn = 0;
+
+    Error err = NoError;
+    String errStr;
     String customErr;
+
+    void reset()
+    {
+        buffer = ByteArray();
+        pos = nullptr;
+        isAtTag = false;
+        isDocumentStarted = false;
+        name = AsciiStringView();
+        value = AsciiStringView();
+        attributes.clear();
+        isEmptyElement = false;
+        openElements.clear();
+        line = 1;
+        lineStart = nullptr;
+        tokenLine = 0;
+        tokenColumn = 0;
+        err = NoError;
+        errStr.clear();
+        customErr.clear();
+    }
+
+    void countLines(const char* begin, const char* end)
+    {
+        for (const char* p = begin; p < end; ++p) {
+            p = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            if (!p) {
+                break;
+            }
+
+            ++line;
+            lineStart = p + 1;
+        }
+    }
+
+    char* skipWhiteSpace(char* p)
+    {
+        while (isWhiteSpace(*p)) {
+            if (*p == '\n') {
+                ++line;
+                lineStart = p + 1;
+            }
+            ++p;
+        }
+
+        return p;
+    }
+
+    //! NOTE Returns the position of the terminator, or nullptr if the data ends before it
+    char* find(char* p, const char* terminator)
+    {
+        char* result = terminator[1] ? std::strstr(p, terminator) : std::strchr(p, terminator[0]);
+        countLines(p, result ? result : p + std::strlen(p));
+        return result;
+    }
+
+    void markToken(const char* p)
+    {
+        tokenLine = line;
+        tokenColumn = static_cast<int64_t>(p - lineStart) + 1;
+    }
+
+    TokenType setError(Error error, const String& message)
+    {
+        err = error;
+        errStr = String(u"%1 (line %2, column %3)").arg(message).arg(tokenLine).arg(tokenColumn);
+        return TokenType::Invalid;
+    }
+
+    TokenType readToken()
+    {
+        attributes.clear();
+        name = AsciiStringView();
+        value = AsciiStringView();
+
+        char* start = pos;
+        int64_t startLine = line;
+        const char* startLineStart = lineStart;
+
+        char* p = isAtTag ? pos : skipWhiteSpace(pos);
+        markToken(p);
+
+        if (!isAtTag && *p != '<') {
+            if (!*p) {
+                if (!openElements.empty()) {
+                    return setError(PrematureEndOfDocumentError,
+                                    String(u"Unexpected end of document, element is not closed: %1")
+                                    .arg(String::fromAscii(openElements.back().ascii())));
+                }
+
+                pos = p;
+                return TokenType::EndDocument;
+            }
+
+            //! NOTE The leading whitespace belongs to the text
+            line = startLine;
+            lineStart = startLineStart;
+            return readText(start);
+        }
+
+        isAtTag = false;
+
+        char* tag = p + 1;
+
+        if (*tag == '?') {
+            return readDeclaration(tag + 1);
+        } else if (startsWith(tag, "!--")) {
+            return readComment(tag + 3);
+        } else if (startsWith(tag, "![CDATA[")) {
+            return readCData(tag + 8);
+        } else if (*tag == '!') {
+            return readDtd(tag + 1);
+        }
+
+        tag = skipWhiteSpace(tag);
+
+        if (*tag == '/') {
+            return readEndElement(tag + 1);
+        }
+
+        return readStartElement(tag);
+    }
+
+    TokenType readText(char* p)
+    {
+        char* end = find(p, "<");
+        if (!end) {
+            return setError(PrematureEndOfDocumentError, u"Unexpected end of document in text");
+        }
+
+        value = AsciiStringView(p, decode(p, end, true));
+        pos = end;
+        isAtTag = true;
+        isDocumentStarted = true;
+
+        return TokenType::Characters;
+    }
+
+    TokenType readMarkup(char* p, const char* terminator, TokenType token)
+    {
+        char* end = find(p, terminator);
+        if (!end) {
+            return setError(PrematureEndOfDocumentError, String(u"Unexpected end of document, expected: %1")
+                            .arg(String::fromAscii(terminator)));
+        }
+
+        pos = end + std::strlen(terminator);
+        value = AsciiStringView(p, decode(p, end, false));
+
+        return token;
+    }
+
+    TokenType readDeclaration(char* p)
+    {
+        if (isDocumentStarted) {
+            return setError(NotWellFormedError, u"XML declaration is allowed only at the start of the document");
+        }
+
+        return readMarkup(p, "?>", TokenType::StartDocument);
+    }
+
+    TokenType readComment(char* p)
+    {
+        isDocumentStarted = true;
+        return readMarkup(p, "-->", TokenType::Comment);
+    }
+
+    TokenType readCData(char* p)
+    {
+        isDocumentStarted = true;
+        return readMarkup(p, "]]>", TokenType::Characters);
+    }
+
+    TokenType readDtd(char* p)
+    {
+        isDocumentStarted = true;
+        return readMarkup(p, ">", TokenType::DTD);
+    }
+
+    TokenType readStartElement(char* p)
+    {
+        isDocumentStarted = true;
+
+        char* nameEnd = readName(p);
+        if (nameEnd == p) {
+            return setError(NotWellFormedError, u"Invalid element name");
+        }
+
+        name = AsciiStringView(p, static_cast<size_t>(nameEnd - p));
+        p = nameEnd;
+
+        while (true) {
+            p = skipWhiteSpace(p);
+
+            if (isNameStartChar(static_cast<unsigned char>(*p))) {
+                char* attrNameEnd = readName(p);
+                AsciiStringView attrName(p, static_cast<size_t>(attrNameEnd - p));
+
+                p = skipWhiteSpace(attrNameEnd);
+                if (*p != '=') {
+                    return setError(NotWellFormedError, String(u"Expected '=' after attribute: %1")
+                                    .arg(String::fromAscii(attrName.ascii(), attrName.size())));
+                }
+
+                p = skipWhiteSpace(p + 1);
+                if (*p != '\"' && *p != '\'') {
+                    return setError(NotWellFormedError, String(u"Expected a quoted value of attribute: %1")
+                                    .arg(String::fromAscii(attrName.ascii(), attrName.size())));
+                }
+
+                const char quote[2] = { *p, 0 };
+                char* valueBegin = p + 1;
+                char* valueEnd = find(valueBegin, quote);
+                if (!valueEnd) {
+                    return setError(PrematureEndOfDocumentError, u"Unexpected end of document in attribute value");
+                }
+
+                for (const AttributeData& attribute : attributes) {
+                    if (attribute.name == attrName) {
+                        return setError(NotWellFormedError, String(u"Duplicated attribute: %1")
+                                        .arg(String::fromAscii(attrName.ascii(), attrName.size())));
+                    }
+                }
+
+                attributes.push_back({ attrName, AsciiStringView(valueBegin, decode(valueBegin, valueEnd, true)) });
+                p = valueEnd + 1;
+            } else if (*p == '>') {
+                ++p;
+                break;
+            } else if (*p == '/' && p[1] == '>') {
+                isEmptyElement = true;
+                p += 2;
+                break;
+            } else if (!*p) {
+                return setError(PrematureEndOfDocumentError, u"Unexpected end of document in element");
+            } else {
+                return setError(NotWellFormedError, String(u"Unexpected character in element: %1")
+                                .arg(String::fromAscii(name.ascii(), name.size())));
+            }
+        }
+
+        //! NOTE The names are terminated when the whole tag is read, the terminators may be needed till then
+        for (const AttributeData& attribute : attributes) {
+            const_cast<char*>(attribute.name.ascii())[attribute.name.size()] = 0;
+        }
+
+        *nameEnd = 0;
+        pos = p;
+
+        if (!isEmptyElement) {
+            openElements.push_back(name);
+        }
+
+        return TokenType::StartElement;
+    }
+
+    TokenType readEndElement(char* p)
+    {
+        char* nameEnd = readName(p);
+        AsciiStringView endName(p, static_cast<size_t>(nameEnd - p));
+
+        p = skipWhiteSpace(nameEnd);
+        if (*p != '>') {
+            return setError(NotWellFormedError, String(u"Expected '>' after end element: %1")
+                            .arg(String::fromAscii(endName.ascii(), endName.size())));
+        }
+
+        if (openElements.empty() || !(openElements.back() == endName)) {
+            return setError(NotWellFormedError, String(u"Mismatched end element: %1")
+                            .arg(String::fromAscii(endName.ascii(), endName.size())));
+        }
+
+        *nameEnd = 0;
+        pos = p + 1;
+
+        //! NOTE The name of the start element is reused
+        name = openElements.back();
+        openElements.pop_back();
+
+        return TokenType::EndElement;
+    }
 };
 
 XmlStreamReader::XmlStreamReader()
@@ -46,8 +512,7 @@ XmlStreamReader::XmlStreamReader()
 XmlStreamReader::XmlStreamReader(IODevice* device)
 {
     m_xml = new Xml();
-    ByteArray data = device->readAll();
-    setData(data);
+    setData(device->readAll());
 }
 
 XmlStreamReader::XmlStreamReader(const ByteArray& data)
@@ -56,6 +521,12 @@ XmlStreamReader::XmlStreamReader(const ByteArray& data)
     setData(data);
 }
 
+XmlStreamReader::XmlStreamReader(ByteArray&& data)
+{
+    m_xml = new Xml();
+    setData(std::move(data));
+}
+
 #ifndef NO_QT_SUPPORT
 XmlStreamReader::XmlStreamReader(const QByteArray& data)
 {
@@ -73,12 +544,31 @@ XmlStreamReader::~XmlStreamReader()
 
 void XmlStreamReader::setData(const ByteArray& data)
 {
-    m_xml->doc.Clear();
-    m_xml->err = m_xml->doc.Parse(reinterpret_cast<const char*>(data.constData()), data.size());
-    m_token = m_xml->err == XML_SUCCESS ? TokenType::NoToken : TokenType::Invalid;
-    m_xml->customErr.clear();
+    setData(ByteArray(data));
+}
+
+void XmlStreamReader::setData(ByteArray&& data)
+{
+    m_xml->reset();
+    m_token = TokenType::NoToken;
+
+    //! NOTE The data is decoded in place, so taking it for writing detaches (copies) it,
+    //! unless the reader is its only owner. ByteArray keeps a terminating zero after the data
+    m_xml->buffer = std::move(data);
+
+    char* p = reinterpret_cast<char*>(m_xml->buffer.data());
+    m_xml->lineStart = p;
+    p = m_xml->skipWhiteSpace(p);
+
+    static const char* BOM = "\xEF\xBB\xBF";
+    if (startsWith(p, BOM)) {
+        p += 3;
+    }
+
+    m_xml->pos = p;
 
-    if (m_xml->err != XML_SUCCESS) {
+    if (!*p) {
+        m_token = m_xml->setError(NotWellFormedError, u"Empty document");
         LOGE() << errorString();
     }
 }
@@ -100,75 +590,29 @@ bool XmlStreamReader::atEnd() const
     return m_token == TokenType::EndDocument || m_token == TokenType::Invalid;
 }
 
-static XmlStreamReader::TokenType resolveToken(XMLNode* n, bool isStartElement)
-{
-    if (n->ToElement()) {
-        return isStartElement ? XmlStreamReader::TokenType::StartElement : XmlStreamReader::TokenType::EndElement;
-    } else if (n->ToText()) {
-        return XmlStreamReader::TokenType::Characters;
-    } else if (n->ToComment()) {
-        return XmlStreamReader::TokenType::Comment;
-    } else if (n->ToDeclaration()) {
-        return XmlStreamReader::TokenType::StartDocument;
-    } else if (n->ToDocument()) {
-        return XmlStreamReader::TokenType::EndDocument;
-    } else if (n->ToUnknown()) {
-        return XmlStreamReader::TokenType::DTD;
-    }
-    return XmlStreamReader::TokenType::Unknown;
-}
-
-static std::pair<XMLNode*, XmlStreamReader::TokenType> resolveNode(XMLNode* currentNode, XmlStreamReader::TokenType currentToken)
-{
-    if (currentToken == XmlStreamReader::TokenType::StartElement) {
-        XMLNode* child = currentNode->FirstChild();
-        if (child) {
-            return { child, resolveToken(child, true) };
-        }
-
-        XMLNode* sibling = currentNode->NextSibling();
-        if (!sibling || sibling->ToElement() || sibling->ToText()) {
-            return { currentNode, XmlStreamReader::TokenType::EndElement };
-        }
-    }
-
-    XMLNode* sibling = currentNode->NextSibling();
-    if (sibling) {
-        return { sibling, resolveToken(sibling, true) };
-    }
-
-    XMLNode* parent = currentNode->Parent();
-    if (parent) {
-        return { parent, resolveToken(parent, false) };
-    }
-
-    return { nullptr, XmlStreamReader::TokenType::EndDocument };
-}
-
 XmlStreamReader::TokenType XmlStreamReader::readNext()
 {
     if (m_token == TokenType::Invalid) {
         return m_token;
     }
 
-    if (m_xml->err != XML_SUCCESS || m_token == EndDocument) {
-        m_xml->node = nullptr;
+    if (m_xml->err != NoError || m_token == EndDocument || !m_xml->pos) {
         m_token = TokenType::Invalid;
         return m_token;
     }
 
-    if (!m_xml->node) {
-        m_xml->node = m_xml->doc.FirstChild();
-        m_token = m_xml->node->ToDeclaration() ? TokenType::StartDocument : resolveToken(m_xml->node, true);
+    if (m_token == TokenType::StartElement && m_xml->isEmptyElement) {
+        m_xml->isEmptyElement = false;
+        m_xml->attributes.clear();
+        m_token = TokenType::EndElement;
         return m_token;
     }
 
-    std::pair<XMLNode*, XmlStreamReader::TokenType> p = resolveNode(m_xml->node, m_token);
-
-    m_xml->node = p.first;
-    m_token = p.second;
+    m_token = m_xml->readToken();
 
-    if (m_token == XmlStreamReader::TokenType::DTD) {
+    if (m_token == TokenType::Invalid) {
+        LOGE() << errorString();
+    } else if (m_token == TokenType::DTD) {
         tryParseEntity(m_xml);
     }
 
@@ -179,7 +623,7 @@ void XmlStreamReader::tryParseEntity(Xml* xml)
 {
     static const char* ENTITY = { "ENTITY" };
 
-    const char* str = xml->node->Value();
+    const char* str = xml->value.ascii();
     if (std::strncmp(str, ENTITY, 6) == 0) {
         String val = String::fromUtf8(str);
         StringList list = val.split(' ');
@@ -195,7 +639,7 @@ void XmlStreamReader::tryParseEntity(Xml* xml)
 
 String XmlStreamReader::nodeValue(Xml* xml) const
 {
-    String str = String::fromUtf8(xml->node->Value());
+    String str = String::fromUtf8(xml->value.ascii());
     if (!m_entities.empty()) {
         for (const auto& p : m_entities) {
             str.replace(p.first, p.second);
@@ -245,7 +689,7 @@ void XmlStreamReader::skipCurrentElement()
 
 AsciiStringView XmlStreamReader::name() const
 {
-    return (m_xml->node && m_xml->node->ToElement()) ? m_xml->node->Value() : AsciiStringView();
+    return (m_token == TokenType::StartElement || m_token == TokenType::EndElement) ? m_xml->name : AsciiStringView();
 }
 
 bool XmlStreamReader::hasAttribute(const char* name) const
@@ -254,24 +698,18 @@ bool XmlStreamReader::hasAttribute(const char* name) const
         return false;
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return false;
+    for (const Xml::AttributeData& attribute : m_xml->attributes) {
+        if (attribute.name == name) {
+            return true;
+        }
     }
-    return e->FindAttribute(name) != nullptr;
+
+    return false;
 }
 
 String XmlStreamReader::attribute(const char* name) const
 {
-    if (m_token != TokenType::StartElement) {
-        return String();
-    }
-
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return String();
-    }
-    return String::fromUtf8(e->Attribute(name));
+    return String::fromUtf8(asciiAttribute(name).ascii());
 }
 
 String XmlStreamReader::attribute(const char* name, const String& def) const
@@ -285,11 +723,13 @@ AsciiStringView XmlStreamReader::asciiAttribute(const char* name) const
         return AsciiStringView();
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return AsciiStringView();
+    for (const Xml::AttributeData& attribute : m_xml->attributes) {
+        if (attribute.name == name) {
+            return attribute.value;
+        }
     }
-    return e->Attribute(name);
+
+    return AsciiStringView();
 }
 
 AsciiStringView XmlStreamReader::asciiAttribute(const char* name, const AsciiStringView& def) const
@@ -324,15 +764,10 @@ std::vector<XmlStreamReader::Attribute> XmlStreamReader::attributes() const
         return attrs;
     }
 
-    XMLElement* e = m_xml->node->ToElement();
-    if (!e) {
-        return attrs;
-    }
-
-    for (const XMLAttribute* xa = e->FirstAttribute(); xa; xa = xa->Next()) {
+    for (const Xml::AttributeData& attribute : m_xml->attributes) {
         Attribute a;
-        a.name = xa->Name();
-        a.value = String::fromUtf8(xa->Value());
+        a.name = attribute.name;
+        a.value = String::fromUtf8(attribute.value.ascii());
         attrs.push_back(std::move(a));
     }
     return attrs;
@@ -340,7 +775,7 @@ std::vector<XmlStreamReader::Attribute> XmlStreamReader::attributes() const
 
 String XmlStreamReader::text() const
 {
-    if (m_xml->node && (m_xml->node->ToText() || m_xml->node->ToComment())) {
+    if (m_token == TokenType::Characters || m_token == TokenType::Comment) {
         return nodeValue(m_xml);
     }
     return String();
@@ -348,8 +783,8 @@ String XmlStreamReader::text() const
 
 AsciiStringView XmlStreamReader::asciiText() const
 {
-    if (m_xml->node && (m_xml->node->ToText() || m_xml->node->ToComment())) {
-        return m_xml->node->Value();
+    if (m_token == TokenType::Characters || m_token == TokenType::Comment) {
+        return m_xml->value;
     }
     return AsciiStringView();
 }
@@ -364,6 +799,8 @@ String XmlStreamReader::readText()
                 result = nodeValue(m_xml);
                 break;
             case EndElement:
+            case EndDocument:
+            case Invalid:
                 return result;
             case Comment:
                 break;
@@ -384,9 +821,11 @@ AsciiStringView XmlStreamReader::readAsciiText()
         while (1) {
             switch (readNext()) {
             case Characters:
-                result = AsciiStringView(m_xml->node->Value());
+                result = m_xml->value;
                 break;
             case EndElement:
+            case EndDocument:
+            case Invalid:
                 return result;
             case Comment:
                 break;
@@ -414,12 +853,12 @@ double XmlStreamReader::readDouble(bool* ok)
 
 int64_t XmlStreamReader::lineNumber() const
 {
-    return m_xml->doc.ErrorLineNum();
+    return m_xml->tokenLine;
 }
 
 int64_t XmlStreamReader::columnNumber() const
 {
-    return 0;
+    return m_xml->tokenColumn;
 }
 
 XmlStreamReader::Error XmlStreamReader::error() const
@@ -428,12 +867,7 @@ XmlStreamReader::Error XmlStreamReader::error() const
         return CustomError;
     }
 
-    XMLError err = m_xml->doc.ErrorID();
-    if (err == XML_SUCCESS) {
-        return NoError;
-    }
-
-    return NotWellFormedError;
+    return m_xml->err;
 }
 
 bool XmlStreamReader::isError() const
@@ -446,7 +880,7 @@ String XmlStreamReader::errorString() const
     if (!m_xml->customErr.empty()) {
         return m_xml->customErr;
     }
-    return String::fromUtf8(m_xml->doc.ErrorStr());
+    return m_xml->errStr;
 }
 
 void XmlStreamReader::raiseError(const String& message)
@@ -69,6 +69,7 @@ public:
     XmlStreamReader();
     explicit XmlStreamReader(io::IODevice* device);
     explicit XmlStreamReader(const ByteArray& data);
+    explicit XmlStreamReader(ByteArray&& data);
 #ifndef NO_QT_SUPPORT
     explicit XmlStreamReader(const QByteArray& data);
 #endif
@@ -77,7 +78,10 @@ public:
     XmlStreamReader(const XmlStreamReader&) = delete;
     XmlStreamReader& operator=(const XmlStreamReader&) = delete;
 
+    //! NOTE The reader decodes the data in place. The data passed by reference is copied,
+    //! the moved data is used as it is, if nothing else shares it
     void setData(const ByteArray& data);
+    void setData(ByteArray&& data);
 
     bool readNextStartElement();
     bool atEnd() const;
@@ -113,6 +117,8 @@ public:
     int readInt(bool* ok = nullptr, int base = 10);
     double readDouble(bool* ok = nullptr);
 
+    //! NOTE The document is parsed while it is being read, so a parse error
+    //! is only reported once the reader gets to it
     int64_t lineNumber() const;
     int64_t columnNumber() const;
     Error error() const;
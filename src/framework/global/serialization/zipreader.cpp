@@ -23,6 +23,7 @@
 
 #include "internal/zipcontainer.h"
 #include "io/file.h"
+#include "io/buffer.h"
 
 using namespace mu;
 using namespace mu::io;
@@ -32,13 +33,19 @@ struct ZipReader::Impl
     ZipContainer* zip = nullptr;
     IODevice* device = nullptr;
     bool isSelfDevice = false;
+    ByteArray mappedData;
 };
 
 ZipReader::ZipReader(const io::path_t& filePath)
     : m_filePath(filePath)
 {
     m_impl = new Impl();
-    m_impl->device = new File(filePath);
+    //! NOTE Map the file, so that only the central directory and the entries that are actually read get loaded
+    if (File::mapFile(filePath, m_impl->mappedData)) {
+        m_impl->device = new Buffer(&m_impl->mappedData);
+    } else {
+        m_impl->device = new File(filePath);
+    }
     m_impl->isSelfDevice = true;
     if (m_impl->device->open(IODevice::ReadOnly)) {
     }
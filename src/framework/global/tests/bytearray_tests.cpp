@@ -197,3 +197,26 @@ TEST_F(Global_Types_ByteArrayTests, Modification)
     EXPECT_EQ(ba10.size(), 0);
     EXPECT_TRUE(ba10.empty());
 }
+
+TEST_F(Global_Types_ByteArrayTests, RawDataOwner)
+{
+    std::vector<uint8_t> ref = { 1, 2, 3, 4, 5, 6 };
+    std::shared_ptr<std::vector<uint8_t> > owner = std::make_shared<std::vector<uint8_t> >(ref);
+
+    //! GIVEN ByteArray referencing the owner data, not copied
+    ByteArray ba = ByteArray::fromRawData(owner->data(), owner->size(), owner);
+    EXPECT_EQ(ba.constData(), owner->data());
+
+    //! CHECK The owner is kept alive by the ByteArray and its copies
+    ByteArray copy = ba;
+    owner.reset();
+    EXPECT_EQ(std::memcmp(copy.constData(), &ref[0], ref.size()), 0);
+
+    //! DO Modify the copy
+    copy[0] = 42;
+
+    //! CHECK The copy is detached, the original is not modified
+    EXPECT_EQ(copy.at(0), 42);
+    EXPECT_EQ(ba.at(0), 1);
+    EXPECT_EQ(std::memcmp(ba.constData(), &ref[0], ref.size()), 0);
+}
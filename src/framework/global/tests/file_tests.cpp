@@ -207,3 +207,44 @@ TEST_F(Global_IO_FileTests, FileTests_Exists_Append)
         EXPECT_EQ(refba, data);
     }
 }
+
+TEST_F(Global_IO_FileTests, FileTests_WriteFile)
+{
+    path_t filePath("FileTests_WriteFile.txt");
+    createFile(filePath, "Hello World!");
+
+    //! DO Write other data to the file
+    std::string ref = "mimi";
+    EXPECT_TRUE(File::writeFile(filePath, ByteArray(reinterpret_cast<const uint8_t*>(ref.c_str()), ref.size())));
+
+    //! CHECK The file has only the new data
+    ByteArray data;
+    EXPECT_TRUE(File::readFile(filePath, data));
+    EXPECT_EQ(data, ByteArray(reinterpret_cast<const uint8_t*>(ref.c_str()), ref.size()));
+}
+
+#ifndef _WIN32
+//! NOTE On Windows a mapped file can't be replaced
+TEST_F(Global_IO_FileTests, FileTests_WriteFile_KeepsMappedData)
+{
+    path_t filePath("FileTests_WriteFile_KeepsMappedData.txt");
+    std::string old = "Hello World!";
+    createFile(filePath, old);
+
+    //! GIVEN The file is mapped
+    ByteArray mapped;
+    EXPECT_TRUE(File::mapFile(filePath, mapped));
+
+    //! DO Write other data to the file
+    std::string ref = "mimi";
+    EXPECT_TRUE(File::writeFile(filePath, ByteArray(reinterpret_cast<const uint8_t*>(ref.c_str()), ref.size())));
+
+    //! CHECK The file has the new data
+    ByteArray data;
+    EXPECT_TRUE(File::readFile(filePath, data));
+    EXPECT_EQ(data, ByteArray(reinterpret_cast<const uint8_t*>(ref.c_str()), ref.size()));
+
+    //! CHECK The file is replaced, not overwritten, so the mapped data is still the old one
+    EXPECT_EQ(mapped, ByteArray(reinterpret_cast<const uint8_t*>(old.c_str()), old.size()));
+}
+#endif
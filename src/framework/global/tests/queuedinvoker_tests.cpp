@@ -0,0 +1,169 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "thirdparty/deto_async/async/internal/queuedinvoker.h"
+
+using namespace deto::async;
+
+//! NOTE The tests don't use the main thread, its calls go through the event loop of the application
+class Global_Async_QueuedInvokerTests : public ::testing::Test
+{
+public:
+    //! NOTE Processes the calls of the current thread until the condition is met, gives up after a while,
+    //! so a lost call fails the test instead of hanging it
+    template<typename Condition>
+    static bool processEventsUntil(const Condition& condition)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+        while (!condition()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+
+            QueuedInvoker::instance()->processEvents();
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        return true;
+    }
+};
+
+TEST_F(Global_Async_QueuedInvokerTests, MultipleProducers_Ordering)
+{
+    //! GIVEN A thread which receives the calls
+    //! NOTE More calls are queued than the nodes of the pool of a queue (1024), so the pool is exhausted too
+    constexpr int PRODUCERS_COUNT = 4;
+    constexpr int CALLS_COUNT = 2000;
+
+    std::vector<std::vector<int> > received(PRODUCERS_COUNT);
+    std::atomic<int> receivedCount { 0 };
+    bool allReceived = false;
+
+    std::thread consumer([&]() {
+        allReceived = processEventsUntil([&]() {
+            return receivedCount.load() == PRODUCERS_COUNT * CALLS_COUNT;
+        });
+    });
+
+    const std::thread::id consumerId = consumer.get_id();
+
+    //! DO Queue the calls from several threads at the same time
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS_COUNT; ++p) {
+        producers.emplace_back([&, p]() {
+            for (int i = 0; i < CALLS_COUNT; ++i) {
+                QueuedInvoker::instance()->invoke(consumerId, [&, p, i]() {
+                    //! NOTE Called on the consumer thread only
+                    received[p].push_back(i);
+                    receivedCount.fetch_add(1);
+                });
+            }
+        });
+    }
+
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    consumer.join();
+
+    //! CHECK All the calls are received on the consumer thread
+    EXPECT_TRUE(allReceived);
+    EXPECT_EQ(receivedCount.load(), PRODUCERS_COUNT * CALLS_COUNT);
+
+    //! CHECK The calls of every producer are received in the order they were queued
+    for (int p = 0; p < PRODUCERS_COUNT; ++p) {
+        ASSERT_EQ(received[p].size(), static_cast<size_t>(CALLS_COUNT));
+        for (int i = 0; i < CALLS_COUNT; ++i) {
+            EXPECT_EQ(received[p][i], i);
+        }
+    }
+}
+
+TEST_F(Global_Async_QueuedInvokerTests, QueuedByCall_ProcessedNextTime)
+{
+    //! GIVEN A thread with a queued call, which queues one more call
+    int calls = 0;
+    std::vector<int> callsByProcess;
+
+    std::thread consumer([&]() {
+        const std::thread::id id = std::this_thread::get_id();
+        QueuedInvoker::instance()->invoke(id, [&calls, id]() {
+            ++calls;
+            QueuedInvoker::instance()->invoke(id, [&calls]() {
+                ++calls;
+            });
+        });
+
+        //! DO Process the calls twice
+        for (int i = 0; i < 2; ++i) {
+            QueuedInvoker::instance()->processEvents();
+            callsByProcess.push_back(calls);
+        }
+    });
+
+    consumer.join();
+
+    //! CHECK The call queued by a call is processed next time
+    EXPECT_EQ(callsByProcess, std::vector<int>({ 1, 2 }));
+}
+
+TEST_F(Global_Async_QueuedInvokerTests, MoreThreadsThanTable)
+{
+    //! GIVEN More threads alive at the same time than the invoker keeps in its table
+    const size_t threadsCount = QueuedInvoker::MAX_THREADS + 16;
+
+    std::vector<char> done(threadsCount, 0);
+    std::atomic<size_t> receivedCount { 0 };
+    std::atomic<size_t> failedCount { 0 };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadsCount);
+    for (size_t i = 0; i < threadsCount; ++i) {
+        threads.emplace_back([&, i]() {
+            //! NOTE The flag is set by the call, on this thread
+            if (!processEventsUntil([&]() { return done[i] != 0; })) {
+                failedCount.fetch_add(1);
+            }
+        });
+    }
+
+    //! DO Queue a call for every thread
+    for (size_t i = 0; i < threadsCount; ++i) {
+        QueuedInvoker::instance()->invoke(threads[i].get_id(), [&, i]() {
+            done[i] = 1;
+            receivedCount.fetch_add(1);
+        });
+    }
+
+    for (std::thread& th : threads) {
+        th.join();
+    }
+
+    //! CHECK No call is lost
+    EXPECT_EQ(failedCount.load(), 0u);
+    EXPECT_EQ(receivedCount.load(), threadsCount);
+}
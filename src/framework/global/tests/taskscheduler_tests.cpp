@@ -0,0 +1,166 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <vector>
+
+#include "concurrency/taskscheduler.h"
+
+using namespace mu;
+
+class Global_Concurrency_TaskSchedulerTests : public ::testing::Test
+{
+public:
+};
+
+TEST_F(Global_Concurrency_TaskSchedulerTests, SubmitReturnsResult)
+{
+    // [GIVEN] A scheduler with a few workers
+    TaskScheduler scheduler(4);
+
+    // [WHEN] Submitting tasks with different priorities
+    std::future<int> normal = scheduler.submit([](int a, int b) { return a + b; }, 2, 3);
+    std::future<int> realTime = scheduler.submitWithPriority(TaskPriority::RealTime, []() { return 42; });
+
+    // [THEN] Both results are delivered
+    EXPECT_EQ(normal.get(), 5);
+    EXPECT_EQ(realTime.get(), 42);
+}
+
+TEST_F(Global_Concurrency_TaskSchedulerTests, MoveOnlyTask)
+{
+    // [GIVEN] A scheduler and a task owning a move-only value
+    TaskScheduler scheduler(2);
+    std::unique_ptr<int> value = std::make_unique<int>(7);
+
+    // [WHEN] Submitting it
+    std::future<int> result = scheduler.submit([value = std::move(value)]() { return *value; });
+
+    // [THEN] The task is not copied on its way and runs
+    EXPECT_EQ(result.get(), 7);
+}
+
+TEST_F(Global_Concurrency_TaskSchedulerTests, WaitForAllTasksComplete)
+{
+    // [GIVEN] A scheduler
+    TaskScheduler scheduler(4);
+    std::atomic<int> counter = 0;
+
+    // [WHEN] Pushing a lot of tasks and waiting for them
+    for (int i = 0; i < 1000; ++i) {
+        scheduler.push([&counter]() { counter++; });
+    }
+
+    scheduler.waitForAllTasksComplete();
+
+    // [THEN] All of them are done
+    EXPECT_EQ(counter, 1000);
+}
+
+TEST_F(Global_Concurrency_TaskSchedulerTests, ParallelFor)
+{
+    // [GIVEN] A scheduler and some data
+    TaskScheduler scheduler(4);
+    std::vector<int> values(10000, 1);
+
+    // [WHEN] Processing the data in parallel
+    parallelFor(size_t(0), values.size(), [&values](size_t idx) {
+        values[idx] *= 2;
+    }, size_t(16), TaskPriority::Normal, &scheduler);
+
+    // [THEN] Every element has been processed exactly once
+    EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 20000);
+}
+
+TEST_F(Global_Concurrency_TaskSchedulerTests, NestedTaskGroups)
+{
+    // [GIVEN] A scheduler with less workers than the outer tasks
+    TaskScheduler scheduler(2);
+    std::atomic<int> counter = 0;
+
+    // [WHEN] Every task of a group waits for a nested group
+    TaskGroup outer(&scheduler);
+    for (int i = 0; i < 8; ++i) {
+        outer.run([&scheduler, &counter]() {
+            TaskGroup inner(&scheduler);
+            for (int j = 0; j < 8; ++j) {
+                inner.run([&counter]() { counter++; });
+            }
+            inner.wait();
+        });
+    }
+    outer.wait();
+
+    // [THEN] Waiting workers help executing tasks instead of deadlocking
+    EXPECT_EQ(counter, 64);
+}
+
+TEST_F(Global_Concurrency_TaskSchedulerTests, TaskGroupRethrowsException)
+{
+    // [GIVEN] A group with a failing task
+    TaskScheduler scheduler(2);
+    TaskGroup group(&scheduler);
+
+    group.run([]() { throw std::runtime_error("failed"); });
+
+    // [THEN] The exception is delivered to the waiting thread
+    EXPECT_THROW(group.wait(), std::runtime_error);
+}
+
+TEST_F(Global_Concurrency_TaskSchedulerTests, TaskGroupWaitRunsOnlyOwnTasks)
+{
+    // [GIVEN] A scheduler whose only worker is busy
+    TaskScheduler scheduler(1);
+
+    std::promise<void> releaseWorker;
+    std::shared_future<void> workerReleased = releaseWorker.get_future().share();
+    std::promise<void> workerBusy;
+    scheduler.push([workerReleased, &workerBusy]() {
+        workerBusy.set_value();
+        workerReleased.wait();
+    });
+    workerBusy.get_future().wait();
+
+    // [GIVEN] An unrelated task queued before the tasks of a group
+    const std::thread::id callerThreadId = std::this_thread::get_id();
+    std::atomic<bool> unrelatedRanOnCaller = false;
+    scheduler.push([&unrelatedRanOnCaller, callerThreadId]() {
+        unrelatedRanOnCaller = std::this_thread::get_id() == callerThreadId;
+    });
+
+    std::atomic<int> counter = 0;
+    TaskGroup group(&scheduler);
+    for (int i = 0; i < 4; ++i) {
+        group.run([&counter]() { counter++; });
+    }
+
+    // [WHEN] Waiting for the group
+    group.wait();
+
+    // [THEN] The waiting thread has executed the tasks of the group, but not the unrelated one
+    EXPECT_EQ(counter, 4);
+    EXPECT_FALSE(unrelatedRanOnCaller);
+
+    releaseWorker.set_value();
+    scheduler.waitForAllTasksComplete();
+}
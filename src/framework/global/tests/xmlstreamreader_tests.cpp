@@ -0,0 +1,276 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+
+#include "serialization/xmlstreamreader.h"
+
+#include "log.h"
+
+using namespace mu;
+
+class Global_Serialization_XmlStreamReaderTests : public ::testing::Test
+{
+public:
+    static ByteArray toByteArray(const std::string& str)
+    {
+        return ByteArray(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+    }
+};
+
+TEST_F(Global_Serialization_XmlStreamReaderTests, Tokens)
+{
+    //! GIVEN A document with all kinds of tokens
+    ByteArray data = toByteArray(
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<!-- comment -->\n"
+        "<museScore version=\"4.10\">\n"
+        "  <Score>\n"
+        "    <empty attr='1'/>\n"
+        "    <text> Some text </text>\n"
+        "  </Score>\n"
+        "</museScore>\n");
+
+    XmlStreamReader xml(data);
+
+    //! CHECK The tokens are read in the document order, the whitespace between the elements is skipped
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartDocument);
+
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::Comment);
+    EXPECT_EQ(xml.text(), u" comment ");
+
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartElement);
+    EXPECT_EQ(xml.name(), "museScore");
+    EXPECT_EQ(xml.attribute("version"), u"4.10");
+
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartElement);
+    EXPECT_EQ(xml.name(), "Score");
+
+    //! CHECK An empty element is reported as a start and an end element
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartElement);
+    EXPECT_EQ(xml.name(), "empty");
+    EXPECT_EQ(xml.intAttribute("attr"), 1);
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::EndElement);
+    EXPECT_EQ(xml.name(), "empty");
+    EXPECT_FALSE(xml.hasAttribute("attr"));
+
+    //! CHECK The whitespace inside the text is kept
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::StartElement);
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::Characters);
+    EXPECT_EQ(xml.text(), u" Some text ");
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::EndElement);
+    EXPECT_EQ(xml.name(), "text");
+
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::EndElement);
+    EXPECT_EQ(xml.name(), "Score");
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::EndElement);
+    EXPECT_EQ(xml.name(), "museScore");
+
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::EndDocument);
+    EXPECT_TRUE(xml.atEnd());
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::Invalid);
+
+    EXPECT_FALSE(xml.isError());
+}
+
+TEST_F(Global_Serialization_XmlStreamReaderTests, ReadValues)
+{
+    //! GIVEN A document with values of different kinds
+    ByteArray data = toByteArray(
+        "<values>\n"
+        "  <int>42</int>\n"
+        "  <double>0.5</double>\n"
+        "  <skipped><a><b/></a></skipped>\n"
+        "  <text a=\"x &amp; y\">&lt;&#65;&#x42;&gt; &quot;\xC3\xA9&quot;&unknown;</text>\n"
+        "  <cdata><![CDATA[<not> &amp; parsed]]></cdata>\n"
+        "  <lines>a\r\nb\rc</lines>\n"
+        "</values>\n");
+
+    XmlStreamReader xml(data);
+
+    EXPECT_TRUE(xml.readNextStartElement());
+    AsciiStringView rootName = xml.name();
+
+    //! CHECK Numbers are read
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.readInt(), 42);
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_DOUBLE_EQ(xml.readDouble(), 0.5);
+
+    //! CHECK A whole element is skipped
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.name(), "skipped");
+    xml.skipCurrentElement();
+
+    //! CHECK The entities and character references are decoded
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.attribute("a"), u"x & y");
+    EXPECT_EQ(xml.readText(), String::fromUtf8("<AB> \"\xC3\xA9\"&unknown;"));
+
+    //! CHECK CDATA is read as is
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.readAsciiText(), "<not> &amp; parsed");
+
+    //! CHECK The line breaks are normalized
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.readText(), u"a\nb\nc");
+
+    EXPECT_FALSE(xml.readNextStartElement());
+    EXPECT_TRUE(xml.isEndElement());
+
+    //! CHECK The views of the tokens stay valid
+    EXPECT_EQ(rootName, "values");
+    EXPECT_EQ(xml.name(), "values");
+
+    EXPECT_FALSE(xml.isError());
+}
+
+TEST_F(Global_Serialization_XmlStreamReaderTests, DtdEntities)
+{
+    //! GIVEN A document declaring an entity
+    ByteArray data = toByteArray(
+        "<!ENTITY version \"4.1\">\n"
+        "<doc>MuseScore &version;</doc>\n");
+
+    XmlStreamReader xml(data);
+
+    EXPECT_EQ(xml.readNext(), XmlStreamReader::DTD);
+
+    //! CHECK The entity is replaced in the text
+    EXPECT_TRUE(xml.readNextStartElement());
+    EXPECT_EQ(xml.readText(), u"MuseScore 4.1");
+}
+
+TEST_F(Global_Serialization_XmlStreamReaderTests, Errors)
+{
+    //! GIVEN A document with a mismatched end element
+    {
+        XmlStreamReader xml(toByteArray("<a>\n  <b>\n  </c>\n</a>"));
+
+        EXPECT_TRUE(xml.readNextStartElement());
+        EXPECT_TRUE(xml.readNextStartElement());
+
+        //! CHECK The error is reported where it happens
+        EXPECT_FALSE(xml.readNextStartElement());
+        EXPECT_EQ(xml.tokenType(), XmlStreamReader::Invalid);
+        EXPECT_EQ(xml.error(), XmlStreamReader::NotWellFormedError);
+        EXPECT_EQ(xml.lineNumber(), 3);
+        EXPECT_TRUE(xml.atEnd());
+    }
+
+    //! GIVEN A truncated document
+    {
+        XmlStreamReader xml(toByteArray("<a><b>text"));
+
+        EXPECT_TRUE(xml.readNextStartElement());
+        EXPECT_TRUE(xml.readNextStartElement());
+
+        //! CHECK Reading the text stops at the error
+        EXPECT_EQ(xml.readText(), String());
+        EXPECT_EQ(xml.error(), XmlStreamReader::PrematureEndOfDocumentError);
+    }
+
+    //! GIVEN An empty document
+    {
+        XmlStreamReader xml(toByteArray(" \n "));
+
+        //! CHECK Nothing is read
+        EXPECT_EQ(xml.readNext(), XmlStreamReader::Invalid);
+        EXPECT_TRUE(xml.isError());
+    }
+
+    //! GIVEN A valid document with a custom error raised
+    {
+        XmlStreamReader xml(toByteArray("<a/>"));
+        xml.raiseError(u"custom");
+
+        //! CHECK The custom error is reported
+        EXPECT_EQ(xml.error(), XmlStreamReader::CustomError);
+        EXPECT_EQ(xml.errorString(), u"custom");
+    }
+}
+
+TEST_F(Global_Serialization_XmlStreamReaderTests, Data)
+{
+    //! GIVEN A document shared with the reader
+    {
+        ByteArray data = toByteArray("<a>Tom &amp; Jerry</a>");
+        ByteArray original = toByteArray("<a>Tom &amp; Jerry</a>");
+
+        XmlStreamReader xml(data);
+
+        EXPECT_TRUE(xml.readNextStartElement());
+        EXPECT_EQ(xml.readText(), u"Tom & Jerry");
+
+        //! CHECK The data isn't changed by decoding
+        EXPECT_EQ(data, original);
+    }
+
+    //! GIVEN A document moved to the reader
+    {
+        ByteArray data = toByteArray("<a>text</a>");
+        const char* begin = data.constChar();
+        const char* end = begin + data.size();
+
+        XmlStreamReader xml(std::move(data));
+
+        //! CHECK The tokens point into the moved data, it isn't copied
+        EXPECT_TRUE(xml.readNextStartElement());
+        const char* name = xml.name().ascii();
+        EXPECT_TRUE(name >= begin && name < end);
+    }
+}
+
+TEST_F(Global_Serialization_XmlStreamReaderTests, DISABLED_ReadThroughput)
+{
+    //! GIVEN A big document, similar to a score
+    std::string str = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<museScore version=\"4.10\">\n<Score>\n";
+    while (str.size() < 50 * 1024 * 1024) {
+        str += "  <Measure>\n    <voice>\n      <Chord>\n        <durationType>quarter</durationType>\n"
+               "        <Note>\n          <pitch>60</pitch>\n          <tpc>14</tpc>\n        </Note>\n"
+               "      </Chord>\n      <Rest visible=\"0\">\n        <durationType>measure</durationType>\n"
+               "        <duration>4/4</duration>\n      </Rest>\n    </voice>\n  </Measure>\n";
+    }
+    str += "</Score>\n</museScore>\n";
+
+    ByteArray data = toByteArray(str);
+
+    //! DO Read all the tokens
+    auto start = std::chrono::steady_clock::now();
+
+    XmlStreamReader xml(data);
+    size_t tokensCount = 0;
+    while (xml.readNext() != XmlStreamReader::Invalid) {
+        ++tokensCount;
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    //! CHECK The whole document has been read
+    EXPECT_FALSE(xml.isError());
+
+    LOGI() << "read " << tokensCount << " tokens of " << data.size() / (1024 * 1024) << " MB in " << seconds << " s, "
+           << (data.size() / (1024.0 * 1024.0)) / seconds << " MB/s";
+}
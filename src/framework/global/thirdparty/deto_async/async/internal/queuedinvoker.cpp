@@ -1,42 +1,275 @@
 #include "queuedinvoker.h"
 
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
 using namespace deto::async;
 
+//! NOTE Multiple producers, single consumer (the thread the calls are queued for).
+//! The producers never block, they only allocate when the node pool is exhausted.
+class QueuedInvoker::Queue
+{
+public:
+
+    Queue()
+    {
+        m_pool.reset(new Node[POOL_SIZE]);
+        for (uint32_t i = 0; i < POOL_SIZE; ++i) {
+            m_pool[i].pooled = true;
+            m_pool[i].nextFree.store(i + 1 < POOL_SIZE ? i + 2 : 0, std::memory_order_relaxed);
+        }
+        m_freeHead.store(1, std::memory_order_relaxed);
+
+        m_head.store(&m_stub, std::memory_order_relaxed);
+        m_tail = &m_stub;
+    }
+
+    ~Queue()
+    {
+        Node* n = pop();
+        while (n) {
+            releaseNode(n);
+            n = pop();
+        }
+    }
+
+    void push(const Functor& f)
+    {
+        Node* n = acquireNode();
+        n->f = f;
+        pushNode(n);
+        m_size.fetch_add(1, std::memory_order_release);
+    }
+
+    //! NOTE Only the calls queued before are processed,
+    //! the calls queued by them are processed next time
+    void process()
+    {
+        int64_t count = m_size.load(std::memory_order_acquire);
+        while (count-- > 0) {
+            Node* n = pop();
+            if (!n) {
+                break;
+            }
+
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+
+            Functor f = std::move(n->f);
+            n->f = nullptr;
+            releaseNode(n);
+
+            if (f) {
+                f();
+            }
+        }
+    }
+
+    bool hasPending() const
+    {
+        return m_size.load(std::memory_order_acquire) > 0;
+    }
+
+private:
+
+    struct Node {
+        std::atomic<Node*> next { nullptr };
+        std::atomic<uint32_t> nextFree { 0 };
+        Functor f;
+        bool pooled = false;
+    };
+
+    static constexpr uint32_t POOL_SIZE = 1024;
+
+    // Free list of the pool: the low 32 bits are the node index + 1 (0 - empty),
+    // the high 32 bits are a tag, which is changed on every update against ABA
+    static uint64_t makeFreeHead(uint64_t prev, uint32_t index)
+    {
+        uint64_t tag = (prev >> 32) + 1;
+        return (tag << 32) | index;
+    }
+
+    Node* acquireNode()
+    {
+        uint64_t head = m_freeHead.load(std::memory_order_acquire);
+        while (true) {
+            uint32_t index = static_cast<uint32_t>(head);
+            if (index == 0) {
+                return new Node();
+            }
+
+            Node* n = &m_pool[index - 1];
+            uint32_t next = n->nextFree.load(std::memory_order_relaxed);
+            if (m_freeHead.compare_exchange_weak(head, makeFreeHead(head, next),
+                                                 std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return n;
+            }
+        }
+    }
+
+    void releaseNode(Node* n)
+    {
+        if (!n->pooled) {
+            delete n;
+            return;
+        }
+
+        uint32_t index = static_cast<uint32_t>(n - m_pool.get()) + 1;
+        uint64_t head = m_freeHead.load(std::memory_order_relaxed);
+        do {
+            n->nextFree.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        } while (!m_freeHead.compare_exchange_weak(head, makeFreeHead(head, index),
+                                                   std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    void pushNode(Node* n)
+    {
+        n->next.store(nullptr, std::memory_order_relaxed);
+        Node* prev = m_head.exchange(n, std::memory_order_acq_rel);
+        prev->next.store(n, std::memory_order_release);
+    }
+
+    Node* pop()
+    {
+        Node* tail = m_tail;
+        Node* next = tail->next.load(std::memory_order_acquire);
+
+        if (tail == &m_stub) {
+            if (!next) {
+                return nullptr;
+            }
+
+            m_tail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+
+        if (next) {
+            m_tail = next;
+            return tail;
+        }
+
+        //! NOTE A producer is in the middle of a push
+        if (tail != m_head.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+
+        pushNode(&m_stub);
+
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            m_tail = next;
+            return tail;
+        }
+
+        return nullptr;
+    }
+
+    std::unique_ptr<Node[]> m_pool;
+    std::atomic<uint64_t> m_freeHead { 0 };
+
+    std::atomic<Node*> m_head { nullptr };
+    Node* m_tail = nullptr;
+    Node m_stub;
+
+    std::atomic<int64_t> m_size { 0 };
+};
+
 QueuedInvoker* QueuedInvoker::instance()
 {
     static QueuedInvoker i;
     return &i;
 }
 
-void QueuedInvoker::invoke(const std::thread::id& th, const Functor& f, bool isAlwaysQueued)
+QueuedInvoker::~QueuedInvoker()
 {
-    if (m_onMainThreadInvoke) {
-        if (th == m_mainThreadID) {
-            m_onMainThreadInvoke(f, isAlwaysQueued);
-        }
+    size_t count = m_queuesCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        delete m_queues[i].queue;
     }
 
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
-    m_queues[th].push(f);
+    for (auto& p : m_overflowQueues) {
+        delete p.second;
+    }
 }
 
-void QueuedInvoker::processEvents()
+QueuedInvoker::Queue* QueuedInvoker::queue(const std::thread::id& th)
 {
-    Queue q;
-    {
-        std::lock_guard<std::recursive_mutex> lock(m_mutex);
-        auto n = m_queues.extract(std::this_thread::get_id());
-        if (!n.empty()) {
-            q = n.mapped();
+    size_t count = m_queuesCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        if (m_queues[i].th == th) {
+            return m_queues[i].queue;
         }
     }
-    while (!q.empty()) {
-        const auto& f = q.front();
-        if (f) {
-            f();
+
+    std::lock_guard<std::mutex> lock(m_queuesMutex);
+
+    count = m_queuesCount.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        if (m_queues[i].th == th) {
+            return m_queues[i].queue;
         }
-        q.pop();
     }
+
+    //! NOTE The calls must not be lost, so the threads which don't fit in the table get their queues anyway,
+    //! only finding them is slower
+    if (count == MAX_THREADS) {
+        auto it = m_overflowQueues.find(th);
+        if (it != m_overflowQueues.end()) {
+            return it->second;
+        }
+
+        if (m_overflowQueues.empty()) {
+            std::cerr << "QueuedInvoker: more than " << MAX_THREADS
+                      << " threads, the queues of the next threads are found with locking\n";
+        }
+
+        Queue* q = new Queue();
+        m_overflowQueues.emplace(th, q);
+        return q;
+    }
+
+    m_queues[count].th = th;
+    m_queues[count].queue = new Queue();
+    m_queuesCount.store(count + 1, std::memory_order_release);
+
+    return m_queues[count].queue;
+}
+
+void QueuedInvoker::invoke(const std::thread::id& th, const Functor& f, bool isAlwaysQueued)
+{
+    bool isMainThread = m_onMainThreadInvoke && th == m_mainThreadID;
+    if (isMainThread && !isAlwaysQueued && std::this_thread::get_id() == m_mainThreadID) {
+        m_onMainThreadInvoke(f, false);
+        return;
+    }
+
+    Queue* q = queue(th);
+    q->push(f);
+
+    //! NOTE The main thread has its own event loop, it is asked once to process all the calls queued until then
+    if (isMainThread && !m_mainThreadProcessScheduled.exchange(true, std::memory_order_acq_rel)) {
+        m_onMainThreadInvoke([this]() { processMainThreadQueue(); }, true);
+    }
+}
+
+void QueuedInvoker::processMainThreadQueue()
+{
+    m_mainThreadProcessScheduled.store(false, std::memory_order_release);
+
+    Queue* q = queue(m_mainThreadID);
+    q->process();
+
+    //! NOTE Calls which were in the middle of being queued
+    if (q->hasPending() && !m_mainThreadProcessScheduled.exchange(true, std::memory_order_acq_rel)) {
+        m_onMainThreadInvoke([this]() { processMainThreadQueue(); }, true);
+    }
+}
+
+void QueuedInvoker::processEvents()
+{
+    Queue* q = queue(std::this_thread::get_id());
+    q->process();
 }
 
 void QueuedInvoker::onMainThreadInvoke(const std::function<void(const std::function<void()>&, bool)>& f)
@@ -2,7 +2,8 @@
 #define DETO_ASYNC_QUEUEDINVOKER_H
 
 #include <functional>
-#include <queue>
+#include <array>
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <thread>
@@ -21,14 +22,33 @@ public:
     void processEvents();
     void onMainThreadInvoke(const std::function<void(const std::function<void()>&, bool)>& f);
 
+    //! NOTE The queues of the threads above it are kept in a map and are found with locking
+    static constexpr size_t MAX_THREADS = 256;
+
 private:
 
     QueuedInvoker() = default;
+    ~QueuedInvoker();
+
+    class Queue;
+
+    //! NOTE The queues are found without locking, the lock is only taken when a queue is created
+    //! for a thread and when the queue of a thread above MAX_THREADS is looked for
+    Queue* queue(const std::thread::id& th);
+
+    void processMainThreadQueue();
+
+    struct ThreadQueue {
+        std::thread::id th;
+        Queue* queue = nullptr;
+    };
 
-    using Queue = std::queue<Functor>;
+    std::array<ThreadQueue, MAX_THREADS> m_queues;
+    std::atomic<size_t> m_queuesCount { 0 };
+    std::map<std::thread::id, Queue*> m_overflowQueues;
+    std::mutex m_queuesMutex;
 
-    std::recursive_mutex m_mutex;
-    std::map<std::thread::id, Queue > m_queues;
+    std::atomic<bool> m_mainThreadProcessScheduled { false };
 
     std::function<void(const std::function<void()>&, bool)> m_onMainThreadInvoke;
     std::thread::id m_mainThreadID;
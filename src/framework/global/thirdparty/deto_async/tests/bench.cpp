@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../async/internal/queuedinvoker.h"
+
+using namespace deto::async;
+
+//! NOTE Measures the calls queued from an "audio worker" thread to the "main" thread:
+//! messages per second and the latency from the send to the call.
+//! The main thread event loop is emulated by a locked queue of posted calls, as Qt does.
+
+using Clock = std::chrono::steady_clock;
+
+struct EventLoop
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::function<void()> > posted;
+    bool quit = false;
+
+    void post(const std::function<void()>& f)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            posted.push_back(f);
+        }
+        cv.notify_one();
+    }
+
+    void exec()
+    {
+        while (true) {
+            std::function<void()> f;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [this]() { return quit || !posted.empty(); });
+                if (posted.empty()) {
+                    return;
+                }
+                f = std::move(posted.front());
+                posted.pop_front();
+            }
+            f();
+        }
+    }
+
+    void exit()
+    {
+        post([this]() { quit = true; });
+    }
+};
+
+struct Received
+{
+    EventLoop* loop = nullptr;
+    std::vector<int64_t> latencies;
+    std::atomic<uint32_t> count { 0 };
+};
+
+//! NOTE The calls only capture the sequence number and the send time,
+//! so that std::function does not allocate and only the invoker is measured
+static Received s_received;
+
+static void onReceived(uint32_t seq, int64_t sendTime)
+{
+    s_received.latencies[seq] = Clock::now().time_since_epoch().count() - sendTime;
+    if (s_received.count.fetch_add(1) + 1 == s_received.latencies.size()) {
+        s_received.loop->exit();
+    }
+}
+
+static void run(uint32_t messagesCount, uint32_t burstSize, std::chrono::microseconds burstInterval)
+{
+    EventLoop loop;
+    QueuedInvoker* invoker = QueuedInvoker::instance();
+    invoker->onMainThreadInvoke([&loop](const std::function<void()>& f, bool) {
+        loop.post(f);
+    });
+
+    std::thread::id mainThreadID = std::this_thread::get_id();
+
+    s_received.loop = &loop;
+    s_received.latencies.assign(messagesCount, 0);
+    s_received.count = 0;
+
+    Clock::time_point start = Clock::now();
+
+    std::thread worker([&]() {
+        uint32_t sent = 0;
+        while (sent < messagesCount) {
+            uint32_t burstEnd = std::min(sent + burstSize, messagesCount);
+            for (; sent < burstEnd; ++sent) {
+                uint32_t seq = sent;
+                int64_t sendTime = Clock::now().time_since_epoch().count();
+                invoker->invoke(mainThreadID, [seq, sendTime]() {
+                    onReceived(seq, sendTime);
+                });
+            }
+
+            if (burstInterval.count() > 0) {
+                std::this_thread::sleep_for(burstInterval);
+            }
+        }
+    });
+
+    loop.exec();
+    worker.join();
+
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<int64_t>& latencies = s_received.latencies;
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) {
+        size_t i = std::min(latencies.size() - 1, static_cast<size_t>(p * static_cast<double>(latencies.size())));
+        double ns = std::chrono::duration<double, std::nano>(Clock::duration(latencies[i])).count();
+        return ns / 1000.0;
+    };
+
+    std::cout << "messages: " << messagesCount
+              << ", burst: " << burstSize
+              << ", interval: " << burstInterval.count() << " us\n"
+              << "  messages/s: " << static_cast<uint64_t>(messagesCount / seconds) << "\n"
+              << "  latency us: p50 " << percentile(0.5)
+              << ", p99 " << percentile(0.99)
+              << ", p99.9 " << percentile(0.999)
+              << ", max " << percentile(1.0) << "\n";
+}
+
+int main(int, char**)
+{
+    // As fast as possible
+    run(1000000, 1000000, std::chrono::microseconds(0));
+
+    // Like the audio worker: a few notifications every 2 ms
+    run(20000, 8, std::chrono::microseconds(2000));
+
+    return 0;
+}
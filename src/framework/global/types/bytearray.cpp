@@ -70,6 +70,13 @@ ByteArray ByteArray::fromRawData(const char* data, size_t size)
     return fromRawData(reinterpret_cast<const uint8_t*>(data), size);
 }
 
+ByteArray ByteArray::fromRawData(const uint8_t* data, size_t size, std::shared_ptr<const void> owner)
+{
+    ByteArray ba = fromRawData(data, size);
+    ba.m_raw.owner = std::move(owner);
+    return ba;
+}
+
 uint8_t* ByteArray::data()
 {
     detach();
@@ -106,10 +113,11 @@ void ByteArray::detach()
     }
 
     if (m_raw.data) {
-        m_data->resize(m_raw.size + 1);
+        //! NOTE Copies of raw data share the placeholder, so don't write into it
+        m_data = std::make_shared<Data>(m_raw.size + 1);
         m_data->operator [](m_raw.size) = 0;
         std::memcpy(m_data->data(), m_raw.data, m_raw.size);
-        m_raw.data = nullptr;
+        m_raw = RawData();
         return;
     }
 
@@ -118,6 +118,12 @@ public:
         return m_dataPtr->cend();
     }
 
+    //! NOTE The copies share the same data until one of them is changed
+    const Data* constData() const noexcept
+    {
+        return m_dataPtr.get();
+    }
+
     const_iterator find(const KeyType& key) const noexcept
     {
         return m_dataPtr->find(key);
@@ -115,6 +115,12 @@ public:
         return m_dataPtr->cend();
     }
 
+    //! NOTE The copies share the same data until one of them is changed
+    const Data* constData() const noexcept
+    {
+        return m_dataPtr.get();
+    }
+
     const_reverse_iterator rbegin() const noexcept
     {
         return m_dataPtr->rbegin();
@@ -26,6 +26,8 @@
 #include <variant>
 #include <vector>
 #include <optional>
+#include <type_traits>
+#include <unordered_set>
 
 #include "async/channel.h"
 #include "realfn.h"
@@ -136,6 +138,16 @@ struct NoteEvent
         return m_expressionCtx;
     }
 
+    void shiftTimestamp(const timestamp_t offset)
+    {
+        m_arrangementCtx.nominalTimestamp += offset;
+        m_arrangementCtx.actualTimestamp += offset;
+
+        for (auto& pair : m_expressionCtx.articulations) {
+            pair.second.meta.timestamp += offset;
+        }
+    }
+
     bool operator==(const NoteEvent& other) const
     {
         return m_arrangementCtx == other.m_arrangementCtx
@@ -159,6 +171,9 @@ private:
         calculatePitchCurve(m_expressionCtx.articulations);
 
         calculateExpressionCurve(m_expressionCtx.articulations, requiredVelocityFraction);
+
+        m_pitchCtx.pitchCurve = ValuesCurvePool<pitch_level_t>::intern(m_pitchCtx.pitchCurve);
+        m_expressionCtx.expressionCurve = ValuesCurvePool<dynamic_level_t>::intern(m_expressionCtx.expressionCurve);
     }
 
     void calculateActualTimestamp(const ArticulationMap& articulationsApplied)
@@ -264,6 +279,12 @@ struct RestEvent
         return m_arrangementCtx;
     }
 
+    void shiftTimestamp(const timestamp_t offset)
+    {
+        m_arrangementCtx.nominalTimestamp += offset;
+        m_arrangementCtx.actualTimestamp += offset;
+    }
+
     bool operator==(const RestEvent& other) const
     {
         return m_arrangementCtx == other.m_arrangementCtx;
@@ -273,6 +294,80 @@ private:
     ArrangementContext m_arrangementCtx;
 };
 
+//! NOTE The note curves built while the scope is alive share their data, see ValuesCurvePool
+struct NoteCurvesSharingScope
+{
+    ValuesCurvePool<pitch_level_t>::Scope pitchCurves;
+    ValuesCurvePool<dynamic_level_t>::Scope expressionCurves;
+};
+
+//! NOTE An estimation of the memory taken by the events of a track.
+//! The data shared between the events is counted once
+struct PlaybackEventsMemoryUsage
+{
+    size_t timestampsCount = 0;
+    size_t eventsCount = 0;
+    size_t eventsBytes = 0;
+    size_t sharedDataBytes = 0;
+
+    size_t totalBytes() const
+    {
+        return eventsBytes + sharedDataBytes;
+    }
+};
+
+inline PlaybackEventsMemoryUsage memoryUsage(const PlaybackEventsMap& events)
+{
+    //! NOTE The allocation and the tree/hash node overhead
+    constexpr size_t NODE_OVERHEAD_BYTES = 4 * sizeof(void*);
+
+    PlaybackEventsMemoryUsage result;
+    std::unordered_set<const void*> countedData;
+
+    auto countCurve = [&result, &countedData](const auto& curve) {
+        using Data = std::remove_cv_t<std::remove_pointer_t<decltype(curve.constData())> >;
+
+        if (!countedData.insert(curve.constData()).second) {
+            return;
+        }
+
+        result.sharedDataBytes += sizeof(Data) + NODE_OVERHEAD_BYTES
+                                  + curve.size() * (sizeof(typename Data::value_type) + NODE_OVERHEAD_BYTES);
+    };
+
+    auto countArticulations = [&result, &countedData](const ArticulationMap& articulations) {
+        using Data = ArticulationMap::Data;
+
+        if (!countedData.insert(articulations.constData()).second) {
+            return;
+        }
+
+        result.sharedDataBytes += sizeof(Data) + NODE_OVERHEAD_BYTES
+                                  + articulations.size() * (sizeof(Data::value_type) + NODE_OVERHEAD_BYTES);
+    };
+
+    result.timestampsCount = events.size();
+    result.eventsBytes = events.size() * (sizeof(PlaybackEventsMap::value_type) + NODE_OVERHEAD_BYTES);
+
+    for (const auto& pair : events) {
+        result.eventsCount += pair.second.size();
+        result.eventsBytes += pair.second.capacity() * sizeof(PlaybackEvent);
+
+        for (const PlaybackEvent& event : pair.second) {
+            const NoteEvent* noteEvent = std::get_if<NoteEvent>(&event);
+            if (!noteEvent) {
+                continue;
+            }
+
+            countCurve(noteEvent->pitchCtx().pitchCurve);
+            countCurve(noteEvent->expressionCtx().expressionCurve);
+            countArticulations(noteEvent->expressionCtx().articulations);
+        }
+    }
+
+    return result;
+}
+
 struct PlaybackSetupData
 {
     SoundId id = SoundId::Undefined;
@@ -29,6 +29,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <map>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -176,6 +177,94 @@ private:
     }
 };
 
+//! NOTE Most of the notes end up with one of a few curves,
+//! so the equal curves share their data instead of keeping a copy per note.
+//! The curves are shared only while a Scope is alive on the rendering thread:
+//! the pool belongs to the scope and is dropped with it, so nothing stays behind once rendering is finished.
+//! Events are rendered in parallel, every thread has its own scope, so that they don't wait for each other
+template<typename T>
+class ValuesCurvePool
+{
+public:
+    class Scope
+    {
+    public:
+        Scope()
+        {
+            //! NOTE The nested scopes use the pool of the outermost one
+            if (!currentPool()) {
+                m_pool = std::make_unique<ValuesCurvePool>();
+                currentPool() = m_pool.get();
+            }
+        }
+
+        ~Scope()
+        {
+            if (m_pool) {
+                currentPool() = nullptr;
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        std::unique_ptr<ValuesCurvePool> m_pool;
+    };
+
+    static ValuesCurve<T> intern(const ValuesCurve<T>& curve)
+    {
+        ValuesCurvePool* pool = currentPool();
+        if (!pool) {
+            return curve;
+        }
+
+        size_t key = hash(curve);
+
+        auto it = pool->m_curves.find(key);
+        if (it != pool->m_curves.end()) {
+            for (const ValuesCurve<T>& interned : it->second) {
+                if (interned == curve) {
+                    return interned;
+                }
+            }
+        }
+
+        //! NOTE Once the pool is full, the curves which are already there are still shared,
+        //! the rare new ones just keep their own copy
+        if (pool->m_curvesCount < MAX_CURVES_COUNT) {
+            pool->m_curves[key].push_back(curve);
+            ++pool->m_curvesCount;
+        }
+
+        return curve;
+    }
+
+private:
+    static constexpr size_t MAX_CURVES_COUNT = 4096;
+
+    static ValuesCurvePool*& currentPool()
+    {
+        thread_local ValuesCurvePool* pool = nullptr;
+        return pool;
+    }
+
+    static size_t hash(const ValuesCurve<T>& curve)
+    {
+        size_t result = curve.size();
+
+        for (const auto& pair : curve) {
+            result = result * 31 + static_cast<size_t>(pair.first);
+            result = result * 31 + static_cast<size_t>(pair.second);
+        }
+
+        return result;
+    }
+
+    std::unordered_map<size_t, std::vector<ValuesCurve<T> > > m_curves;
+    size_t m_curvesCount = 0;
+};
+
 // Pitch
 enum class PitchClass {
     Undefined = -1,
@@ -0,0 +1,145 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include "mpe/events.h"
+#include "mpe/tests/utils/articulationutils.h"
+
+using namespace mu;
+using namespace mu::mpe;
+using namespace mu::mpe::tests;
+
+class Mpe_PlaybackEventsMemoryTest : public ::testing::Test
+{
+protected:
+    NoteEvent buildNoteEvent(const timestamp_t timestamp) const
+    {
+        ArticulationPatternSegment standardPattern;
+        standardPattern.arrangementPattern = createArrangementPattern(HUNDRED_PERCENT /*duration_factor*/, 0 /*timestamp_offset*/);
+        standardPattern.pitchPattern = createSimplePitchPattern(0 /*increment_pitch_diff*/);
+        standardPattern.expressionPattern = createSimpleExpressionPattern(dynamicLevelFromType(DynamicType::Natural));
+
+        ArticulationPattern scope;
+        scope.emplace(0, standardPattern);
+
+        ArticulationMeta meta;
+        meta.type = ArticulationType::Standard;
+        meta.pattern = scope;
+        meta.timestamp = timestamp;
+        meta.overallDuration = m_duration;
+
+        ArticulationMap articulations;
+        articulations.emplace(ArticulationType::Standard, ArticulationAppliedData(std::move(meta), 0, HUNDRED_PERCENT));
+        articulations.preCalculateAverageData();
+
+        return NoteEvent(timestamp, m_duration, 0 /*voiceIdx*/, pitchLevel(PitchClass::A, 4),
+                         dynamicLevelFromType(DynamicType::Natural), articulations, 0 /*bps*/);
+    }
+
+    duration_t m_duration = 500; // msecs
+};
+
+/**
+ * @brief Mpe_PlaybackEventsMemoryTest_EqualCurvesAreShared
+ * @details Two notes are built from different articulation maps with the same content,
+ *          so their pitch and expression curves are equal and have to share the data
+ */
+TEST_F(Mpe_PlaybackEventsMemoryTest, EqualCurvesAreShared)
+{
+    // [GIVEN] The curves are shared while they are rendered
+    NoteCurvesSharingScope curvesSharing;
+
+    // [WHEN] Two notes with the same articulations are built
+    NoteEvent first = buildNoteEvent(0);
+    NoteEvent second = buildNoteEvent(m_duration);
+
+    // [THEN] Their curves are the same objects
+    EXPECT_EQ(first.pitchCtx().pitchCurve.constData(), second.pitchCtx().pitchCurve.constData());
+    EXPECT_EQ(first.expressionCtx().expressionCurve.constData(), second.expressionCtx().expressionCurve.constData());
+
+    // [THEN] And they are not shared with the articulations of the notes
+    EXPECT_NE(first.expressionCtx().articulations.constData(), second.expressionCtx().articulations.constData());
+}
+
+/**
+ * @brief Mpe_PlaybackEventsMemoryTest_CurvesAreReleasedWithScope
+ * @details The pool of the curves lives only as long as the scope, so the curves built
+ *          after the rendering is finished are not shared with the ones built during it
+ */
+TEST_F(Mpe_PlaybackEventsMemoryTest, CurvesAreReleasedWithScope)
+{
+    // [GIVEN] A note built while the curves are shared
+    std::optional<NoteEvent> first;
+    {
+        NoteCurvesSharingScope curvesSharing;
+        first = buildNoteEvent(0);
+    }
+
+    // [WHEN] Two more notes are built once the scope is gone
+    NoteEvent second = buildNoteEvent(m_duration);
+    NoteEvent third = buildNoteEvent(2 * m_duration);
+
+    // [THEN] None of them shares the curves, there is no pool left to take them from
+    EXPECT_NE(first->pitchCtx().pitchCurve.constData(), second.pitchCtx().pitchCurve.constData());
+    EXPECT_NE(second.pitchCtx().pitchCurve.constData(), third.pitchCtx().pitchCurve.constData());
+    EXPECT_NE(second.expressionCtx().expressionCurve.constData(), third.expressionCtx().expressionCurve.constData());
+
+    // [WHEN] A new scope is opened
+    NoteCurvesSharingScope curvesSharing;
+    NoteEvent fourth = buildNoteEvent(3 * m_duration);
+
+    // [THEN] It starts with an empty pool instead of the curves of the previous one
+    EXPECT_NE(first->pitchCtx().pitchCurve.constData(), fourth.pitchCtx().pitchCurve.constData());
+}
+
+/**
+ * @brief Mpe_PlaybackEventsMemoryTest_MemoryUsage
+ * @details The memory usage report counts every event, but the data shared between the events only once
+ */
+TEST_F(Mpe_PlaybackEventsMemoryTest, MemoryUsage)
+{
+    NoteCurvesSharingScope curvesSharing;
+
+    // [GIVEN] A track with a single note
+    PlaybackEventsMap singleNote;
+    singleNote[0].emplace_back(buildNoteEvent(0));
+
+    // [GIVEN] A track with two equal notes
+    PlaybackEventsMap twoNotes;
+    twoNotes[0].emplace_back(buildNoteEvent(0));
+    twoNotes[m_duration].emplace_back(buildNoteEvent(m_duration));
+
+    // [WHEN] The memory usage is estimated
+    PlaybackEventsMemoryUsage singleNoteUsage = memoryUsage(singleNote);
+    PlaybackEventsMemoryUsage twoNotesUsage = memoryUsage(twoNotes);
+
+    // [THEN] All the events are counted
+    EXPECT_EQ(singleNoteUsage.eventsCount, 1u);
+    EXPECT_EQ(twoNotesUsage.eventsCount, 2u);
+    EXPECT_EQ(twoNotesUsage.timestampsCount, 2u);
+    EXPECT_GT(twoNotesUsage.eventsBytes, singleNoteUsage.eventsBytes);
+
+    // [THEN] The shared curves are counted once, only the articulations of the second note are added
+    EXPECT_GT(twoNotesUsage.sharedDataBytes, singleNoteUsage.sharedDataBytes);
+    EXPECT_LT(twoNotesUsage.sharedDataBytes, 2 * singleNoteUsage.sharedDataBytes);
+    EXPECT_EQ(twoNotesUsage.totalBytes(), twoNotesUsage.eventsBytes + twoNotesUsage.sharedDataBytes);
+}
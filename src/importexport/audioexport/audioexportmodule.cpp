@@ -28,6 +28,7 @@
 #include "internal/wavewriter.h"
 #include "internal/oggwriter.h"
 #include "internal/flacwriter.h"
+#include "internal/soundtracksexporter.h"
 
 #include "internal/audioexportconfiguration.h"
 
@@ -47,6 +48,7 @@ void AudioExportModule::registerExports()
     m_configuration = std::make_shared<AudioExportConfiguration>();
 
     ioc()->registerExport<AudioExportConfiguration>(moduleName(), m_configuration);
+    ioc()->registerExport<ISoundTracksExporter>(moduleName(), std::make_shared<SoundTracksExporter>());
 }
 
 void AudioExportModule::resolveImports()
@@ -86,6 +86,45 @@ mu::framework::Progress* AbstractAudioWriter::progress()
     return &m_progress;
 }
 
+mu::audio::SoundTrackFormat AbstractAudioWriter::soundTrackFormat(audio::SoundTrackType type) const
+{
+    audio::SoundTrackFormat format;
+    format.type = type;
+    format.sampleRate = static_cast<audio::sample_rate_t>(configuration()->exportSampleRate());
+    format.audioChannelsNumber = 2;
+
+    switch (type) {
+    case audio::SoundTrackType::MP3:
+        format.bitRate = configuration()->exportMp3Bitrate();
+        break;
+    case audio::SoundTrackType::OGG:
+    case audio::SoundTrackType::FLAC:
+        format.bitRate = 128;
+        break;
+    case audio::SoundTrackType::WAV:
+    case audio::SoundTrackType::Undefined:
+        format.bitRate = 0;
+        break;
+    }
+
+    return format;
+}
+
+std::optional<mu::audio::SoundTrackType> AbstractAudioWriter::soundTrackType(const std::string& suffix)
+{
+    if (suffix == "wav") {
+        return audio::SoundTrackType::WAV;
+    } else if (suffix == "mp3") {
+        return audio::SoundTrackType::MP3;
+    } else if (suffix == "ogg") {
+        return audio::SoundTrackType::OGG;
+    } else if (suffix == "flac") {
+        return audio::SoundTrackType::FLAC;
+    }
+
+    return std::nullopt;
+}
+
 mu::Ret AbstractAudioWriter::doWriteAndWait(INotationPtr notation, QIODevice& destinationDevice, const audio::SoundTrackFormat& format)
 {
     //!Note Temporary workaround, since QIODevice is the alias for QIODevice, which falls with SIGSEGV
@@ -96,6 +135,11 @@ mu::Ret AbstractAudioWriter::doWriteAndWait(INotationPtr notation, QIODevice& de
     QFileInfo info(*file);
     QString path = info.absoluteFilePath();
 
+    return doWriteAndWait(notation, { audio::SoundTrackTarget { io::path_t(path), format, audio::MASTER_MIX_TRACK_ID } });
+}
+
+mu::Ret AbstractAudioWriter::doWriteAndWait(INotationPtr notation, const audio::SoundTrackTargetList& targets)
+{
     m_isCompleted = false;
     m_writeRet = Ret();
 
@@ -108,7 +152,7 @@ mu::Ret AbstractAudioWriter::doWriteAndWait(INotationPtr notation, QIODevice& de
     });
 
     playback()->sequenceIdList()
-    .onResolve(this, [this, path, &format](const audio::TrackSequenceIdList& sequenceIdList) {
+    .onResolve(this, [this, targets](const audio::TrackSequenceIdList& sequenceIdList) {
         m_progress.started.notify();
 
         for (const audio::TrackSequenceId sequenceId : sequenceIdList) {
@@ -117,9 +161,9 @@ mu::Ret AbstractAudioWriter::doWriteAndWait(INotationPtr notation, QIODevice& de
                 m_progress.progressChanged.send(current, total, title);
             });
 
-            playback()->audioOutput()->saveSoundTrack(sequenceId, io::path_t(path), std::move(format))
-            .onResolve(this, [this, path](const bool /*result*/) {
-                LOGD() << "Successfully saved sound track by path: " << path;
+            playback()->audioOutput()->saveSoundTracks(sequenceId, targets)
+            .onResolve(this, [this](const bool /*result*/) {
+                LOGD() << "Successfully saved sound tracks";
                 m_writeRet = make_ok();
                 m_isCompleted = true;
                 m_progress.finished.send(make_ok());
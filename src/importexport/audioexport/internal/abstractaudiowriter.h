@@ -22,6 +22,8 @@
 #ifndef MU_IMPORTEXPORT_ABSTRACTAUDIOWRITER_H
 #define MU_IMPORTEXPORT_ABSTRACTAUDIOWRITER_H
 
+#include <optional>
+
 #include "async/asyncable.h"
 #include "modularity/ioc.h"
 #include "audio/iplayback.h"
@@ -50,8 +52,14 @@ public:
     void abort() override;
 
 protected:
+    audio::SoundTrackFormat soundTrackFormat(audio::SoundTrackType type) const;
+    static std::optional<audio::SoundTrackType> soundTrackType(const std::string& suffix);
+
     Ret doWriteAndWait(notation::INotationPtr notation, QIODevice& destinationDevice, const audio::SoundTrackFormat& format);
 
+    //! NOTE Renders the notation once and writes every target from that single pass
+    Ret doWriteAndWait(notation::INotationPtr notation, const audio::SoundTrackTargetList& targets);
+
 private:
     UnitType unitTypeFromOptions(const Options& options) const;
 
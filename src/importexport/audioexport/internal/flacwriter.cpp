@@ -29,12 +29,5 @@ using namespace mu::io;
 
 mu::Ret FlacWriter::write(notation::INotationPtr notation, QIODevice& destinationDevice, const Options&)
 {
-    const audio::SoundTrackFormat format {
-        audio::SoundTrackType::FLAC,
-        static_cast<audio::sample_rate_t>(configuration()->exportSampleRate()),
-        2 /* audioChannelsNumber */,
-        128 /* bitRate */
-    };
-
-    return doWriteAndWait(notation, destinationDevice, format);
+    return doWriteAndWait(notation, destinationDevice, soundTrackFormat(audio::SoundTrackType::FLAC));
 }
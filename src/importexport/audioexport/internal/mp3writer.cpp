@@ -29,12 +29,5 @@ using namespace mu::framework;
 
 mu::Ret Mp3Writer::write(notation::INotationPtr notation, QIODevice& destinationDevice, const Options&)
 {
-    const audio::SoundTrackFormat format {
-        audio::SoundTrackType::MP3,
-        static_cast<audio::sample_rate_t>(configuration()->exportSampleRate()),
-        2 /* audioChannelsNumber */,
-        configuration()->exportMp3Bitrate()
-    };
-
-    return doWriteAndWait(notation, destinationDevice, format);
+    return doWriteAndWait(notation, destinationDevice, soundTrackFormat(audio::SoundTrackType::MP3));
 }
@@ -0,0 +1,57 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "soundtracksexporter.h"
+
+#include "log.h"
+
+using namespace mu::iex::audioexport;
+
+mu::Ret SoundTracksExporter::exportSoundTracks(notation::INotationPtr notation, const io::paths_t& mixPaths,
+                                               const StemsPaths& stemsPaths)
+{
+    audio::SoundTrackTargetList targets;
+
+    auto addTarget = [this, &targets](const io::path_t& path, const io::path_t& stemsSuffix, audio::TrackId trackId) {
+        std::optional<audio::SoundTrackType> type = soundTrackType(io::suffix(path + stemsSuffix));
+        if (!type) {
+            LOGE() << "unsupported audio format: " << path + stemsSuffix;
+            return false;
+        }
+
+        targets.push_back(audio::SoundTrackTarget { path, soundTrackFormat(type.value()), trackId, stemsSuffix });
+        return true;
+    };
+
+    for (const io::path_t& path : mixPaths) {
+        if (!addTarget(path, io::path_t(), audio::MASTER_MIX_TRACK_ID)) {
+            return make_ret(Ret::Code::NotSupported);
+        }
+    }
+
+    for (const StemsPath& stems : stemsPaths) {
+        if (!addTarget(stems.prefix, stems.suffix, audio::ALL_TRACKS_STEMS_ID)) {
+            return make_ret(Ret::Code::NotSupported);
+        }
+    }
+
+    return doWriteAndWait(notation, targets);
+}
@@ -0,0 +1,36 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_IMPORTEXPORT_SOUNDTRACKSEXPORTER_H
+#define MU_IMPORTEXPORT_SOUNDTRACKSEXPORTER_H
+
+#include "abstractaudiowriter.h"
+#include "../isoundtracksexporter.h"
+
+namespace mu::iex::audioexport {
+class SoundTracksExporter : public ISoundTracksExporter, public AbstractAudioWriter
+{
+public:
+    Ret exportSoundTracks(notation::INotationPtr notation, const io::paths_t& mixPaths, const StemsPaths& stemsPaths) override;
+};
+}
+
+#endif // MU_IMPORTEXPORT_SOUNDTRACKSEXPORTER_H
@@ -0,0 +1,53 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_IMPORTEXPORT_ISOUNDTRACKSEXPORTER_H
+#define MU_IMPORTEXPORT_ISOUNDTRACKSEXPORTER_H
+
+#include "modularity/imoduleinterface.h"
+#include "types/ret.h"
+#include "io/path.h"
+#include "notation/inotation.h"
+
+namespace mu::iex::audioexport {
+//! NOTE The files of the stems of all the tracks: prefix + track name + suffix
+struct StemsPath {
+    io::path_t prefix;
+    io::path_t suffix;
+};
+
+using StemsPaths = std::vector<StemsPath>;
+
+class ISoundTracksExporter : MODULE_EXPORT_INTERFACE
+{
+    INTERFACE_ID(ISoundTracksExporter)
+
+public:
+    virtual ~ISoundTracksExporter() = default;
+
+    //! NOTE Renders the notation once and writes every file from that single pass:
+    //! the mix into each of mixPaths, the stem of every track into each of stemsPaths.
+    //! The format of a file is taken from its suffix
+    virtual Ret exportSoundTracks(notation::INotationPtr notation, const io::paths_t& mixPaths, const StemsPaths& stemsPaths) = 0;
+};
+}
+
+#endif // MU_IMPORTEXPORT_ISOUNDTRACKSEXPORTER_H
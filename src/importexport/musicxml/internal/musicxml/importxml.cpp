@@ -24,6 +24,8 @@
  MusicXML import.
  */
 
+#include <mutex>
+
 #include <QBuffer>
 #include <QDomDocument>
 #include <QMessageBox>
@@ -35,6 +37,7 @@
 
 #include "translation.h"
 
+#include "global/concurrency/taskscheduler.h"
 #include "global/deprecated/qzipreader_p.h"
 
 #include "engraving/types/types.h"
@@ -104,6 +107,37 @@ static bool initMusicXmlSchema(QXmlSchema& schema)
     return true;
 }
 
+//---------------------------------------------------------
+//   musicXmlSchema
+//    return nullptr on error
+//---------------------------------------------------------
+
+/**
+ Return the MusicXML schema, it is loaded and compiled once per process.
+ Validations using it must be serialized with musicXmlSchemaMutex().
+ */
+
+static const QXmlSchema* musicXmlSchema()
+{
+    // intentionally never deleted, must not be destroyed after the application object
+    static const QXmlSchema* schema = []() -> const QXmlSchema* {
+        QXmlSchema* s = new QXmlSchema();
+        s->setMessageHandler(new ValidatorMessageHandler());
+        if (!initMusicXmlSchema(*s)) {
+            return nullptr;
+        }
+        return s;
+    }();
+
+    return schema;
+}
+
+static std::mutex& musicXmlSchemaMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
 //---------------------------------------------------------
 //   musicXMLValidationErrorDialog
 //---------------------------------------------------------
@@ -182,37 +216,55 @@ static bool extractRootfile(QFile* qf, QByteArray& data)
 }
 
 //---------------------------------------------------------
-//   doValidate
+//   validate
 //---------------------------------------------------------
 
 /**
- Validate MusicXML data from file \a name contained in QIODevice \a dev.
+ Validate MusicXML \a data from file \a name against \a schema.
+ Return true if valid, the validation errors are returned in \a errors.
  */
 
-static Err doValidate(const QString& name, QIODevice* dev)
+static bool validate(const QXmlSchema& schema, const QString& name, const QByteArray& data, QString& errors)
 {
     //QElapsedTimer t;
     //t.start();
 
-    // initialize the schema
+    std::lock_guard lock(musicXmlSchemaMutex());
+
     ValidatorMessageHandler messageHandler;
-    QXmlSchema schema;
-    schema.setMessageHandler(&messageHandler);
-    if (!initMusicXmlSchema(schema)) {
-        return Err::FileBadFormat;      // appropriate error message has been printed by initMusicXmlSchema
-    }
-    // validate the data
     QXmlSchemaValidator validator(schema);
-    bool valid = validator.validate(dev, QUrl::fromLocalFile(name));
+    validator.setMessageHandler(&messageHandler);
+    bool valid = validator.validate(data, QUrl::fromLocalFile(name));
     //LOGD("Validation time elapsed: %d ms", t.elapsed());
 
+    errors = messageHandler.getErrors();
+
     if (!valid) {
         LOGD("importMusicXml() file '%s' is not a valid MusicXML file", qPrintable(name));
+    }
+
+    return valid;
+}
+
+//---------------------------------------------------------
+//   doValidate
+//---------------------------------------------------------
+
+/**
+ Validate MusicXML \a data from file \a name.
+ */
+
+static Err doValidate(const QString& name, const QByteArray& data)
+{
+    const QXmlSchema* schema = musicXmlSchema();
+    if (!schema) {
+        return Err::FileBadFormat;      // appropriate error message has been printed by initMusicXmlSchema
+    }
+
+    QString errors;
+    if (!validate(*schema, name, data, errors)) {
         QString strErr = qtrc("iex_musicxml", "File '%1' is not a valid MusicXML file.").arg(name);
-        if (MScore::noGui) {
-            return Err::NoError;         // might as well try anyhow in converter mode
-        }
-        if (musicXMLValidationErrorDialog(strErr, messageHandler.getErrors()) != QMessageBox::Yes) {
+        if (musicXMLValidationErrorDialog(strErr, errors) != QMessageBox::Yes) {
             return Err::UserAbort;
         }
     }
@@ -230,14 +282,37 @@ static Err doValidate(const QString& name, QIODevice* dev)
 
 static Err doValidateAndImport(Score* score, const QString& name, QIODevice* dev)
 {
-    // validate the file
-    Err res = doValidate(name, dev);
-    if (res != Err::NoError) {
-        return res;
+    QByteArray data = dev->readAll();
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+
+    // with the gui the user decides whether to import an invalid file
+    if (!MScore::noGui) {
+        Err res = doValidate(name, data);
+        if (res != Err::NoError) {
+            return res;
+        }
+
+        return importMusicXMLfromBuffer(score, name, &buffer);
     }
 
-    // actually do the import
-    res = importMusicXMLfromBuffer(score, name, dev);
+    // in converter mode the file is imported anyhow,
+    // so the validation is only reported and runs in parallel with the import
+    const QXmlSchema* schema = musicXmlSchema();
+    if (!schema) {
+        return Err::FileBadFormat;      // appropriate error message has been printed by initMusicXmlSchema
+    }
+
+    TaskGroup validation;
+    validation.run([schema, &name, &data]() {
+        QString errors;
+        validate(*schema, name, data, errors);
+    });
+
+    Err res = importMusicXMLfromBuffer(score, name, &buffer);
+
+    validation.wait();
+
     //LOGD("res %d", static_cast<int>(res));
     return res;
 }
@@ -43,9 +43,19 @@ public:
     virtual SizeF pageSizeInch() const = 0;
 
     virtual void paintView(draw::Painter* painter, const RectF& frameRect, bool isPrinting) = 0;
+
+    //! NOTE paintView() split in two parts: the score content of one page
+    //! (may be cached by the view) and the interaction overlays drawn on top
+    virtual void paintViewPage(draw::Painter* painter, int pageIndex, const RectF& frameRect, bool isPrinting) = 0;
+    virtual void paintViewOverlays(draw::Painter* painter) = 0;
+
     virtual void paintPdf(draw::Painter* painter, const Options& opt) = 0;
     virtual void paintPrint(draw::Painter* painter, const Options& opt) = 0;
     virtual void paintPng(draw::Painter* painter, const Options& opt) = 0;
+
+    //! NOTE While enabled, the printed pages are painted once and paintPdf() and paintPng()
+    //! replay them, without touching the score, so that they can be called concurrently
+    virtual void setPrintCacheEnabled(bool enabled) = 0;
 };
 
 using INotationPaintingPtr = std::shared_ptr<INotationPainting>;
@@ -24,9 +24,13 @@
 #include <QScreen>
 
 #include "engraving/libmscore/score.h"
+#include "engraving/libmscore/page.h"
 #include "engraving/infrastructure/paint.h"
 #include "engraving/infrastructure/debugpaint.h"
 
+#include "draw/bufferedpaintprovider.h"
+#include "draw/utils/drawdatapaint.h"
+
 #include "notation.h"
 #include "notationinteraction.h"
 
@@ -119,6 +123,15 @@ void NotationPainting::doPaint(draw::Painter* painter, const Options& opt)
         return;
     }
 
+    doPaintScore(painter, opt);
+
+    if (!opt.isPrinting) {
+        paintViewOverlays(painter);
+    }
+}
+
+void NotationPainting::doPaintScore(draw::Painter* painter, const Options& opt)
+{
     Options myopt = opt;
     bool printPageBackground = myopt.printPageBackground;
     myopt.onPaintPageSheet
@@ -127,10 +140,6 @@ void NotationPainting::doPaint(draw::Painter* painter, const Options& opt)
     };
 
     engraving::Paint::paintScore(painter, score(), myopt);
-
-    if (!myopt.isPrinting) {
-        static_cast<NotationInteraction*>(m_notation->interaction().get())->paint(painter);
-    }
 }
 
 void NotationPainting::paintPageSheet(Painter* painter, const RectF& pageRect, const RectF& pageContentRect, bool isOdd,
@@ -180,7 +189,7 @@ void NotationPainting::paintPageSheet(Painter* painter, const RectF& pageRect, c
     }
 }
 
-void NotationPainting::paintView(Painter* painter, const RectF& frameRect, bool isPrinting)
+NotationPainting::Options NotationPainting::viewOptions(const RectF& frameRect, bool isPrinting) const
 {
     Options opt;
     opt.isSetViewport = false;
@@ -188,7 +197,34 @@ void NotationPainting::paintView(Painter* painter, const RectF& frameRect, bool
     opt.frameRect = frameRect;
     opt.deviceDpi = uiConfiguration()->logicalDpi();
     opt.isPrinting = isPrinting;
-    doPaint(painter, opt);
+    return opt;
+}
+
+void NotationPainting::paintView(Painter* painter, const RectF& frameRect, bool isPrinting)
+{
+    doPaint(painter, viewOptions(frameRect, isPrinting));
+}
+
+void NotationPainting::paintViewPage(Painter* painter, int pageIndex, const RectF& frameRect, bool isPrinting)
+{
+    TRACEFUNC;
+    if (!score()) {
+        return;
+    }
+
+    Options opt = viewOptions(frameRect, isPrinting);
+    opt.fromPage = pageIndex;
+    opt.toPage = pageIndex;
+    doPaintScore(painter, opt);
+}
+
+void NotationPainting::paintViewOverlays(Painter* painter)
+{
+    if (!score()) {
+        return;
+    }
+
+    static_cast<NotationInteraction*>(m_notation->interaction().get())->paint(painter);
 }
 
 void NotationPainting::paintPdf(draw::Painter* painter, const Options& opt)
@@ -198,6 +234,12 @@ void NotationPainting::paintPdf(draw::Painter* painter, const Options& opt)
     myopt.isSetViewport = true;
     myopt.isMultiPage = false;
     myopt.isPrinting = true;
+
+    if (!m_printedPages.empty()) {
+        paintPrintedPages(painter, myopt);
+        return;
+    }
+
     doPaint(painter, myopt);
 }
 
@@ -218,5 +260,102 @@ void NotationPainting::paintPng(Painter* painter, const Options& opt)
     myopt.isSetViewport = true;
     myopt.isMultiPage = false;
     myopt.isPrinting = true;
+
+    if (!m_printedPages.empty()) {
+        paintPrintedPages(painter, myopt);
+        return;
+    }
+
     doPaint(painter, myopt);
 }
+
+void NotationPainting::setPrintCacheEnabled(bool enabled)
+{
+    m_printedPages.clear();
+    m_printedPageSizeInch = SizeF();
+
+    if (!enabled || !score()) {
+        return;
+    }
+
+    TRACEFUNC;
+
+    //! NOTE Pages are painted for our DPI, so there is no viewport transformation in the painted data,
+    //! the device transformation is applied on replay
+    Options opt;
+    opt.isSetViewport = false;
+    opt.isMultiPage = false;
+    opt.isPrinting = true;
+    opt.printPageBackground = false;
+    opt.deviceDpi = static_cast<int>(engraving::DPI);
+
+    const std::vector<Page*>& pages = score()->pages();
+    for (size_t i = 0; i < pages.size(); ++i) {
+        auto provider = std::make_shared<BufferedPaintProvider>();
+        {
+            Painter painter(provider, "printcache");
+            opt.fromPage = static_cast<int>(i);
+            opt.toPage = static_cast<int>(i);
+            engraving::Paint::paintScore(&painter, score(), opt);
+        }
+
+        const Page* page = pages.at(i);
+        RectF pageRect = page->bbox();
+        RectF pageContentRect = pageRect.adjusted(page->lm(), page->tm(), -page->rm(), -page->bm());
+
+        m_printedPages.push_back({ provider->drawData(), pageRect, pageContentRect });
+    }
+
+    m_printedPageSizeInch = pageSizeInch();
+}
+
+//! NOTE Same as engraving::Paint::paintScore, but draws the printed pages
+void NotationPainting::paintPrintedPages(draw::Painter* painter, const Options& opt) const
+{
+    TRACEFUNC;
+
+    const int DEVICE_DPI = opt.deviceDpi > 0 ? opt.deviceDpi : engraving::DPI;
+    const SizeF pageSize = m_printedPageSizeInch;
+
+    painter->setAntialiasing(true);
+    painter->setViewport(RectF(0.0, 0.0, std::lrint(pageSize.width() * DEVICE_DPI), std::lrint(pageSize.height() * DEVICE_DPI)));
+    painter->setWindow(RectF(0.0, 0.0, std::lrint(pageSize.width() * engraving::DPI), std::lrint(pageSize.height() * engraving::DPI)));
+
+    //! NOTE The pages were painted with MScore::pixelRatio == 1
+    const double fontScale = engraving::DPI / DEVICE_DPI;
+
+    const int pagesCount = static_cast<int>(m_printedPages.size());
+    int fromPage = opt.fromPage >= 0 ? opt.fromPage : 0;
+    int toPage = (opt.toPage >= 0 && opt.toPage < pagesCount) ? opt.toPage : (pagesCount - 1);
+
+    for (int pi = fromPage; pi <= toPage; ++pi) {
+        const PrintedPage& page = m_printedPages.at(pi);
+
+        RectF pageRect = page.rect;
+        if (opt.trimMarginPixelSize >= 0) {
+            double trimSize = static_cast<double>(opt.trimMarginPixelSize);
+            pageRect = page.contentRect.adjusted(-trimSize, -trimSize, trimSize, trimSize);
+        }
+
+        if (pi != fromPage && opt.onNewPage) {
+            opt.onNewPage();
+        }
+
+        if (opt.printPageBackground) {
+            painter->fillRect(pageRect, Color::WHITE);
+        }
+
+        bool disableClipping = false;
+        if (!painter->hasClipping()) {
+            painter->setClipping(true);
+            painter->setClipRect(pageRect);
+            disableClipping = true;
+        }
+
+        DrawDataPaint::replay(painter, page.drawData, fontScale);
+
+        if (disableClipping) {
+            painter->setClipping(false);
+        }
+    }
+}
@@ -22,9 +22,13 @@
 #ifndef MU_NOTATION_NOTATIONPAINTING_H
 #define MU_NOTATION_NOTATIONPAINTING_H
 
+#include <vector>
+
 #include "../inotationpainting.h"
 #include "igetscore.h"
 
+#include "draw/types/drawdata.h"
+
 #include "modularity/ioc.h"
 #include "../inotationconfiguration.h"
 #include "engraving/iengravingconfiguration.h"
@@ -53,20 +57,36 @@ public:
     SizeF pageSizeInch() const override;
 
     void paintView(draw::Painter* painter, const RectF& frameRect, bool isPrinting) override;
+    void paintViewPage(draw::Painter* painter, int pageIndex, const RectF& frameRect, bool isPrinting) override;
+    void paintViewOverlays(draw::Painter* painter) override;
     void paintPdf(draw::Painter* painter, const Options& opt) override;
     void paintPrint(draw::Painter* painter, const Options& opt) override;
     void paintPng(draw::Painter* painter, const Options& opt) override;
 
+    void setPrintCacheEnabled(bool enabled) override;
+
 private:
+    struct PrintedPage {
+        draw::DrawDataPtr drawData;
+        RectF rect;
+        RectF contentRect;
+    };
+
     mu::engraving::Score* score() const;
 
     bool isPaintPageBorder() const;
+    Options viewOptions(const RectF& frameRect, bool isPrinting) const;
     void doPaint(draw::Painter* painter, const Options& opt);
+    void doPaintScore(draw::Painter* painter, const Options& opt);
     void paintPageBorder(draw::Painter* painter, const mu::engraving::Page* page) const;
     void paintPageSheet(mu::draw::Painter* painter, const RectF& pageRect, const RectF& pageContentRect, bool isOdd,
                         bool printPageBackground) const;
+    void paintPrintedPages(draw::Painter* painter, const Options& opt) const;
 
     Notation* m_notation = nullptr;
+
+    std::vector<PrintedPage> m_printedPages;
+    SizeF m_printedPageSizeInch;
 };
 }
 
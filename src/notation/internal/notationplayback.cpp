@@ -71,6 +71,7 @@ void NotationPlayback::init(INotationUndoStackPtr undoStack)
     m_playbackModel.setPlayRepeats(configuration()->isPlayRepeatsEnabled());
     m_playbackModel.setPlayChordSymbols(configuration()->isPlayChordSymbolsEnabled());
 
+    m_playbackModel.setPlaybackPositionTick(score()->playPos().ticks());
     m_playbackModel.load(score());
 
     updateTotalPlayTime();
@@ -96,6 +97,7 @@ void NotationPlayback::init(INotationUndoStackPtr undoStack)
 
     score()->posChanged().onReceive(this, [this](mu::engraving::POS pos, int tick) {
         if (mu::engraving::POS::CURRENT == pos) {
+            m_playbackModel.setPlaybackPositionTick(tick);
             m_playPositionTickChanged.send(tick);
         } else {
             updateLoopBoundaries();
@@ -0,0 +1,223 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <QImage>
+#include <QPainter>
+
+#include "notation/view/notationtilecache.h"
+
+#include "engraving/compat/scoreaccess.h"
+#include "engraving/libmscore/factory.h"
+#include "engraving/libmscore/masterscore.h"
+#include "engraving/libmscore/page.h"
+
+using namespace mu;
+using namespace mu::notation;
+using namespace mu::engraving;
+
+//! NOTE The view size in device independent pixels, it is covered by 2x2 tiles
+static constexpr int VIEW_SIZE = 500;
+static constexpr size_t TILE_BYTES = 4 * 256 * 256;
+
+class Notation_NotationTileCacheTests : public ::testing::Test
+{
+protected:
+    struct PaintedTile {
+        int pageIndex = 0;
+        RectF frameRect;
+    };
+
+    void SetUp() override
+    {
+        m_score = compat::ScoreAccess::createMasterScore();
+    }
+
+    void TearDown() override
+    {
+        for (Page* page : m_pages) {
+            delete page;
+        }
+        m_pages.clear();
+
+        delete m_score;
+    }
+
+    Page* addPage(const PointF& pos, const SizeF& size)
+    {
+        Page* page = Factory::createPage(m_score->rootItem(), false);
+        page->setPos(pos);
+        page->setbbox(RectF(PointF(), size));
+        m_pages.push_back(page);
+
+        return page;
+    }
+
+    //! NOTE Paints the pages scrolled by the given device independent pixels,
+    //! returns the tiles which were painted (not taken from the cache)
+    std::vector<PaintedTile> paint(NotationTileCache& cache, double scale, const PointF& scroll, qreal devicePixelRatio = 1.0)
+    {
+        const int pixelSize = static_cast<int>(VIEW_SIZE * devicePixelRatio);
+        QImage device(pixelSize, pixelSize, QImage::Format_ARGB32_Premultiplied);
+        device.setDevicePixelRatio(devicePixelRatio);
+        QPainter painter(&device);
+
+        draw::Transform transform;
+        transform.translate(-scroll.x(), -scroll.y());
+        transform.scale(scale, scale);
+
+        std::vector<PaintedTile> paintedTiles;
+        cache.paint(&painter, m_pages, transform, RectF(0, 0, VIEW_SIZE, VIEW_SIZE), false,
+                    [&paintedTiles](draw::Painter*, int pageIndex, const RectF& frameRect) {
+            paintedTiles.push_back({ pageIndex, frameRect });
+        });
+
+        return paintedTiles;
+    }
+
+    MasterScore* m_score = nullptr;
+    std::vector<Page*> m_pages;
+};
+
+TEST_F(Notation_NotationTileCacheTests, TilesAreReused)
+{
+    //! GIVEN A page bigger than the view
+    addPage(PointF(0, 0), SizeF(1000, 1000));
+
+    NotationTileCache cache;
+
+    //! DO The page is painted
+    //! CHECK The visible tiles are painted
+    EXPECT_EQ(paint(cache, 1.0, PointF(0, 0)).size(), 4);
+
+    //! DO The page is painted again
+    //! CHECK All the tiles are taken from the cache
+    EXPECT_EQ(paint(cache, 1.0, PointF(0, 0)).size(), 0);
+
+    //! DO The view is scrolled by one tile
+    std::vector<PaintedTile> paintedTiles = paint(cache, 1.0, PointF(256, 0));
+
+    //! CHECK Only the tiles which came into view are painted
+    ASSERT_EQ(paintedTiles.size(), 2);
+    for (const PaintedTile& tile : paintedTiles) {
+        EXPECT_EQ(tile.frameRect.left(), 512);
+    }
+}
+
+TEST_F(Notation_NotationTileCacheTests, AreaInvalidation)
+{
+    //! GIVEN Two small pages, one under the other, each is covered by 2 tiles
+    addPage(PointF(0, 0), SizeF(400, 200));
+    addPage(PointF(0, 300), SizeF(400, 200));
+
+    NotationTileCache cache;
+    EXPECT_EQ(paint(cache, 1.0, PointF(0, 0)).size(), 4);
+
+    //! DO An area of the second page is invalidated
+    cache.invalidate(RectF(10, 310, 20, 20));
+    std::vector<PaintedTile> paintedTiles = paint(cache, 1.0, PointF(0, 0));
+
+    //! CHECK Only the tile with the area is painted again
+    ASSERT_EQ(paintedTiles.size(), 1);
+    EXPECT_EQ(paintedTiles.at(0).pageIndex, 1);
+    EXPECT_EQ(paintedTiles.at(0).frameRect.topLeft(), PointF(0, 300));
+
+    //! DO An area of the first page is invalidated
+    cache.invalidate(RectF(300, 10, 20, 20));
+    paintedTiles = paint(cache, 1.0, PointF(0, 0));
+
+    //! CHECK Only the tile with the area is painted again
+    ASSERT_EQ(paintedTiles.size(), 1);
+    EXPECT_EQ(paintedTiles.at(0).pageIndex, 0);
+    EXPECT_EQ(paintedTiles.at(0).frameRect.topLeft(), PointF(256, 0));
+
+    //! DO An area between the pages is invalidated
+    cache.invalidate(RectF(10, 240, 20, 20));
+
+    //! CHECK Nothing is painted again
+    EXPECT_EQ(paint(cache, 1.0, PointF(0, 0)).size(), 0);
+
+    //! DO All the tiles are invalidated
+    cache.invalidate();
+
+    //! CHECK All the visible tiles are painted again
+    EXPECT_EQ(paint(cache, 1.0, PointF(0, 0)).size(), 4);
+}
+
+TEST_F(Notation_NotationTileCacheTests, ZoomAndDevicePixelRatio)
+{
+    //! GIVEN A page bigger than the view
+    addPage(PointF(0, 0), SizeF(1000, 1000));
+
+    NotationTileCache cache;
+    EXPECT_EQ(paint(cache, 1.0, PointF(0, 0)).size(), 4);
+
+    //! DO The view is zoomed in
+    //! CHECK The tiles of the new zoom are painted
+    EXPECT_EQ(paint(cache, 2.0, PointF(0, 0)).size(), 4);
+
+    //! DO The view is zoomed back
+    //! CHECK The tiles of the previous zoom are reused
+    EXPECT_EQ(paint(cache, 1.0, PointF(0, 0)).size(), 0);
+
+    //! DO The device pixel ratio is changed (the window moved to another screen)
+    //! CHECK All the tiles are painted again
+    EXPECT_EQ(paint(cache, 1.0, PointF(0, 0), 2.0).size(), 4);
+    EXPECT_EQ(paint(cache, 1.0, PointF(0, 0), 2.0).size(), 0);
+}
+
+TEST_F(Notation_NotationTileCacheTests, MemoryBudgetEviction)
+{
+    //! GIVEN A page much bigger than the view
+    addPage(PointF(0, 0), SizeF(4000, 4000));
+
+    //! GIVEN The budget is 8 tiles, that is, two views
+    NotationTileCache cache;
+    cache.setMemoryBudget(8 * TILE_BYTES);
+
+    const PointF viewA(0, 0);
+    const PointF viewB(512, 0);
+    const PointF viewC(1024, 0);
+
+    EXPECT_EQ(paint(cache, 1.0, viewA).size(), 4);
+    EXPECT_EQ(paint(cache, 1.0, viewB).size(), 4);
+
+    //! DO The third view is painted
+    EXPECT_EQ(paint(cache, 1.0, viewC).size(), 4);
+
+    //! CHECK The least recently used tiles are dropped, the others are kept
+    EXPECT_EQ(paint(cache, 1.0, viewB).size(), 0);
+    EXPECT_EQ(paint(cache, 1.0, viewA).size(), 4);
+    EXPECT_EQ(paint(cache, 1.0, viewB).size(), 0);
+    EXPECT_EQ(paint(cache, 1.0, viewC).size(), 4);
+
+    //! DO The budget is smaller than the view
+    cache.setMemoryBudget(0);
+
+    //! CHECK The visible tiles are still kept
+    EXPECT_EQ(paint(cache, 1.0, viewC).size(), 0);
+    EXPECT_EQ(paint(cache, 1.0, viewA).size(), 4);
+    EXPECT_EQ(paint(cache, 1.0, viewA).size(), 0);
+}
@@ -25,6 +25,11 @@
 
 #include "actions/actiontypes.h"
 
+#include "engraving/libmscore/measure.h"
+#include "engraving/libmscore/page.h"
+#include "engraving/libmscore/score.h"
+#include "engraving/libmscore/system.h"
+
 #include "log.h"
 
 using namespace mu;
@@ -63,6 +68,7 @@ AbstractNotationPaintView::AbstractNotationPaintView(QQuickItem* parent)
     m_loopOutMarker = std::make_unique<LoopMarker>(LoopBoundaryType::LoopOut);
 
     m_continuousPanel = std::make_unique<ContinuousPanel>();
+    m_tileCache = std::make_unique<NotationTileCache>();
 
     //! NOTE For diagnostic tools
     dispatcher()->reg(this, "diagnostic-notationview-redraw", [this]() {
@@ -228,6 +234,13 @@ void AbstractNotationPaintView::onLoadNotation(INotationPtr)
 
     INotationInteractionPtr interaction = notationInteraction();
 
+    //! NOTE The tiles are invalidated right where the painted content changes:
+    //! the moved items are found by the tile cache in the page logs, the changes of commands
+    //! and of the settings are handled here. A notation change on its own doesn't drop the tiles
+    m_notation->undoStack()->changesChannel().onReceive(this, [this](const ChangesRange& range) {
+        invalidateTiles(range);
+    });
+
     m_notation->notationChanged().onNotify(this, [this, interaction]() {
         interaction->hideShadowNote();
         redraw();
@@ -239,6 +252,8 @@ void AbstractNotationPaintView::onLoadNotation(INotationPtr)
     });
 
     interaction->selectionChanged().onNotify(this, [this]() {
+        //! NOTE Selected elements are painted in the selection color
+        invalidateTiles(notationInteraction()->selection()->elements());
         redraw();
 
         EngravingItem* selectedElement = notationInteraction()->selection()->element();
@@ -260,7 +275,16 @@ void AbstractNotationPaintView::onLoadNotation(INotationPtr)
         }
     });
 
+    interaction->scoreConfigChanged().onReceive(this, [this](ScoreConfigType) {
+        //! NOTE Invisible and unprintable elements, frames, page margins
+        m_tileCache->invalidate();
+        redraw();
+    });
+
     interaction->dropChanged().onNotify(this, [this]() {
+        //! NOTE The drop target is painted in a different color
+        m_tileCache->invalidate();
+
         if (!hasActiveFocus()) {
             forceFocusIn(); // grab keyboard focus after element added from palette
         }
@@ -305,9 +329,15 @@ void AbstractNotationPaintView::onLoadNotation(INotationPtr)
 void AbstractNotationPaintView::onUnloadNotation(INotationPtr)
 {
     m_notation->notationChanged().resetOnNotify(this);
+    m_notation->undoStack()->changesChannel().resetOnReceive(this);
     INotationInteractionPtr interaction = m_notation->interaction();
     interaction->noteInput()->stateChanged().resetOnNotify(this);
     interaction->selectionChanged().resetOnNotify(this);
+    interaction->dropChanged().resetOnNotify(this);
+    interaction->scoreConfigChanged().resetOnReceive(this);
+
+    m_tileCache->invalidate();
+    m_selectedElementsRects.clear();
 
     if (isMainView()) {
         m_notation->accessibility()->setMapToScreenFunc(nullptr);
@@ -574,10 +604,24 @@ void AbstractNotationPaintView::paint(QPainter* qp)
     Transform guiScalingCompensation;
     guiScalingCompensation.scale(guiScaling, guiScaling);
 
-    painter->setWorldTransform(m_matrix * guiScalingCompensation);
-
+    Transform viewTransform = m_matrix * guiScalingCompensation;
     bool isPrinting = publishMode() || m_inputController->readonly();
-    notation()->painting()->paintView(painter, toLogical(rect), isPrinting);
+
+    if (isTileCacheUsable()) {
+        INotationPaintingPtr painting = notation()->painting();
+        m_tileCache->paint(qp, notation()->elements()->msScore()->pages(), viewTransform, rect, isPrinting,
+                           [painting, isPrinting](Painter* tilePainter, int pageIndex, const RectF& frameRect) {
+            painting->paintViewPage(tilePainter, pageIndex, frameRect, isPrinting);
+        });
+
+        painter->setWorldTransform(viewTransform);
+        if (!isPrinting) {
+            painting->paintViewOverlays(painter);
+        }
+    } else {
+        painter->setWorldTransform(viewTransform);
+        notation()->painting()->paintView(painter, toLogical(rect), isPrinting);
+    }
 
     m_playbackCursor->paint(painter);
     m_noteInputCursor->paint(painter);
@@ -613,18 +657,94 @@ void AbstractNotationPaintView::onNotationSetup()
     });
 
     configuration()->foregroundChanged().onNotify(this, [this]() {
+        m_tileCache->invalidate();
         redraw();
     });
 
     uiConfiguration()->currentThemeChanged().onNotify(this, [this]() {
+        m_tileCache->invalidate();
         redraw();
     });
 
     engravingConfiguration()->debuggingOptionsChanged().onNotify(this, [this]() {
+        m_tileCache->invalidate();
+        redraw();
+    });
+
+    engravingConfiguration()->selectionColorChanged().onReceive(this, [this](voice_idx_t, const draw::Color&) {
+        m_tileCache->invalidate();
         redraw();
     });
 }
 
+//! NOTE While elements are edited or dragged they are repainted on every move,
+//! the tiles are bypassed then
+bool AbstractNotationPaintView::isTileCacheUsable() const
+{
+    INotationInteractionPtr interaction = notationInteraction();
+    if (!interaction) {
+        return false;
+    }
+
+    return !interaction->isDragStarted()
+           && !interaction->isElementEditStarted()
+           && !interaction->isTextEditingStarted()
+           && !interaction->isGripEditStarted();
+}
+
+//! NOTE The items which moved are found by the tile cache itself,
+//! here the systems of the changed measures are invalidated for the changes
+//! which keep the geometry (color, visibility, ...)
+void AbstractNotationPaintView::invalidateTiles(const ChangesRange& range)
+{
+    if (!range.isValidBoundary() || !range.changedStyleIdSet.empty()) {
+        m_tileCache->invalidate();
+        return;
+    }
+
+    const engraving::Score* score = notation()->elements()->msScore();
+    for (const engraving::Page* page : score->pages()) {
+        const std::vector<engraving::System*>& systems = page->systems();
+
+        for (size_t i = 0; i < systems.size(); ++i) {
+            const engraving::System* system = systems[i];
+            if (!system->firstMeasure()) {
+                continue;
+            }
+
+            int systemTickFrom = system->firstMeasure()->tick().ticks();
+            int systemTickTo = system->endTick().ticks();
+            if (systemTickTo < range.tickFrom || systemTickFrom > range.tickTo) {
+                continue;
+            }
+
+            //! NOTE The elements of a system may stick out of its bbox,
+            //! take the band up to the neighbour systems
+            double top = i > 0 ? (systems[i - 1]->y() + systems[i - 1]->height() + system->y()) / 2 : 0.0;
+            double bottom = i + 1 < systems.size() ? (system->y() + system->height() + systems[i + 1]->y()) / 2 : page->height();
+
+            RectF band(0.0, top, page->width(), bottom - top);
+            m_tileCache->invalidate(band.translated(page->pos()));
+        }
+    }
+}
+
+void AbstractNotationPaintView::invalidateTiles(const std::vector<EngravingItem*>& elements)
+{
+    for (const RectF& rect : m_selectedElementsRects) {
+        m_tileCache->invalidate(rect);
+    }
+
+    m_selectedElementsRects.clear();
+    m_selectedElementsRects.reserve(elements.size());
+
+    for (const EngravingItem* element : elements) {
+        RectF rect = element->canvasBoundingRect();
+        m_tileCache->invalidate(rect);
+        m_selectedElementsRects.push_back(rect);
+    }
+}
+
 void AbstractNotationPaintView::paintBackground(const RectF& rect, draw::Painter* painter)
 {
     TRACEFUNC;
@@ -45,6 +45,7 @@
 #include "playbackcursor.h"
 #include "loopmarker.h"
 #include "continuouspanel.h"
+#include "notationtilecache.h"
 #include "internal/abstractelementpopupmodel.h"
 
 namespace mu::notation {
@@ -247,6 +248,10 @@ private:
 
     void paintBackground(const RectF& rect, draw::Painter* painter);
 
+    bool isTileCacheUsable() const;
+    void invalidateTiles(const ChangesRange& range);
+    void invalidateTiles(const std::vector<EngravingItem*>& elements);
+
     PointF canvasCenter() const;
     std::pair<qreal, qreal> constraintCanvas(qreal dx, qreal dy) const;
 
@@ -259,6 +264,8 @@ private:
     std::unique_ptr<LoopMarker> m_loopInMarker;
     std::unique_ptr<LoopMarker> m_loopOutMarker;
     std::unique_ptr<ContinuousPanel> m_continuousPanel;
+    std::unique_ptr<NotationTileCache> m_tileCache;
+    std::vector<RectF> m_selectedElementsRects;
 
     qreal m_previousVerticalScrollPosition = 0;
     qreal m_previousHorizontalScrollPosition = 0;
@@ -0,0 +1,274 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "notationtilecache.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QPainter>
+
+#include "draw/painter.h"
+#include "engraving/libmscore/page.h"
+
+#include "realfn.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::notation;
+using namespace mu::draw;
+
+//! NOTE Tile size in device independent pixels
+static constexpr int TILE_SIZE = 256;
+//! NOTE Default memory used by the tiles (32-bit pixels), the visible tiles are always kept
+static constexpr size_t TILES_MEMORY_BUDGET = 128 * 1024 * 1024;
+static constexpr double ZOOM_KEY_PRECISION = 10000.0;
+//! NOTE Antialiasing may touch pixels slightly outside of the changed area
+static constexpr double INVALIDATION_MARGIN_PX = 2.0;
+
+NotationTileCache::NotationTileCache()
+    : m_memoryBudget(TILES_MEMORY_BUDGET)
+{
+}
+
+bool NotationTileCache::TileKey::operator<(const TileKey& other) const
+{
+    if (pageIndex != other.pageIndex) {
+        return pageIndex < other.pageIndex;
+    }
+    if (zoom != other.zoom) {
+        return zoom < other.zoom;
+    }
+    if (y != other.y) {
+        return y < other.y;
+    }
+    return x < other.x;
+}
+
+void NotationTileCache::paint(QPainter* painter, const std::vector<engraving::Page*>& pages, const Transform& transform,
+                              const RectF& deviceRect, bool isPrinting, const PaintPageFunc& paintPage)
+{
+    TRACEFUNC;
+
+    const qreal devicePixelRatio = painter->device() ? painter->device()->devicePixelRatioF() : 1.0;
+    if (!RealIsEqual(devicePixelRatio, m_devicePixelRatio) || isPrinting != m_isPrinting) {
+        invalidate();
+        m_devicePixelRatio = devicePixelRatio;
+        m_isPrinting = isPrinting;
+    }
+
+    ++m_frame;
+    syncPagesCount(pages.size());
+
+    const double scale = transform.m11();
+    if (scale <= 0.0) {
+        return;
+    }
+
+    const double tileLogicalSize = TILE_SIZE / scale;
+    const int64_t zoom = std::llround(scale * ZOOM_KEY_PRECISION);
+    const RectF logicalRect = transform.inverted().map(deviceRect);
+
+    for (size_t pageIndex = 0; pageIndex < pages.size(); ++pageIndex) {
+        const engraving::Page* page = pages[pageIndex];
+        const PointF pagePos = page->pos();
+        const RectF pageRect = page->bbox();
+
+        const RectF visibleRect = logicalRect.translated(-pagePos).intersected(pageRect);
+        if (visibleRect.isEmpty()) {
+            continue;
+        }
+
+        syncWithPage(static_cast<int>(pageIndex), pages[pageIndex]);
+
+        const int firstX = static_cast<int>(std::floor(visibleRect.left() / tileLogicalSize));
+        const int lastX = static_cast<int>(std::floor(visibleRect.right() / tileLogicalSize));
+        const int firstY = static_cast<int>(std::floor(visibleRect.top() / tileLogicalSize));
+        const int lastY = static_cast<int>(std::floor(visibleRect.bottom() / tileLogicalSize));
+
+        //! NOTE All the tiles of a page are placed relative to the same origin,
+        //! so they line up exactly
+        const PointF deviceOrigin = transform.map(pagePos);
+
+        for (int y = firstY; y <= lastY; ++y) {
+            for (int x = firstX; x <= lastX; ++x) {
+                TileKey key { static_cast<int>(pageIndex), zoom, x, y };
+
+                auto it = m_tiles.find(key);
+                if (it == m_tiles.end()) {
+                    Tile tile;
+                    tile.pageRect = RectF(x * tileLogicalSize, y * tileLogicalSize, tileLogicalSize, tileLogicalSize);
+                    tile.image = paintTile(static_cast<int>(pageIndex), pagePos + tile.pageRect.topLeft(), scale, tileLogicalSize,
+                                           devicePixelRatio, paintPage);
+                    it = m_tiles.emplace(key, std::move(tile)).first;
+                }
+
+                it->second.lastUsed = m_frame;
+
+                QPointF tilePos(deviceOrigin.x() + x * TILE_SIZE, deviceOrigin.y() + y * TILE_SIZE);
+                painter->drawImage(tilePos, it->second.image);
+            }
+        }
+    }
+
+    removeUnusedTiles(devicePixelRatio);
+}
+
+QImage NotationTileCache::paintTile(int pageIndex, const PointF& tileOrigin, double scale, double tileLogicalSize,
+                                    qreal devicePixelRatio, const PaintPageFunc& paintPage) const
+{
+    TRACEFUNC;
+
+    const int pixelSize = static_cast<int>(std::ceil(TILE_SIZE * devicePixelRatio));
+    QImage image(pixelSize, pixelSize, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(devicePixelRatio);
+    image.fill(Qt::transparent);
+
+    QPainter qp(&image);
+    Painter painter(&qp, "notationtile");
+
+    Transform transform;
+    transform.scale(scale, scale);
+    transform.translate(-tileOrigin.x(), -tileOrigin.y());
+    painter.setWorldTransform(transform);
+
+    paintPage(&painter, pageIndex, RectF(tileOrigin, SizeF(tileLogicalSize, tileLogicalSize)));
+
+    return image;
+}
+
+void NotationTileCache::syncPagesCount(size_t pagesCount)
+{
+    for (size_t i = pagesCount; i < m_pageStates.size(); ++i) {
+        removePageTiles(static_cast<int>(i));
+    }
+    m_pageStates.resize(pagesCount);
+}
+
+//! NOTE Only the visible pages are synchronized, the changes of the other pages
+//! are taken from their log once they become visible
+void NotationTileCache::syncWithPage(int pageIndex, engraving::Page* page)
+{
+    PageState& state = m_pageStates[pageIndex];
+
+    //! NOTE The page is compared with the state of its tiles, so that the later invalidations
+    //! of canvas areas are mapped to the tiles correctly
+    std::vector<RectF> areas;
+    if (state.page != page || state.pos != page->pos() || state.bbox != page->bbox()
+        || !page->changedAreasSince(state.revision, areas)) {
+        removePageTiles(pageIndex);
+    } else {
+        for (const RectF& area : areas) {
+            invalidatePageArea(pageIndex, area);
+        }
+    }
+
+    state.page = page;
+    state.revision = page->itemsRevision();
+    state.pos = page->pos();
+    state.bbox = page->bbox();
+}
+
+void NotationTileCache::invalidate()
+{
+    m_tiles.clear();
+    m_pageStates.clear();
+}
+
+void NotationTileCache::invalidate(const RectF& canvasRect)
+{
+    if (!canvasRect.isValid()) {
+        return;
+    }
+
+    for (size_t i = 0; i < m_pageStates.size(); ++i) {
+        const PageState& state = m_pageStates[i];
+        if (!state.page) {
+            continue;
+        }
+
+        const RectF pageArea = canvasRect.translated(-state.pos);
+        if (pageArea.intersects(state.bbox)) {
+            invalidatePageArea(static_cast<int>(i), pageArea);
+        }
+    }
+}
+
+void NotationTileCache::setMemoryBudget(size_t bytes)
+{
+    m_memoryBudget = bytes;
+}
+
+void NotationTileCache::invalidatePageArea(int pageIndex, const RectF& pageRect)
+{
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        if (it->first.pageIndex != pageIndex) {
+            ++it;
+            continue;
+        }
+
+        const double margin = INVALIDATION_MARGIN_PX * ZOOM_KEY_PRECISION / it->first.zoom;
+        if (it->second.pageRect.intersects(pageRect.adjusted(-margin, -margin, margin, margin))) {
+            it = m_tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void NotationTileCache::removePageTiles(int pageIndex)
+{
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        if (it->first.pageIndex == pageIndex) {
+            it = m_tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void NotationTileCache::removeUnusedTiles(qreal devicePixelRatio)
+{
+    const double tileBytes = 4.0 * (TILE_SIZE * devicePixelRatio) * (TILE_SIZE * devicePixelRatio);
+    const size_t maxTiles = static_cast<size_t>(m_memoryBudget / tileBytes);
+    if (m_tiles.size() <= maxTiles) {
+        return;
+    }
+
+    std::vector<std::pair<uint64_t, TileKey> > candidates;
+    for (const auto& pair : m_tiles) {
+        if (pair.second.lastUsed != m_frame) {
+            candidates.emplace_back(pair.second.lastUsed, pair.first);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
+    for (const auto& candidate : candidates) {
+        if (m_tiles.size() <= maxTiles) {
+            break;
+        }
+        m_tiles.erase(candidate.second);
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2023 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_NOTATION_NOTATIONTILECACHE_H
+#define MU_NOTATION_NOTATIONTILECACHE_H
+
+#include <functional>
+#include <map>
+#include <vector>
+
+#include <QImage>
+
+#include "draw/types/geometry.h"
+#include "draw/types/transform.h"
+
+class QPainter;
+
+namespace mu::draw {
+class Painter;
+}
+
+namespace mu::engraving {
+class Page;
+}
+
+namespace mu::notation {
+//! NOTE Raster cache of the score content painted by the notation view.
+//! Pages are split in tiles of a fixed size in device pixels; a tile is keyed
+//! by page, zoom and position and is painted once, then reused while scrolling,
+//! zooming back and forth, moving the playback cursor, etc.
+//! A tile is dropped when an item of its page was added, moved or removed
+//! since it was painted (see Page::changedAreasSince), or when its area is
+//! invalidated explicitly (selection, changed measures, settings).
+//! The explicit invalidation takes effect immediately: the canvas area is mapped
+//! to the pages as they were when their tiles were painted.
+//! Overlays (cursors, selection range, drop targets, ...) are not cached,
+//! they are painted by the view on top of the tiles.
+class NotationTileCache
+{
+public:
+    using PaintPageFunc = std::function<void (draw::Painter* painter, int pageIndex, const RectF& frameRect)>;
+
+    NotationTileCache();
+
+    void paint(QPainter* painter, const std::vector<engraving::Page*>& pages, const draw::Transform& transform,
+               const RectF& deviceRect, bool isPrinting, const PaintPageFunc& paintPage);
+
+    void invalidate();
+    void invalidate(const RectF& canvasRect);
+
+    //! NOTE The tiles which weren't used by the last paint are dropped above it
+    void setMemoryBudget(size_t bytes);
+
+private:
+    struct TileKey {
+        int pageIndex = 0;
+        int64_t zoom = 0;
+        int x = 0;
+        int y = 0;
+
+        bool operator<(const TileKey& other) const;
+    };
+
+    struct Tile {
+        QImage image;
+        RectF pageRect;         // area of the page painted in the tile
+        uint64_t lastUsed = 0;
+    };
+
+    struct PageState {
+        const engraving::Page* page = nullptr;
+        uint64_t revision = 0;
+        PointF pos;
+        RectF bbox;
+    };
+
+    void syncPagesCount(size_t pagesCount);
+    void syncWithPage(int pageIndex, engraving::Page* page);
+    void invalidatePageArea(int pageIndex, const RectF& pageRect);
+    void removePageTiles(int pageIndex);
+    void removeUnusedTiles(qreal devicePixelRatio);
+
+    QImage paintTile(int pageIndex, const PointF& tileOrigin, double scale, double tileLogicalSize, qreal devicePixelRatio,
+                     const PaintPageFunc& paintPage) const;
+
+    std::map<TileKey, Tile> m_tiles;
+    std::vector<PageState> m_pageStates;
+    size_t m_memoryBudget = 0;
+
+    qreal m_devicePixelRatio = 0.0;
+    bool m_isPrinting = false;
+    uint64_t m_frame = 0;
+};
+}
+
+#endif // MU_NOTATION_NOTATIONTILECACHE_H
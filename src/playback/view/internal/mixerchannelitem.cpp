@@ -22,6 +22,8 @@
 
 #include "mixerchannelitem.h"
 
+#include <algorithm>
+
 #include "defer.h"
 #include "translation.h"
 #include "log.h"
@@ -70,7 +72,6 @@ MixerChannelItem::MixerChannelItem(QObject* parent, Type type, bool outputOnly,
 
 MixerChannelItem::~MixerChannelItem()
 {
-    m_audioSignalChanges.resetOnReceive(this);
 }
 
 MixerChannelItem::Type MixerChannelItem::type() const
@@ -357,26 +358,35 @@ void MixerChannelItem::loadSoloMuteState(project::IProjectAudioSettings::SoloMut
     }
 }
 
-void MixerChannelItem::subscribeOnAudioSignalChanges(AudioSignalChanges&& audioSignalChanges)
+void MixerChannelItem::setSignalMeter(AudioSignalMeterPtr signalMeter)
 {
-    m_audioSignalChanges = audioSignalChanges;
+    m_signalMeter = std::move(signalMeter);
+    m_signalMeterReadPositions.fill(0);
+}
 
-    m_audioSignalChanges.onReceive(this, [this](const audioch_t audioChNum, const AudioSignalVal& newValue) {
-        //!Note There should be no signal changes when the mixer channel is muted.
-        //!     But some audio signal changes still might be "on the way" from the times when the mixer channel wasn't muted
-        //!     So that we have to just ignore them
-        if (muted()) {
-            return;
+void MixerChannelItem::updateAudioSignal()
+{
+    if (!m_signalMeter) {
+        return;
+    }
+
+    //! NOTE Only the left and the right channels are shown
+    for (audioch_t audioChNum = 0; audioChNum < 2; ++audioChNum) {
+        AudioSignalMeter::Frame frame;
+        if (!m_signalMeter->read(audioChNum, m_signalMeterReadPositions[audioChNum], frame)) {
+            continue;
         }
 
-        if (newValue.pressure < MIN_DISPLAYED_DBFS) {
-            setAudioChannelVolumePressure(audioChNum, MIN_DISPLAYED_DBFS);
-        } else if (newValue.pressure > MAX_DISPLAYED_DBFS) {
-            setAudioChannelVolumePressure(audioChNum, MAX_DISPLAYED_DBFS);
-        } else {
-            setAudioChannelVolumePressure(audioChNum, newValue.pressure);
+        //!Note There should be no signal when the mixer channel is muted.
+        //!     But the meter still might have the frames from the times when the mixer channel wasn't muted
+        //!     So that we have to just skip them
+        if (muted()) {
+            continue;
         }
-    });
+
+        volume_dbfs_t pressure = AudioSignalMeter::signalVal(frame).pressure;
+        setAudioChannelVolumePressure(audioChNum, std::clamp(pressure, MIN_DISPLAYED_DBFS, MAX_DISPLAYED_DBFS));
+    }
 }
 
 void MixerChannelItem::setTitle(QString title)
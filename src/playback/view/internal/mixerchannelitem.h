@@ -23,6 +23,8 @@
 #ifndef MU_PLAYBACK_MIXERCHANNELITEM_H
 #define MU_PLAYBACK_MIXERCHANNELITEM_H
 
+#include <array>
+
 #include <QObject>
 
 #include "async/asyncable.h"
@@ -32,6 +34,7 @@
 #include "iinteractive.h"
 
 #include "audio/audiotypes.h"
+#include "audio/audiosignalmeter.h"
 #include "ui/view/navigationpanel.h"
 #include "project/iprojectaudiosettings.h"
 
@@ -112,7 +115,8 @@ public:
     void loadOutputParams(audio::AudioOutputParams&& newParams);
     void loadSoloMuteState(project::IProjectAudioSettings::SoloMuteState&& newState);
 
-    void subscribeOnAudioSignalChanges(audio::AudioSignalChanges&& audioSignalChanges);
+    void setSignalMeter(audio::AudioSignalMeterPtr signalMeter);
+    void updateAudioSignal();
 
     bool outputOnly() const;
 
@@ -193,7 +197,8 @@ protected:
     QMap<audio::AudioFxChainOrder, OutputResourceItem*> m_outputResourceItems;
     QMap<audio::aux_channel_idx_t, AuxSendItem*> m_auxSendItems;
 
-    audio::AudioSignalChanges m_audioSignalChanges;
+    audio::AudioSignalMeterPtr m_signalMeter = nullptr;
+    std::array<uint64_t, audio::AudioSignalMeter::MAX_AUDIO_CHANNELS> m_signalMeterReadPositions {};
 
     QString m_title;
     bool m_outputOnly = false;
@@ -35,12 +35,19 @@ using namespace mu::project;
 
 static constexpr int INVALID_INDEX = -1;
 
+//! NOTE The signal meters are read at display rate, not on every processed audio block
+static constexpr int AUDIO_SIGNALS_UPDATE_INTERVAL_MSECS = 33;
+
 MixerPanelModel::MixerPanelModel(QObject* parent)
     : QAbstractListModel(parent)
 {
     controller()->currentTrackSequenceIdChanged().onNotify(this, [this]() {
         load();
     });
+
+    m_audioSignalsUpdateTimer.setInterval(AUDIO_SIGNALS_UPDATE_INTERVAL_MSECS);
+    connect(&m_audioSignalsUpdateTimer, &QTimer::timeout, this, &MixerPanelModel::updateAudioSignals);
+    m_audioSignalsUpdateTimer.start();
 }
 
 void MixerPanelModel::load()
@@ -268,6 +275,13 @@ void MixerPanelModel::clear()
     m_mixerChannelList.clear();
 }
 
+void MixerPanelModel::updateAudioSignals()
+{
+    for (MixerChannelItem* item : m_mixerChannelList) {
+        item->updateAudioSignal();
+    }
+}
+
 void MixerPanelModel::setupConnections()
 {
     audioSettings()->soloMuteStateChanged().onReceive(
@@ -441,14 +455,14 @@ MixerChannelItem* MixerPanelModel::buildInstrumentChannelItem(const audio::Track
                << ", " << text;
     });
 
-    playback()->audioOutput()->signalChanges(m_currentTrackSequenceId, trackId)
-    .onResolve(this, [this, trackId](AudioSignalChanges signalChanges) {
+    playback()->audioOutput()->signalMeter(m_currentTrackSequenceId, trackId)
+    .onResolve(this, [this, trackId](AudioSignalMeterPtr signalMeter) {
         if (MixerChannelItem* item = findChannelItem(trackId)) {
-            item->subscribeOnAudioSignalChanges(std::move(signalChanges));
+            item->setSignalMeter(std::move(signalMeter));
         }
     })
     .onReject(this, [](int errCode, std::string text) {
-        LOGE() << "unable to subscribe on audio signal changes from mixer channel, error code: " << errCode
+        LOGE() << "unable to get the signal meter of mixer channel, error code: " << errCode
                << ", " << text;
     });
 
@@ -502,14 +516,14 @@ MixerChannelItem* MixerPanelModel::buildAuxChannelItem(const TrackId trackId)
                << ", " << text;
     });
 
-    playback()->audioOutput()->signalChanges(m_currentTrackSequenceId, trackId)
-    .onResolve(this, [this, trackId](AudioSignalChanges signalChanges) {
+    playback()->audioOutput()->signalMeter(m_currentTrackSequenceId, trackId)
+    .onResolve(this, [this, trackId](AudioSignalMeterPtr signalMeter) {
         if (MixerChannelItem* item = findChannelItem(trackId)) {
-            item->subscribeOnAudioSignalChanges(std::move(signalChanges));
+            item->setSignalMeter(std::move(signalMeter));
         }
     })
     .onReject(this, [](int errCode, std::string text) {
-        LOGE() << "unable to subscribe on audio signal changes from mixer channel, error code: " << errCode
+        LOGE() << "unable to get the signal meter of mixer channel, error code: " << errCode
                << ", " << text;
     });
 
@@ -535,12 +549,12 @@ MixerChannelItem* MixerPanelModel::buildMasterChannelItem()
                << ", " << text;
     });
 
-    playback()->audioOutput()->masterSignalChanges()
-    .onResolve(this, [item](AudioSignalChanges signalChanges) {
-        item->subscribeOnAudioSignalChanges(std::move(signalChanges));
+    playback()->audioOutput()->masterSignalMeter()
+    .onResolve(this, [item](AudioSignalMeterPtr signalMeter) {
+        item->setSignalMeter(std::move(signalMeter));
     })
     .onReject(this, [](int errCode, std::string text) {
-        LOGE() << "unable to subscribe on audio signal changes from master channel, error code: " << errCode
+        LOGE() << "unable to get the signal meter of master channel, error code: " << errCode
                << ", " << text;
     });
 
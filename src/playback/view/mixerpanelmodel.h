@@ -25,6 +25,7 @@
 
 #include <QAbstractListModel>
 #include <QList>
+#include <QTimer>
 
 #include "modularity/ioc.h"
 #include "async/asyncable.h"
@@ -81,6 +82,7 @@ private:
     void updateItemsPanelsOrder();
     void clear();
     void setupConnections();
+    void updateAudioSignals();
 
     int resolveInsertIndex(const engraving::InstrumentTrackId& instrumentTrackId) const;
     int indexOf(const audio::TrackId trackId) const;
@@ -105,6 +107,8 @@ private:
     audio::TrackSequenceId m_currentTrackSequenceId = -1;
 
     ui::NavigationSection* m_navigationSection = nullptr;
+
+    QTimer m_audioSignalsUpdateTimer;
 };
 }
 
@@ -68,6 +68,36 @@ static const QString PLATFORM_TAG("platform");
 static const QString MOVEMENT_TITLE_TAG("movementTitle");
 static const QString MOVEMENT_NUMBER_TAG("movementNumber");
 
+//! NOTE One line for the whole project: the number of parts, the time spent reading them
+//! and the slowest one, which is usually the part to look at when opening is slow
+static std::string excerptsLoadInfo(const std::vector<ExcerptLoadStatistics>& statistics)
+{
+    size_t dataSize = 0;
+    int64_t readTimeMs = 0;
+    const ExcerptLoadStatistics* slowest = nullptr;
+
+    for (const ExcerptLoadStatistics& stat : statistics) {
+        int64_t statReadTimeMs = stat.readFilesTimeMs + stat.readScoreTimeMs;
+
+        dataSize += stat.dataSize;
+        readTimeMs += statReadTimeMs;
+
+        if (!slowest || statReadTimeMs > slowest->readFilesTimeMs + slowest->readScoreTimeMs) {
+            slowest = &stat;
+        }
+    }
+
+    std::string info = std::to_string(statistics.size()) + " parts, " + std::to_string(dataSize / 1024) + " KB, read in "
+                       + std::to_string(readTimeMs) + " ms";
+
+    if (slowest) {
+        info += ", the slowest: " + slowest->name.toStdString() + " (read files: " + std::to_string(slowest->readFilesTimeMs)
+                + " ms, read score: " + std::to_string(slowest->readScoreTimeMs) + " ms)";
+    }
+
+    return info;
+}
+
 static bool isStandardTag(const QString& tag)
 {
     static const QSet<QString> standardTags {
@@ -197,6 +227,10 @@ mu::Ret NotationProject::doLoad(const io::path_t& path, const io::path_t& styleP
         return ret;
     }
 
+    if (!m_engravingProject->excerptsLoadStatistics().empty()) {
+        LOGI() << "loaded " << excerptsLoadInfo(m_engravingProject->excerptsLoadStatistics()) << ": " << path;
+    }
+
     MasterScore* masterScore = m_engravingProject->masterScore();
     IF_ASSERT_FAILED(masterScore) {
         return engraving::make_ret(engraving::Err::UnknownError, reader.params().filePath);